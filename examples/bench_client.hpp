@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_BENCH_CLIENT_H_INCLUDED
+#define BEAST_EXAMPLE_BENCH_CLIENT_H_INCLUDED
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+struct bench_result
+{
+    double seconds = 0;
+    std::vector<double> latency;
+};
+
+// Run `conns` client connections, each sending `n` requests.
+// Each connection has its own thread and waits for every response.
+inline
+bench_result
+run_clients(boost::asio::ip::tcp::endpoint const& ep,
+    std::size_t conns, std::size_t n, std::size_t upload,
+        std::string const& target = "/")
+{
+    using clock_type = std::chrono::steady_clock;
+    std::vector<std::vector<double>> lat(conns);
+    std::vector<std::thread> threads;
+    auto const start = clock_type::now();
+    for(std::size_t i = 0; i < conns; ++i)
+        threads.emplace_back(
+            [&, i]
+            {
+                boost::asio::io_service ios;
+                boost::asio::ip::tcp::socket sock{ios};
+                sock.connect(ep);
+                sock.set_option(boost::asio::ip::tcp::no_delay{true});
+                request<string_body> req;
+                req.method = upload > 0 ? "POST" : "GET";
+                req.url = target;
+                req.version = 11;
+                req.fields.insert("User-Agent", "beast/http");
+                req.body = std::string(upload, '+');
+                prepare(req);
+                streambuf sb;
+                lat[i].reserve(n);
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    auto const t0 = clock_type::now();
+                    write(sock, req);
+                    response<string_body> res;
+                    read(sock, sb, res);
+                    lat[i].push_back(std::chrono::duration<
+                        double, std::micro>(clock_type::now() - t0).count());
+                }
+            });
+    for(auto& t : threads)
+        t.join();
+    bench_result r;
+    r.seconds = std::chrono::duration<double>(
+        clock_type::now() - start).count();
+    for(auto const& v : lat)
+        r.latency.insert(r.latency.end(), v.begin(), v.end());
+    std::sort(r.latency.begin(), r.latency.end());
+    return r;
+}
+
+inline
+void
+report(std::string const& what, bench_result const& r)
+{
+    auto const pct =
+        [&](double p)
+        {
+            return r.latency[static_cast<std::size_t>(
+                p * (r.latency.size() - 1))];
+        };
+    std::cout <<
+        std::left << std::setw(8) << what <<
+        std::right << std::fixed << std::setprecision(0) <<
+        std::setw(10) << r.latency.size() / r.seconds << " req/s" <<
+        std::setprecision(1) <<
+        "   p50 " << std::setw(8) << pct(0.50) << "us" <<
+        "   p99 " << std::setw(8) << pct(0.99) << "us" <<
+        std::endl;
+}
+
+} // http
+} // beast
+
+#endif
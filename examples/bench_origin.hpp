@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_BENCH_ORIGIN_H_INCLUDED
+#define BEAST_EXAMPLE_BENCH_ORIGIN_H_INCLUDED
+
+#include <beast/http.hpp>
+#include <beast/core/placeholders.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+// An origin server for benchmarks which
+// answers every request with the same body.
+class bench_origin
+{
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    boost::asio::io_service ios_;
+    socket_type sock_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::string body_;
+    std::thread thread_;
+
+public:
+    bench_origin(endpoint_type const& ep, std::size_t size)
+        : sock_(ios_)
+        , acceptor_(ios_)
+        , body_(size, '*')
+    {
+        acceptor_.open(ep.protocol());
+        acceptor_.bind(ep);
+        acceptor_.listen(
+            boost::asio::socket_base::max_connections);
+        acceptor_.async_accept(sock_,
+            std::bind(&bench_origin::on_accept, this,
+                beast::asio::placeholders::error));
+        thread_ = std::thread{[&]{ ios_.run(); }};
+    }
+
+    ~bench_origin()
+    {
+        error_code ec;
+        ios_.dispatch(
+            [&]{ acceptor_.close(ec); });
+        thread_.join();
+    }
+
+    endpoint_type
+    local_endpoint() const
+    {
+        return acceptor_.local_endpoint();
+    }
+
+private:
+    void
+    on_accept(error_code ec)
+    {
+        if(! acceptor_.is_open() || ec)
+            return;
+        std::thread{std::bind(&bench_origin::do_peer, this,
+            std::make_shared<socket_type>(std::move(sock_)))}.detach();
+        acceptor_.async_accept(sock_,
+            std::bind(&bench_origin::on_accept, this,
+                asio::placeholders::error));
+    }
+
+    void
+    do_peer(std::shared_ptr<socket_type> const& sock)
+    {
+        boost::asio::io_service::work work{ios_};
+        sock->set_option(boost::asio::ip::tcp::no_delay{true});
+        streambuf sb;
+        error_code ec;
+        for(;;)
+        {
+            request<string_body> req;
+            read(*sock, sb, req, ec);
+            if(ec)
+                break;
+            response<string_body> res;
+            res.status = 200;
+            res.reason = "OK";
+            res.version = req.version;
+            res.fields.insert("Server", "bench_origin");
+            res.fields.insert("Date", date_string());
+            res.body = body_;
+            prepare(res);
+            write(*sock, res, ec);
+            if(ec)
+                break;
+        }
+    }
+};
+
+} // http
+} // beast
+
+#endif
@@ -8,7 +8,6 @@
 #ifndef BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
@@ -72,6 +71,18 @@ public:
             t.join();
     }
 
+    endpoint_type
+    local_endpoint() const
+    {
+        return acceptor_.local_endpoint();
+    }
+
+    void
+    set_log(bool v)
+    {
+        log_ = v;
+    }
+
     template<class... Args>
     void
     log(Args const&... args)
@@ -241,6 +252,7 @@ private:
                 res.reason = "Not Found";
                 res.version = req_.version;
                 res.fields.insert("Server", "http_async_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", "text/html");
                 res.body = "The file '" + path + "' was not found";
                 prepare(res);
@@ -256,6 +268,7 @@ private:
                 res.reason = "OK";
                 res.version = req_.version;
                 res.fields.insert("Server", "http_async_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", mime_type(path));
                 res.body = path;
                 prepare(res);
@@ -270,6 +283,7 @@ private:
                 res.reason = "Internal Error";
                 res.version = req_.version;
                 res.fields.insert("Server", "http_async_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", "text/html");
                 res.body =
                     std::string{"An internal error occurred"} + e.what();
@@ -283,7 +297,7 @@ private:
         void on_write(error_code ec)
         {
             if(ec)
-                fail(ec, "write");
+                return fail(ec, "write");
             do_read();
         }
     };
@@ -5,58 +5,187 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include "bench_origin.hpp"
 #include "urls_large_data.hpp"
 
-#include <beast/core/streambuf.hpp>
 #include <beast/http.hpp>
+#include <beast/http/client_pool.hpp>
 #include <boost/asio.hpp>
-#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace beast::http;
 using namespace boost::asio;
 
-template<class String>
+// Retrieves the page at each host, with at
+// most `jobs` requests outstanding at once.
+class crawler
+{
+    struct job
+    {
+        std::string host;
+        request<empty_body> req;
+        response<string_body> res;
+    };
+
+    client_pool pool_;
+    ip::tcp::resolver r_;
+    std::vector<char const*> const& hosts_;
+    std::size_t next_ = 0;
+
+public:
+    crawler(io_service& ios,
+            std::vector<char const*> const& hosts)
+        : pool_(ios)
+        , r_(ios)
+        , hosts_(hosts)
+    {
+    }
+
+    void
+    run(std::size_t jobs)
+    {
+        for(std::size_t i = 0; i < jobs; ++i)
+            start();
+    }
+
+private:
+    void
+    start()
+    {
+        if(next_ >= hosts_.size())
+            return;
+        auto j = std::make_shared<job>();
+        j->host = hosts_[next_++];
+        r_.async_resolve(
+            ip::tcp::resolver::query{j->host, "http"},
+            [this, j](beast::error_code ec,
+                ip::tcp::resolver::iterator it)
+            {
+                on_resolve(j, ec, it);
+            });
+    }
+
+    void
+    on_resolve(std::shared_ptr<job> const& j,
+        beast::error_code ec, ip::tcp::resolver::iterator it)
+    {
+        if(ec)
+        {
+            std::cerr << j->host << ": " << ec.message() << std::endl;
+            return start();
+        }
+        auto const ep = it->endpoint();
+        j->req.method = "GET";
+        j->req.url = "/";
+        j->req.version = 11;
+        j->req.fields.insert("Host", j->host + ":" +
+            std::to_string(ep.port()));
+        j->req.fields.insert("User-Agent", "beast/http");
+        prepare(j->req);
+        pool_.async_request(ep, j->req, j->res,
+            [this, j](beast::error_code ec)
+            {
+                on_response(j, ec);
+            });
+    }
+
+    void
+    on_response(std::shared_ptr<job> const& j,
+        beast::error_code ec)
+    {
+        if(ec)
+            std::cerr << j->host << ": " << ec.message() << std::endl;
+        else
+            std::cout << j->host << ": " <<
+                j->res.status << " " << j->res.reason << std::endl;
+        start();
+    }
+};
+
+// Send `n` requests to a local server through a pool which keeps
+// at most `conns` connections, and report the request rate.
 void
-err(beast::error_code const& ec, String const& what)
+bench(std::size_t n, std::size_t conns,
+    std::size_t size, bool keep_alive)
 {
-    std::cerr << what << ": " << ec.message() << std::endl;
+    auto const loopback =
+        ip::address::from_string("127.0.0.1");
+    beast::http::bench_origin origin{
+        ip::tcp::endpoint{loopback, 0}, size};
+    auto const ep = origin.local_endpoint();
+    io_service ios;
+    client_pool pool{ios, conns};
+    request<empty_body> req;
+    req.method = "GET";
+    req.url = "/";
+    req.version = 11;
+    req.fields.insert("Host", "localhost");
+    req.fields.insert("User-Agent", "beast/http");
+    if(keep_alive)
+        prepare(req);
+    else
+        prepare(req, connection::close);
+    std::vector<response<string_body>> res(n);
+    std::size_t failed = 0;
+    using clock_type = std::chrono::steady_clock;
+    auto const start = clock_type::now();
+    for(auto& m : res)
+        pool.async_request(ep, req, m,
+            [&](beast::error_code ec)
+            {
+                if(ec)
+                    ++failed;
+            });
+    ios.run();
+    auto const seconds = std::chrono::duration<double>(
+        clock_type::now() - start).count();
+    std::cout <<
+        std::left << std::setw(12) <<
+            (keep_alive ? "keep-alive" : "close") <<
+        std::right << std::fixed << std::setprecision(0) <<
+        std::setw(10) << n / seconds << " req/s" <<
+        "   connects " << std::setw(6) << pool.connects() <<
+        "   failed " << failed <<
+        std::endl;
 }
 
-int main(int, char const*[])
+int main(int ac, char const* av[])
 {
-    io_service ios;
-    for(auto const& host : urls_large_data())
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+
+    desc.add_options()
+        ("jobs,j",      po::value<std::size_t>()->default_value(16),
+                        "Set the number of hosts crawled at once")
+        ("bench,b",     "Run a benchmark against a local server")
+        ("connections,c", po::value<std::size_t>()->default_value(8),
+                        "Set the number of benchmark connections")
+        ("requests,n",  po::value<std::size_t>()->default_value(10000),
+                        "Set the number of benchmark requests")
+        ("size,s",      po::value<std::size_t>()->default_value(1024),
+                        "Set the size of each response body")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    if(vm.count("bench"))
     {
-        try
-        {
-            ip::tcp::resolver r(ios);
-            auto it = r.resolve(
-                ip::tcp::resolver::query{host, "http"});
-            ip::tcp::socket sock(ios);
-            connect(sock, it);
-            auto ep = sock.remote_endpoint();
-            request<empty_body> req;
-            req.method = "GET";
-            req.url = "/";
-            req.version = 11;
-            req.fields.insert("Host", host + std::string(":") +
-                boost::lexical_cast<std::string>(ep.port()));
-            req.fields.insert("User-Agent", "beast/http");
-            prepare(req);
-            write(sock, req);
-            response<string_body> res;
-            streambuf sb;
-            beast::http::read(sock, sb, res);
-            std::cout << res;
-        }
-        catch(beast::system_error const& ec)
-        {
-            std::cerr << host << ": " << ec.what();
-        }
-        catch(...)
-        {
-            std::cerr << host << ": unknown exception" << std::endl;
-        }
+        auto const n = vm["requests"].as<std::size_t>();
+        auto const conns = vm["connections"].as<std::size_t>();
+        auto const size = vm["size"].as<std::size_t>();
+        bench(n, conns, size, true);
+        bench(n, conns, size, false);
+        return 0;
     }
+
+    io_service ios;
+    crawler c{ios, urls_large_data()};
+    c.run(vm["jobs"].as<std::size_t>());
+    ios.run();
 }
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_HTTP_GROUP_SERVER_H_INCLUDED
+#define BEAST_EXAMPLE_HTTP_GROUP_SERVER_H_INCLUDED
+
+#include "mime_type.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/block_pool.hpp>
+#include <beast/core/placeholders.hpp>
+#include <beast/core/server_group.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+/*  An asynchronous file server with one io_service per thread.
+
+    Connections are accepted by a server_group. Each connection
+    stays on the thread which accepted it, so its handlers are
+    invoked without a strand, and its read buffer comes from the
+    memory pool of that thread.
+*/
+class http_group_server
+{
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    using req_type = request<string_body>;
+    using resp_type = response<file_body>;
+
+    std::mutex m_;
+    bool log_ = true;
+    std::string root_;
+    server_group group_;
+
+public:
+    http_group_server(endpoint_type const& ep,
+            std::size_t threads, std::string const& root,
+                bool pin = false)
+        : root_(root)
+        , group_(threads, pin)
+    {
+        group_.open(ep,
+            [this](socket_type&& sock, server_group::context& ctx)
+            {
+                std::make_shared<peer>(
+                    std::move(sock), ctx, *this)->run();
+            });
+    }
+
+    endpoint_type
+    local_endpoint() const
+    {
+        return group_.local_endpoint();
+    }
+
+    void
+    set_log(bool v)
+    {
+        log_ = v;
+    }
+
+    template<class... Args>
+    void
+    log(Args const&... args)
+    {
+        if(log_)
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            log_args(args...);
+        }
+    }
+
+private:
+    class peer : public std::enable_shared_from_this<peer>
+    {
+        using streambuf_type =
+            basic_streambuf<pool_allocator<char>>;
+
+        socket_type sock_;
+        http_group_server& server_;
+        streambuf_type sb_;
+        req_type req_;
+        resp_type res_;
+        response<string_body> err_;
+
+    public:
+        peer(socket_type&& sock, server_group::context& ctx,
+                http_group_server& server)
+            : sock_(std::move(sock))
+            , server_(server)
+            , sb_(4096, pool_allocator<char>{ctx.pool()})
+        {
+        }
+
+        void
+        fail(error_code ec, std::string what)
+        {
+            if(ec != boost::asio::error::operation_aborted &&
+                    ec != boost::asio::error::eof)
+                server_.log(what, ": ", ec.message(), "\n");
+        }
+
+        void
+        run()
+        {
+            do_read();
+        }
+
+        void
+        do_read()
+        {
+            req_ = req_type{};
+            async_read(sock_, sb_, req_,
+                std::bind(&peer::on_read, shared_from_this(),
+                    asio::placeholders::error));
+        }
+
+        void
+        on_read(error_code const& ec)
+        {
+            if(ec)
+                return fail(ec, "read");
+            auto path = req_.url;
+            if(path == "/")
+                path = "/index.html";
+            path = server_.root_ + path;
+            if(! boost::filesystem::exists(path))
+                return error(404, "Not Found",
+                    "The file '" + path + "' was not found");
+            try
+            {
+                res_ = resp_type{};
+                res_.status = 200;
+                res_.reason = "OK";
+                res_.version = req_.version;
+                res_.fields.insert("Server", "http_group_server");
+                res_.fields.insert("Date", date_string());
+                res_.fields.insert("Content-Type", mime_type(path));
+                res_.body = path;
+                prepare(res_);
+            }
+            catch(std::exception const& e)
+            {
+                return error(500, "Internal Error",
+                    std::string{"An internal error occurred"} + e.what());
+            }
+            async_write(sock_, res_,
+                std::bind(&peer::on_write, shared_from_this(),
+                    asio::placeholders::error));
+        }
+
+        void
+        error(int status, std::string const& reason,
+            std::string const& text)
+        {
+            err_ = response<string_body>{};
+            err_.status = status;
+            err_.reason = reason;
+            err_.version = req_.version;
+            err_.fields.insert("Server", "http_group_server");
+            err_.fields.insert("Date", date_string());
+            err_.fields.insert("Content-Type", "text/html");
+            err_.body = text;
+            prepare(err_);
+            async_write(sock_, err_,
+                std::bind(&peer::on_write, shared_from_this(),
+                    asio::placeholders::error));
+        }
+
+        void
+        on_write(error_code ec)
+        {
+            if(ec)
+                return fail(ec, "write");
+            do_read();
+        }
+    };
+
+    void
+    log_args()
+    {
+    }
+
+    template<class Arg, class... Args>
+    void
+    log_args(Arg const& arg, Args const&... args)
+    {
+        std::cerr << arg;
+        log_args(args...);
+    }
+};
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "bench_client.hpp"
+#include "bench_origin.hpp"
+#include "http_proxy.hpp"
+
+#include <beast/test/sig_wait.hpp>
+#include <boost/program_options.hpp>
+
+int main(int ac, char const* av[])
+{
+    using namespace beast::http;
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+
+    desc.add_options()
+        ("port,p",      po::value<std::uint16_t>()->default_value(8080),
+                        "Set the port number for the proxy")
+        ("ip",          po::value<std::string>()->default_value("0.0.0.0"),
+                        "Set the IP address to bind to, \"0.0.0.0\" for all")
+        ("upstream-ip", po::value<std::string>()->default_value("127.0.0.1"),
+                        "Set the IP address of the upstream server")
+        ("upstream-port", po::value<std::uint16_t>()->default_value(8081),
+                        "Set the port number of the upstream server")
+        ("bench,b",     "Run a benchmark on the loopback interface")
+        ("connections,c", po::value<std::size_t>()->default_value(8),
+                        "Set the number of benchmark client connections")
+        ("requests,n",  po::value<std::size_t>()->default_value(10000),
+                        "Set the number of requests per connection")
+        ("size,s",      po::value<std::size_t>()->default_value(1024),
+                        "Set the size of each response body")
+        ("upload,u",    po::value<std::size_t>()->default_value(0),
+                        "Set the size of each request body")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using address_type = boost::asio::ip::address;
+
+    if(vm.count("bench"))
+    {
+        auto const loopback =
+            address_type::from_string("127.0.0.1");
+        auto const conns = vm["connections"].as<std::size_t>();
+        auto const n = vm["requests"].as<std::size_t>();
+        auto const upload = vm["upload"].as<std::size_t>();
+        bench_origin origin{endpoint_type{loopback, 0},
+            vm["size"].as<std::size_t>()};
+        http_proxy proxy{endpoint_type{loopback, 0},
+            origin.local_endpoint()};
+        proxy.set_log(false);
+        report("direct", run_clients(
+            origin.local_endpoint(), conns, n, upload));
+        report("proxy", run_clients(
+            proxy.local_endpoint(), conns, n, upload));
+        return 0;
+    }
+
+    endpoint_type ep{
+        address_type::from_string(vm["ip"].as<std::string>()),
+        vm["port"].as<std::uint16_t>()};
+    endpoint_type upstream{
+        address_type::from_string(vm["upstream-ip"].as<std::string>()),
+        vm["upstream-port"].as<std::uint16_t>()};
+
+    http_proxy proxy{ep, upstream};
+    beast::test::sig_wait();
+}
@@ -0,0 +1,438 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_EXAMPLE_HTTP_PROXY_H_INCLUDED
+#define BEAST_EXAMPLE_HTTP_PROXY_H_INCLUDED
+
+#include <beast/http.hpp>
+#include <beast/core/placeholders.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/*  A Body which sends the message body to a socket as it is parsed.
+
+    The reader writes each piece of the body directly from the
+    parser's input buffer to the destination, so a body of any
+    size passes through the proxy without being stored. If the
+    original message was chunked, the body is chunk-encoded again
+    since the parser delivers the decoded octets.
+*/
+struct relay_body
+{
+    struct value_type
+    {
+        boost::asio::ip::tcp::socket* sock = nullptr;
+        bool chunked = false;
+    };
+
+    class reader
+    {
+        value_type const& v_;
+
+    public:
+        template<bool isRequest, class Body, class Fields>
+        explicit
+        reader(message<isRequest, Body, Fields>& m) noexcept
+            : v_(m.body)
+        {
+        }
+
+        void
+        init(error_code&) noexcept
+        {
+        }
+
+        void
+        write(void const* data,
+            std::size_t size, error_code& ec) noexcept
+        {
+            auto const b = boost::asio::buffer(data, size);
+            if(v_.chunked)
+                boost::asio::write(*v_.sock,
+                    chunk_encode(false, b), ec);
+            else
+                boost::asio::write(*v_.sock, b, ec);
+        }
+
+        void
+        finish(error_code& ec) noexcept
+        {
+            if(v_.chunked)
+                boost::asio::write(*v_.sock,
+                    chunk_encode_final(), ec);
+        }
+    };
+};
+
+/*  A synchronous HTTP/1 reverse proxy.
+
+    Each client connection is served on its own thread. Requests
+    are forwarded to a single upstream endpoint over connections
+    taken from a pool of idle keep-alive connections. Headers are
+    parsed with header_parser_v1 and forwarded, then the body, if
+    any, is relayed with relay_body in both directions.
+
+    A pooled connection may have been closed by the upstream server
+    while idle. When that happens before any part of the response
+    arrives, an idempotent request without a body is sent again on
+    another connection. Any other upstream failure is reported to
+    the client as 502 Bad Gateway, and the client connection closes.
+*/
+class http_proxy
+{
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    // Bodies are relayed in pieces of at most this size
+    static std::size_t constexpr buffer_size = 65536;
+
+    // A connection to the upstream server, with its read buffer
+    struct upstream
+    {
+        socket_type sock;
+        streambuf sb;
+        bool reused = false;
+
+        explicit
+        upstream(boost::asio::io_service& ios)
+            : sock(ios)
+            , sb(buffer_size)
+        {
+        }
+    };
+
+    bool log_ = true;
+    std::mutex m_;
+    boost::asio::io_service ios_;
+    socket_type sock_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    endpoint_type upstream_ep_;
+    std::vector<std::unique_ptr<upstream>> idle_;
+    std::thread thread_;
+
+public:
+    http_proxy(endpoint_type const& ep,
+            endpoint_type const& upstream_ep)
+        : sock_(ios_)
+        , acceptor_(ios_)
+        , upstream_ep_(upstream_ep)
+    {
+        acceptor_.open(ep.protocol());
+        acceptor_.set_option(
+            boost::asio::ip::tcp::acceptor::reuse_address{true});
+        acceptor_.bind(ep);
+        acceptor_.listen(
+            boost::asio::socket_base::max_connections);
+        acceptor_.async_accept(sock_,
+            std::bind(&http_proxy::on_accept, this,
+                beast::asio::placeholders::error));
+        thread_ = std::thread{[&]{ ios_.run(); }};
+    }
+
+    ~http_proxy()
+    {
+        error_code ec;
+        ios_.dispatch(
+            [&]{ acceptor_.close(ec); });
+        thread_.join();
+    }
+
+    endpoint_type
+    local_endpoint() const
+    {
+        return acceptor_.local_endpoint();
+    }
+
+    void
+    set_log(bool v)
+    {
+        log_ = v;
+    }
+
+    template<class... Args>
+    void
+    log(Args const&... args)
+    {
+        if(log_)
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            log_args(args...);
+        }
+    }
+
+private:
+    void
+    log_args()
+    {
+    }
+
+    template<class Arg, class... Args>
+    void
+    log_args(Arg const& arg, Args const&... args)
+    {
+        std::cerr << arg;
+        log_args(args...);
+    }
+
+    void
+    fail(error_code ec, std::string what)
+    {
+        log(what, ": ", ec.message(), "\n");
+    }
+
+    void
+    fail(int id, error_code const& ec)
+    {
+        if(ec && ec != boost::asio::error::operation_aborted &&
+                ec != boost::asio::error::eof)
+            log("#", id, " ", ec.message(), "\n");
+    }
+
+    std::unique_ptr<upstream>
+    get_upstream(error_code& ec)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            if(! idle_.empty())
+            {
+                auto up = std::move(idle_.back());
+                idle_.pop_back();
+                up->reused = true;
+                return up;
+            }
+        }
+        std::unique_ptr<upstream> up{new upstream{ios_}};
+        up->sock.connect(upstream_ep_, ec);
+        if(! ec)
+            up->sock.set_option(
+                boost::asio::ip::tcp::no_delay{true});
+        return up;
+    }
+
+    void
+    put_upstream(std::unique_ptr<upstream> up)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        idle_.emplace_back(std::move(up));
+    }
+
+    // Returns `true` if a body follows the header
+    template<bool isRequest, class Fields>
+    static
+    bool
+    has_body(header_parser_v1<isRequest, Fields> const& p)
+    {
+        if(p.flags() & parse_flag::chunked)
+            return true;
+        if(p.flags() & parse_flag::contentlength)
+            return std::stoull(p.get().fields[
+                "Content-Length"].to_string()) > 0;
+        // A response without a length ends at eof
+        return ! isRequest;
+    }
+
+    // Relay a message body from one socket to another
+    template<bool isRequest, class Fields>
+    bool
+    relay(header_parser_v1<isRequest, Fields>& hp,
+        socket_type& from, streambuf& sb,
+            socket_type& to, error_code& ec)
+    {
+        auto p = with_body<relay_body>(hp);
+        p.set_option(body_max_size{0});
+        p.get().body.sock = &to;
+        p.get().body.chunked =
+            (hp.flags() & parse_flag::chunked) != 0;
+        do
+        {
+            parse_some(from, sb, p, ec);
+        }
+        while(! ec && ! p.complete());
+        return ! ec && p.keep_alive();
+    }
+
+    // Returns `true` if the upstream server may have acted on
+    // the request more than once without harm (rfc7230 section 6.3.1)
+    static
+    bool
+    is_idempotent(std::string const& method)
+    {
+        return
+            method == "GET" || method == "HEAD" ||
+            method == "PUT" || method == "DELETE" ||
+            method == "OPTIONS" || method == "TRACE";
+    }
+
+    // Returns `true` if the error means the upstream
+    // server closed the connection.
+    static
+    bool
+    is_closed(error_code const& ec)
+    {
+        return
+            ec == boost::asio::error::eof ||
+            ec == boost::asio::error::connection_reset ||
+            ec == boost::asio::error::connection_aborted ||
+            ec == boost::asio::error::broken_pipe;
+    }
+
+    // Tell the client the upstream server failed.
+    // Returns `false` since the client connection closes.
+    static
+    bool
+    bad_gateway(socket_type& sock, int version)
+    {
+        response<empty_body> res;
+        res.version = version;
+        res.status = 502;
+        res.reason = "Bad Gateway";
+        prepare(res, connection::close);
+        error_code ec;
+        write(sock, res, ec);
+        return false;
+    }
+
+    // Forward one request and its response.
+    // Returns `false` if the client connection should close.
+    bool
+    do_request(header_parser_v1<true, fields>& hp,
+        socket_type& sock, streambuf& sb, error_code& ec)
+    {
+        // Relaying the body takes ownership of the header
+        auto const& req = hp.get();
+        auto const req_body = has_body(hp);
+        auto const head = req.method == "HEAD";
+        auto const client_keep_alive = hp.keep_alive();
+        // A relayed body cannot be sent again
+        auto const can_retry = ! req_body && is_idempotent(req.method);
+        for(;;)
+        {
+            auto up = get_upstream(ec);
+            if(ec)
+                return bad_gateway(sock, req.version);
+            write(up->sock, req, ec);
+            if(! ec && req_body)
+            {
+                relay(hp, sock, sb, up->sock, ec);
+                if(ec)
+                    return false;
+            }
+            // Read the start of the response here, so that a
+            // connection closed before the upstream server sent
+            // anything can be told apart from a failed response.
+            if(! ec && up->sb.size() == 0)
+                up->sb.commit(up->sock.read_some(
+                    up->sb.prepare(buffer_size), ec));
+            if(ec && up->reused && can_retry &&
+                is_closed(ec) && up->sb.size() == 0)
+            {
+                // The idle connection was closed
+                // by the upstream server, try again.
+                ec = {};
+                continue;
+            }
+            header_parser_v1<false, fields> rp;
+            if(! ec)
+                parse(up->sock, up->sb, rp, ec);
+            if(ec)
+                return bad_gateway(sock, req.version);
+            auto const& res = rp.get();
+            write(sock, res, ec);
+            if(ec)
+                return false;
+            bool keep_alive = rp.keep_alive();
+            bool const res_body = ! head &&
+                res.status / 100 != 1 &&
+                res.status != 204 &&
+                res.status != 304 &&
+                has_body(rp);
+            if(res_body)
+                keep_alive = relay(rp, up->sock, up->sb, sock, ec);
+            if(ec)
+                return false;
+            if(keep_alive)
+                put_upstream(std::move(up));
+            // A body delimited by eof is delimited
+            // the same way for the client.
+            return client_keep_alive && (! res_body ||
+                (rp.flags() & (parse_flag::chunked |
+                    parse_flag::contentlength)) != 0);
+        }
+    }
+
+    struct lambda
+    {
+        int id;
+        http_proxy& self;
+        socket_type sock;
+        boost::asio::io_service::work work;
+
+        lambda(int id_, http_proxy& self_,
+                socket_type&& sock_)
+            : id(id_)
+            , self(self_)
+            , sock(std::move(sock_))
+            , work(sock.get_io_service())
+        {
+        }
+
+        void operator()()
+        {
+            self.do_peer(id, std::move(sock));
+        }
+    };
+
+    void
+    on_accept(error_code ec)
+    {
+        if(! acceptor_.is_open())
+            return;
+        if(ec)
+            return fail(ec, "accept");
+        static int id_ = 0;
+        std::thread{lambda{++id_, *this, std::move(sock_)}}.detach();
+        acceptor_.async_accept(sock_,
+            std::bind(&http_proxy::on_accept, this,
+                asio::placeholders::error));
+    }
+
+    void
+    do_peer(int id, socket_type&& sock0)
+    {
+        socket_type sock(std::move(sock0));
+        sock.set_option(boost::asio::ip::tcp::no_delay{true});
+        streambuf sb{buffer_size};
+        error_code ec;
+        for(;;)
+        {
+            header_parser_v1<true, fields> hp;
+            parse(sock, sb, hp, ec);
+            if(ec)
+                break;
+            if(! do_request(hp, sock, sb, ec))
+                break;
+        }
+        fail(id, ec);
+    }
+};
+
+} // http
+} // beast
+
+#endif
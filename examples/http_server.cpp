@@ -5,12 +5,16 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include "bench_client.hpp"
 #include "http_async_server.hpp"
+#include "http_group_server.hpp"
 #include "http_sync_server.hpp"
 
 #include <beast/test/sig_wait.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <fstream>
 #include <iostream>
 
 int main(int ac, char const* av[])
@@ -29,6 +33,15 @@ int main(int ac, char const* av[])
         ("threads,n",   po::value<std::size_t>()->default_value(4),
                         "Set the number of threads to use")
         ("sync,s",      "Launch a synchronous server")
+        ("group,g",     "Launch a server with one io_service per thread")
+        ("pin",         "Bind each thread of the group server to a CPU")
+        ("bench,b",     "Compare the asynchronous servers on the loopback interface")
+        ("connections,c", po::value<std::size_t>()->default_value(32),
+                        "Set the number of benchmark client connections")
+        ("requests",    po::value<std::size_t>()->default_value(10000),
+                        "Set the number of requests per connection")
+        ("size",        po::value<std::size_t>()->default_value(1024),
+                        "Set the size of the benchmark file")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(ac, av, desc), vm);
@@ -43,9 +56,42 @@ int main(int ac, char const* av[])
 
     bool sync = vm.count("sync") > 0;
 
+    bool group = vm.count("group") > 0;
+
+    bool pin = vm.count("pin") > 0;
+
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using address_type = boost::asio::ip::address;
 
+    if(vm.count("bench"))
+    {
+        // Serve a single file from a temporary directory
+        namespace fs = boost::filesystem;
+        auto const dir = fs::temp_directory_path() /
+            fs::unique_path("beast-%%%%-%%%%");
+        fs::create_directories(dir);
+        std::ofstream(fs::path{dir / "bench.bin"}.string(),
+            std::ios::binary) << std::string(
+                vm["size"].as<std::size_t>(), '*');
+        auto const conns = vm["connections"].as<std::size_t>();
+        auto const n = vm["requests"].as<std::size_t>();
+        endpoint_type ep{address_type::from_string("127.0.0.1"), 0};
+        {
+            http_async_server server(ep, threads, dir.string());
+            server.set_log(false);
+            report("strand", run_clients(
+                server.local_endpoint(), conns, n, 0, "/bench.bin"));
+        }
+        {
+            http_group_server server(ep, threads, dir.string(), pin);
+            server.set_log(false);
+            report("group", run_clients(
+                server.local_endpoint(), conns, n, 0, "/bench.bin"));
+        }
+        fs::remove_all(dir);
+        return 0;
+    }
+
     endpoint_type ep{address_type::from_string(ip), port};
 
     if(sync)
@@ -53,6 +99,11 @@ int main(int ac, char const* av[])
         http_sync_server server(ep, root);
         beast::test::sig_wait();
     }
+    else if(group)
+    {
+        http_group_server server(ep, threads, root, pin);
+        beast::test::sig_wait();
+    }
     else
     {
         http_async_server server(ep, threads, root);
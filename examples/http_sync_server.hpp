@@ -8,7 +8,6 @@
 #ifndef BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
@@ -169,6 +168,7 @@ private:
                 res.reason = "Not Found";
                 res.version = req.version;
                 res.fields.insert("Server", "http_sync_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", "text/html");
                 res.body = "The file '" + path + "' was not found";
                 prepare(res);
@@ -184,6 +184,7 @@ private:
                 res.reason = "OK";
                 res.version = req.version;
                 res.fields.insert("Server", "http_sync_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", mime_type(path));
                 res.body = path;
                 prepare(res);
@@ -198,6 +199,7 @@ private:
                 res.reason = "Internal Error";
                 res.version = req.version;
                 res.fields.insert("Server", "http_sync_server");
+                res.fields.insert("Date", date_string());
                 res.fields.insert("Content-Type", "text/html");
                 res.body =
                     std::string{"An internal error occurred: "} + e.what();
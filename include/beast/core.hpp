@@ -11,15 +11,21 @@
 #include <beast/core/async_completion.hpp>
 #include <beast/core/basic_streambuf.hpp>
 #include <beast/core/bind_handler.hpp>
+#include <beast/core/block_pool.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/buffers_adapter.hpp>
+#include <beast/core/buffers_snapshot.hpp>
+#include <beast/core/circular_streambuf.hpp>
 #include <beast/core/consuming_buffers.hpp>
 #include <beast/core/error.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/handler_concepts.hpp>
 #include <beast/core/placeholders.hpp>
 #include <beast/core/prepare_buffers.hpp>
+#include <beast/core/read_size.hpp>
+#include <beast/core/server_group.hpp>
 #include <beast/core/static_streambuf.hpp>
 #include <beast/core/static_string.hpp>
 #include <beast/core/stream_concepts.hpp>
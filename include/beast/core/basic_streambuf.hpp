@@ -74,6 +74,7 @@ private:
     list_type list_;        // list of allocated buffers
     iterator out_;          // element that contains out_pos_
     size_type alloc_size_;  // min amount to allocate
+    size_type list_size_ = 0; // sum of the sizes of the elements
     size_type in_size_ = 0; // size of the input sequence
     size_type in_pos_ = 0;  // input offset in list_.front()
     size_type out_pos_ = 0; // output offset in *out_
@@ -255,7 +256,10 @@ public:
 
     /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
     std::size_t
-    capacity() const;
+    capacity() const
+    {
+        return list_size_ - in_pos_;
+    }
 
     /** Get a list of buffers that represents the input sequence.
 
@@ -284,6 +288,19 @@ public:
     void
     consume(size_type n);
 
+    /** Reallocate the storage to exactly fit the input sequence.
+
+        The output sequence is discarded. When the input sequence
+        is empty, all memory is released. This allows a stream
+        buffer belonging to an idle connection to give its memory
+        back to the allocator.
+
+        @note All previous buffers sequences obtained from
+        calls to @ref data or @ref prepare are invalidated.
+    */
+    void
+    shrink_to_fit();
+
     // Helper for boost::asio::read_until
     template<class OtherAllocator>
     friend
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_BLOCK_POOL_HPP
+#define BEAST_BLOCK_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+
+namespace beast {
+
+/** A pool of recycled memory blocks in a few fixed sizes.
+
+    Requests are rounded up to the smallest size class which can
+    hold them, and blocks returned to the pool are kept on a free
+    list for that class instead of being released. This removes
+    the allocator from the steady state of containers which
+    repeatedly allocate and free blocks of the same size, such as
+    a @ref basic_streambuf on a connection which is streaming data.
+    Requests larger than the largest class are passed through to
+    the global allocator.
+
+    Each size class serves requests of up to its size plus a small
+    amount of headroom, so that containers which add a header to
+    a round block size, like @ref basic_streambuf, still use the
+    intended class. For example, a streambuf with an allocation
+    size of 4096 draws its blocks from the 4KB class.
+
+    Use @ref pool_allocator to obtain memory from a pool through
+    an `Allocator` template parameter.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe. Each size class has its own lock,
+    so threads allocating blocks of different sizes do not contend.
+
+    @note The pool must outlive every container which uses it.
+*/
+class block_pool
+{
+public:
+    /// Bytes of headroom added to each size class.
+    static std::size_t constexpr headroom = 64;
+
+    /// Statistics for a pool, or for one size class.
+    struct stats_type
+    {
+        /// The number of allocations satisfied from a free list.
+        std::size_t hits = 0;
+
+        /// The number of allocations which needed a new block.
+        std::size_t misses = 0;
+
+        /// The number of allocations larger than any size class.
+        std::size_t oversize = 0;
+
+        /// The number of bytes in blocks held on free lists.
+        std::size_t idle = 0;
+
+        /// The number of bytes in blocks currently allocated.
+        std::size_t used = 0;
+    };
+
+    /** Construct a pool with the default size classes.
+
+        The default classes are 4KB, 16KB and 64KB.
+
+        @param max_idle The maximum number of bytes held in unused
+        blocks. Blocks returned when the limit would be exceeded
+        are freed instead.
+    */
+    explicit
+    block_pool(std::size_t max_idle = 16 * 1024 * 1024);
+
+    /** Construct a pool with the given size classes.
+
+        @param sizes The size of each class, in increasing order.
+
+        @param max_idle The maximum number of bytes held in unused
+        blocks. Blocks returned when the limit would be exceeded
+        are freed instead.
+    */
+    block_pool(std::initializer_list<std::size_t> sizes,
+        std::size_t max_idle = 16 * 1024 * 1024);
+
+    block_pool(block_pool const&) = delete;
+    block_pool& operator=(block_pool const&) = delete;
+
+    /// Destructor. Frees all unused blocks.
+    ~block_pool();
+
+    /** Allocate a block.
+
+        @param size The number of bytes required.
+
+        @return A pointer to at least `size` bytes, suitably
+        aligned for any fundamental type.
+
+        @throws std::bad_alloc if memory could not be obtained.
+    */
+    void*
+    allocate(std::size_t size);
+
+    /** Return a block to the pool.
+
+        @param p A block previously returned by `allocate`.
+
+        @param size The size passed to `allocate`.
+    */
+    void
+    deallocate(void* p, std::size_t size) noexcept;
+
+    /// Free all unused blocks.
+    void
+    shrink_to_fit();
+
+    /// Return the number of size classes.
+    std::size_t
+    classes() const
+    {
+        return n_;
+    }
+
+    /// Return the size of a class.
+    std::size_t
+    class_size(std::size_t i) const
+    {
+        return buckets_[i].size;
+    }
+
+    /// Return the statistics for the whole pool.
+    stats_type
+    stats() const;
+
+    /// Return the statistics for one size class.
+    stats_type
+    stats(std::size_t i) const;
+
+private:
+    struct node
+    {
+        node* next;
+    };
+
+    struct bucket
+    {
+        std::mutex mutable m;
+        std::size_t size = 0;
+        node* free = nullptr;
+        stats_type stats;
+    };
+
+    bucket*
+    find(std::size_t size) const;
+
+    std::unique_ptr<bucket[]> buckets_;
+    std::size_t n_;
+    std::size_t max_idle_;
+    std::atomic<std::size_t> idle_;
+    std::atomic<std::size_t> oversize_;
+    std::atomic<std::size_t> oversize_used_;
+};
+
+//------------------------------------------------------------------------------
+
+/** An `Allocator` which obtains memory from a @ref block_pool.
+
+    All allocators constructed from the same pool, including
+    rebound copies, compare equal.
+
+    @par Example
+    @code
+        block_pool pool;
+        basic_streambuf<pool_allocator<char>> sb{
+            4096, pool_allocator<char>{pool}};
+    @endcode
+*/
+template<class T>
+class pool_allocator
+{
+    template<class U>
+    friend class pool_allocator;
+
+    block_pool* pool_;
+
+public:
+    using value_type = T;
+
+    /// Construct an allocator which uses the given pool.
+    explicit
+    pool_allocator(block_pool& pool) noexcept
+        : pool_(&pool)
+    {
+    }
+
+    /// Construct from an allocator for another type.
+    template<class U>
+    pool_allocator(pool_allocator<U> const& other) noexcept
+        : pool_(other.pool_)
+    {
+    }
+
+    /// Return the pool used by this allocator.
+    block_pool&
+    pool() const
+    {
+        return *pool_;
+    }
+
+    /// Allocate storage for `n` objects.
+    T*
+    allocate(std::size_t n)
+    {
+        return static_cast<T*>(
+            pool_->allocate(n * sizeof(T)));
+    }
+
+    /// Deallocate storage for `n` objects.
+    void
+    deallocate(T* p, std::size_t n) noexcept
+    {
+        pool_->deallocate(p, n * sizeof(T));
+    }
+
+    template<class U>
+    friend
+    bool
+    operator==(pool_allocator const& lhs,
+        pool_allocator<U> const& rhs) noexcept
+    {
+        return lhs.pool_ == &rhs.pool();
+    }
+
+    template<class U>
+    friend
+    bool
+    operator!=(pool_allocator const& lhs,
+        pool_allocator<U> const& rhs) noexcept
+    {
+        return lhs.pool_ != &rhs.pool();
+    }
+};
+
+} // beast
+
+#include <beast/core/impl/block_pool.ipp>
+
+#endif
@@ -52,6 +52,49 @@ buffer_cat(B1 const& b1, B2 const& b2, Bn const&... bn)
         B1, B2, Bn...>{b1, b2, bn...};
 }
 
+/** Concatenate 2 or more buffer sequences into an array.
+
+    This function returns a constant or mutable buffer sequence
+    representing the concatenation of the input buffer sequences,
+    like @ref buffer_cat. When the result is constructed, the
+    non-empty buffers of the inputs are copied into an array
+    stored in the object, so that iterating the result is as
+    fast as iterating an array. This is useful when the result
+    is iterated more than once, for example by a call to
+    `boost::asio::write`, which iterates the buffers on each
+    call to `write_some`.
+
+    If the inputs have more than `N` non-empty buffers, the
+    result iterates the inputs the same way as @ref buffer_cat.
+    No memory is allocated in either case.
+
+    @tparam N The largest number of buffers stored in the array.
+
+    @param buffers The list of buffer sequences to concatenate.
+
+    @return A new buffer sequence that represents the concatenation
+    of the input buffer sequences. This buffer sequence will be a
+    @b MutableBufferSequence if each of the passed buffer sequences
+    is also a @b MutableBufferSequence, else the returned buffer
+    sequence will be a @b ConstBufferSequence.
+*/
+#if GENERATING_DOCS
+template<std::size_t N = 16, class... BufferSequence>
+implementation_defined
+flat_buffer_cat(BufferSequence const&... buffers)
+#else
+template<std::size_t N = 16, class B1, class B2, class... Bn>
+detail::flat_buffer_cat_helper<N, B1, B2, Bn...>
+flat_buffer_cat(B1 const& b1, B2 const& b2, Bn const&... bn)
+#endif
+{
+    static_assert(
+        detail::is_all_ConstBufferSequence<B1, B2, Bn...>::value,
+            "BufferSequence requirements not met");
+    return detail::flat_buffer_cat_helper<
+        N, B1, B2, Bn...>{b1, b2, bn...};
+}
+
 } // beast
 
 #endif
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_BUFFERS_SNAPSHOT_HPP
+#define BEAST_BUFFERS_SNAPSHOT_HPP
+
+#include <beast/core/buffer_concepts.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace beast {
+
+/** A copy of the buffers in a @b `ConstBufferSequence`, stored in an array.
+
+    This captures the buffers of a sequence once, so that algorithms
+    which iterate the sequence repeatedly, or which need the buffers
+    in an array such as a call to `writev`, do not pay for the
+    iterator operations of the original sequence each time. The
+    total number of bytes is also computed once, at construction.
+
+    Empty buffers are skipped. Up to `N` buffers are stored inside
+    the object, larger sequences use a dynamic allocation.
+
+    The snapshot refers to the same memory as the original sequence,
+    it is invalidated by any operation which invalidates those
+    buffers, for example a call to `consume` on a @b `DynamicBuffer`.
+
+    @tparam N The number of buffers stored without an allocation.
+
+    @tparam Buffer The type of buffer stored, either
+    `boost::asio::const_buffer` or `boost::asio::mutable_buffer`.
+    When this is `boost::asio::mutable_buffer`, the snapshot is
+    a @b `MutableBufferSequence`.
+*/
+template<std::size_t N = 16,
+    class Buffer = boost::asio::const_buffer>
+class buffers_snapshot
+{
+    std::array<Buffer, N> a_;
+    std::vector<Buffer> v_;
+    std::size_t n_ = 0;
+    std::size_t size_ = 0;
+
+public:
+    /// The type for each element in the list of buffers.
+    using value_type = Buffer;
+
+#if GENERATING_DOCS
+    /// A bidirectional iterator type that may be used to read elements.
+    using const_iterator = implementation_defined;
+
+#else
+    using const_iterator = value_type const*;
+
+#endif
+
+    /// Move constructor.
+    buffers_snapshot(buffers_snapshot&&) = default;
+
+    /// Copy constructor.
+    buffers_snapshot(buffers_snapshot const&) = default;
+
+    /// Move assignment.
+    buffers_snapshot& operator=(buffers_snapshot&&) = default;
+
+    /// Copy assignment.
+    buffers_snapshot& operator=(buffers_snapshot const&) = default;
+
+    /** Construct a snapshot of a buffer sequence.
+
+        @param buffers The buffer sequence to copy. Ownership of
+        the memory is not transferred.
+    */
+    template<class ConstBufferSequence
+#if ! GENERATING_DOCS
+        , class = typename std::enable_if<
+            ! std::is_same<ConstBufferSequence,
+                buffers_snapshot>::value>::type
+#endif
+    >
+    explicit
+    buffers_snapshot(ConstBufferSequence const& buffers)
+    {
+        static_assert(is_ConstBufferSequence<
+            ConstBufferSequence>::value,
+                "ConstBufferSequence requirements not met");
+        using boost::asio::buffer_size;
+        for(auto it = buffers.begin(); it != buffers.end(); ++it)
+        {
+            value_type const b = *it;
+            auto const n = buffer_size(b);
+            if(n == 0)
+                continue;
+            size_ += n;
+            if(n_ < N)
+            {
+                a_[n_++] = b;
+                continue;
+            }
+            // The array is full, move to the vector
+            if(n_ == N)
+                v_.assign(a_.begin(), a_.end());
+            v_.push_back(b);
+            ++n_;
+        }
+    }
+
+    /// Returns the number of bytes in the buffers.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /// Returns the number of non-empty buffers.
+    std::size_t
+    count() const
+    {
+        return n_;
+    }
+
+    /// Returns a pointer to the first buffer.
+    value_type const*
+    data() const
+    {
+        return n_ <= N ? a_.data() : v_.data();
+    }
+
+    /// Get a bidirectional iterator to the first element.
+    const_iterator
+    begin() const
+    {
+        return data();
+    }
+
+    /// Get a bidirectional iterator to one past the last element.
+    const_iterator
+    end() const
+    {
+        return data() + n_;
+    }
+};
+
+} // beast
+
+#endif
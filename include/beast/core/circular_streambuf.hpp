@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_CIRCULAR_STREAMBUF_HPP
+#define BEAST_CIRCULAR_STREAMBUF_HPP
+
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` using a fixed size ring of storage.
+
+    The storage is allocated once, at construction. Bytes are never
+    moved: the input and output sequences wrap around the end of
+    the storage, so each is represented by at most two buffers.
+    When the input sequence becomes empty the positions are reset
+    to the beginning of the storage, so a reader which consumes
+    everything it parses sees a single buffer in the common case.
+
+    @note Calls to `prepare` which would exceed the free space in
+    the ring throw `std::length_error`.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_circular_streambuf
+#if ! GENERATING_DOCS
+    : private detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>;
+#endif
+
+private:
+    using alloc_traits =
+        std::allocator_traits<allocator_type>;
+
+    template<class Buffer>
+    class buffers_type;
+
+    std::uint8_t* p_;
+    std::size_t cap_;
+    std::size_t in_pos_ = 0;
+    std::size_t in_size_ = 0;
+    std::size_t out_size_ = 0;
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    using const_buffers_type =
+        buffers_type<boost::asio::const_buffer>;
+
+    using mutable_buffers_type =
+        buffers_type<boost::asio::mutable_buffer>;
+
+#endif
+
+    /// Destructor.
+    ~basic_circular_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the storage, input sequence and
+        output sequence of the other stream buffer.
+
+        @note After the move, the moved-from object has a
+        capacity of zero.
+    */
+    basic_circular_streambuf(basic_circular_streambuf&&);
+
+    /// Copy constructor (deleted).
+    basic_circular_streambuf(
+        basic_circular_streambuf const&) = delete;
+
+    /// Copy assignment (deleted).
+    basic_circular_streambuf& operator=(
+        basic_circular_streambuf const&) = delete;
+
+    /** Construct a circular stream buffer.
+
+        @param capacity The number of bytes of storage to allocate.
+
+        @param alloc The allocator to use. If this parameter is
+        unspecified, a default constructed allocator will be used.
+    */
+    explicit
+    basic_circular_streambuf(std::size_t capacity,
+        Allocator const& alloc = Allocator{});
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return in_size_;
+    }
+
+    /// Return the maximum sum of the input and output sequence sizes.
+    std::size_t
+    max_size() const
+    {
+        return cap_;
+    }
+
+    /// Return the maximum sum of input and output sizes that can be held without an allocation.
+    std::size_t
+    capacity() const
+    {
+        return cap_;
+    }
+
+    /** Get a list of buffers that represent the input sequence.
+
+        @note These buffers remain valid across subsequent calls to `prepare`.
+    */
+    const_buffers_type
+    data() const;
+
+    /** Get a list of buffers that represent the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /** Move bytes from the output sequence to the input sequence.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    void
+    commit(std::size_t n);
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    template<class OtherAlloc>
+    friend
+    std::size_t
+    read_size_helper(basic_circular_streambuf<
+        OtherAlloc> const&, std::size_t);
+};
+
+/// A circular stream buffer using the default allocator.
+using circular_streambuf =
+    basic_circular_streambuf<std::allocator<char>>;
+
+} // beast
+
+#include <beast/core/impl/circular_streambuf.ipp>
+
+#endif
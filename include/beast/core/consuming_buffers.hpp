@@ -9,6 +9,8 @@
 #define BEAST_CONSUMING_BUFFERS_HPP
 
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/prepare_buffer.hpp>
+#include <beast/core/detail/consuming_buffers.hpp>
 #include <boost/asio/buffer.hpp>
 #include <cstdint>
 #include <iterator>
@@ -111,6 +113,62 @@ public:
     consume(std::size_t n);
 };
 
+#if ! GENERATING_DOCS
+
+/*  Specializations for a sequence of one buffer.
+
+    These keep the buffer itself rather than a copy of the
+    sequence and an iterator into it, so that consuming and
+    iterating reduce to pointer arithmetic.
+*/
+template<>
+class consuming_buffers<boost::asio::const_buffers_1>
+    : public detail::consuming_buffer<boost::asio::const_buffer>
+{
+public:
+    explicit
+    consuming_buffers(boost::asio::const_buffers_1 const& buffers)
+        : detail::consuming_buffer<
+            boost::asio::const_buffer>(*buffers.begin())
+    {
+    }
+};
+
+template<>
+class consuming_buffers<boost::asio::mutable_buffers_1>
+    : public detail::consuming_buffer<boost::asio::mutable_buffer>
+{
+public:
+    explicit
+    consuming_buffers(boost::asio::mutable_buffers_1 const& buffers)
+        : detail::consuming_buffer<
+            boost::asio::mutable_buffer>(*buffers.begin())
+    {
+    }
+};
+
+/// Return a shortened buffer sequence from a consumed single buffer.
+inline
+boost::asio::const_buffers_1
+prepare_buffers(std::size_t n,
+    consuming_buffers<boost::asio::const_buffers_1> const& buffers)
+{
+    return boost::asio::const_buffers_1{
+        prepare_buffer(n, buffers.get())};
+}
+
+/// Return a shortened buffer sequence from a consumed single buffer.
+inline
+boost::asio::mutable_buffers_1
+prepare_buffers(std::size_t n,
+    consuming_buffers<boost::asio::mutable_buffers_1> const& buffers)
+{
+    return boost::asio::mutable_buffers_1{
+        prepare_buffer(n, buffers.get())};
+}
+
+#endif
+
 } // beast
 
 #include <beast/core/impl/consuming_buffers.ipp>
@@ -8,8 +8,15 @@
 #ifndef BEAST_DETAIL_BASE64_HPP
 #define BEAST_DETAIL_BASE64_HPP
 
-#include <cctype>
+#include <beast/core/detail/cpu_info.hpp>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <utility>
+
+#if BEAST_X86_INTRINSICS
+#include <immintrin.h>
+#endif
 
 namespace beast {
 namespace detail {
@@ -45,131 +52,314 @@ namespace detail {
 */
 
 template<class = void>
-std::string const&
+char const*
 base64_alphabet()
 {
-    static std::string const alphabet =
+    static char constexpr tab[] = {
         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
         "abcdefghijklmnopqrstuvwxyz"
-        "0123456789+/";
-    return alphabet;
+        "0123456789+/"
+    };
+    return &tab[0];
+}
+
+// Maps a character to its six bit value, or -1 if invalid
+template<class = void>
+signed char const*
+base64_inverse()
+{
+    static signed char constexpr tab[] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+        -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+        -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    };
+    return &tab[0];
 }
 
 inline
 bool
 is_base64(unsigned char c)
 {
-    return (std::isalnum(c) || (c == '+') || (c == '/'));
+    return base64_inverse()[c] != -1;
 }
 
-template<class = void>
-std::string
-base64_encode (std::uint8_t const* data,
-    std::size_t in_len)
+/// Returns the number of characters needed to encode `n` bytes.
+inline
+std::size_t constexpr
+base64_encoded_size(std::size_t n)
 {
-    unsigned char c3[3], c4[4];
-    int i = 0;
-    int j = 0;
+    return 4 * ((n + 2) / 3);
+}
 
-    std::string ret;
-    ret.reserve (3 + in_len * 8 / 6);
+/// Returns the most bytes that `n` characters can decode to.
+inline
+std::size_t constexpr
+base64_decoded_size(std::size_t n)
+{
+    return n / 4 * 3 + n % 4 * 3 / 4;
+}
 
-    char const* alphabet (base64_alphabet().data());
+#if BEAST_X86_INTRINSICS
 
-    while(in_len--)
+// Encode groups of 12 input bytes to 16 characters, while
+// at least 16 bytes remain to be loaded. Returns the number
+// of input bytes consumed, which is a multiple of 12.
+//
+// Algorithm by Wojciech Mula:
+// http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+//
+__attribute__((target("ssse3")))
+inline
+std::size_t
+base64_encode_ssse3(char* out,
+    std::uint8_t const* in, std::size_t len)
+{
+    auto const shuf = _mm_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    auto const shift = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    std::size_t n = 0;
+    for(; len - n >= 16; n += 12, out += 16)
     {
-        c3[i++] = *(data++);
-        if(i == 3)
-        {
-            c4[0] = (c3[0] & 0xfc) >> 2;
-            c4[1] = ((c3[0] & 0x03) << 4) + ((c3[1] & 0xf0) >> 4);
-            c4[2] = ((c3[1] & 0x0f) << 2) + ((c3[2] & 0xc0) >> 6);
-            c4[3] = c3[2] & 0x3f;
-            for(i = 0; (i < 4); i++)
-                ret += alphabet[c4[i]];
-            i = 0;
-        }
+        auto v = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in + n)), shuf);
+        // Move each six bit field into its own byte
+        auto const t0 = _mm_mulhi_epu16(
+            _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                _mm_set1_epi32(0x04000040));
+        auto const t1 = _mm_mullo_epi16(
+            _mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                _mm_set1_epi32(0x01000010));
+        auto const idx = _mm_or_si128(t0, t1);
+        // Map each range of the alphabet to an offset
+        auto r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+        r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(
+            _mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+        v = _mm_add_epi8(_mm_shuffle_epi8(shift, r), idx);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
     }
+    return n;
+}
 
-    if(i)
+// Decode groups of 16 characters to 12 bytes, stopping at
+// the first group containing a character which is not in
+// the alphabet. Returns the number of characters consumed,
+// which is a multiple of 16.
+//
+// Algorithm by Wojciech Mula:
+// http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+//
+__attribute__((target("ssse3")))
+inline
+std::size_t
+base64_decode_ssse3(std::uint8_t* out,
+    char const* in, std::size_t len)
+{
+    auto const shift = _mm_setr_epi8(
+        0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto const mask = _mm_setr_epi8(
+        '\xa8', '\xf8', '\xf8', '\xf8', '\xf8', '\xf8', '\xf8',
+        '\xf8', '\xf8', '\xf8', '\xf0', '\x54', '\x50', '\x50',
+        '\x50', '\x54');
+    auto const bitpos = _mm_setr_epi8(
+        '\x01', '\x02', '\x04', '\x08', '\x10', '\x20', '\x40',
+        '\x80', 0, 0, 0, 0, 0, 0, 0, 0);
+    auto const pack = _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    std::size_t n = 0;
+    for(; len - n >= 16; n += 16, out += 12)
     {
-        for(j = i; j < 3; j++)
-            c3[j] = '\0';
+        auto const v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in + n));
+        auto const hi = _mm_and_si128(
+            _mm_srli_epi32(v, 4), _mm_set1_epi8(0x0f));
+        auto const lo = _mm_and_si128(v, _mm_set1_epi8(0x0f));
+        // Each low nibble selects the set of high
+        // nibbles which form a valid character.
+        auto const valid = _mm_and_si128(
+            _mm_shuffle_epi8(mask, lo),
+                _mm_shuffle_epi8(bitpos, hi));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                valid, _mm_setzero_si128())) != 0)
+            break;
+        // '/' shares its high nibble with '+'
+        auto const off = _mm_add_epi8(
+            _mm_shuffle_epi8(shift, hi), _mm_and_si128(
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('/')),
+                    _mm_set1_epi8(-3)));
+        auto r = _mm_add_epi8(v, off);
+        r = _mm_maddubs_epi16(r, _mm_set1_epi32(0x01400140));
+        r = _mm_madd_epi16(r, _mm_set1_epi32(0x00011000));
+        r = _mm_shuffle_epi8(r, pack);
+        std::uint8_t tmp[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(tmp), r);
+        std::memcpy(out, tmp, 12);
+    }
+    return n;
+}
 
-        c4[0] = (c3[0] & 0xfc) >> 2;
-        c4[1] = ((c3[0] & 0x03) << 4) + ((c3[1] & 0xf0) >> 4);
-        c4[2] = ((c3[1] & 0x0f) << 2) + ((c3[2] & 0xc0) >> 6);
-        c4[3] = c3[2] & 0x3f;
+#endif
 
-        for(j = 0; (j < i + 1); j++)
-            ret += alphabet[c4[j]];
+/** Encode a series of octets as a padded, base64 string.
 
-        while((i++ < 3))
-            ret += '=';
-    }
+    The resulting string will not be null terminated.
 
-    return ret;
+    @par Requires
 
-}
+    The memory pointed to by `dest` points to valid memory
+    of at least `base64_encoded_size(len)` bytes.
 
+    @return The number of characters written to `dest`. This
+    will exclude any null termination.
+*/
 template<class = void>
-std::string
-base64_encode (std::string const& s)
+std::size_t
+base64_encode(void* dest, void const* src, std::size_t len)
 {
-    return base64_encode (reinterpret_cast <
-        std::uint8_t const*> (s.data()), s.size());
+    auto out = static_cast<char*>(dest);
+    auto in = static_cast<std::uint8_t const*>(src);
+    auto const tab = base64_alphabet();
+#if BEAST_X86_INTRINSICS
+    if(len >= 16 && get_cpu_info().ssse3)
+    {
+        auto const n = base64_encode_ssse3(out, in, len);
+        out += n / 3 * 4;
+        in += n;
+        len -= n;
+    }
+#endif
+    for(; len >= 3; len -= 3, in += 3)
+    {
+        *out++ = tab[  in[0] >> 2];
+        *out++ = tab[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+        *out++ = tab[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
+        *out++ = tab[  in[2] & 0x3f];
+    }
+    switch(len)
+    {
+    case 2:
+        *out++ = tab[  in[0] >> 2];
+        *out++ = tab[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+        *out++ = tab[ (in[1] & 0x0f) << 2];
+        *out++ = '=';
+        break;
+
+    case 1:
+        *out++ = tab[  in[0] >> 2];
+        *out++ = tab[ (in[0] & 0x03) << 4];
+        *out++ = '=';
+        *out++ = '=';
+        break;
+
+    default:
+        break;
+    }
+    return static_cast<std::size_t>(
+        out - static_cast<char*>(dest));
 }
 
+/** Decode a padded base64 string into a series of octets.
+
+    Decoding stops at the first padding character, or at
+    the first character which is not in the alphabet.
+
+    @par Requires
+
+    The memory pointed to by `dest` points to valid memory
+    of at least `base64_decoded_size(len)` bytes.
+
+    @return The number of octets written to `dest`, and
+    the number of characters read from the input string.
+*/
 template<class = void>
-std::string
-base64_decode(std::string const& data)
+std::pair<std::size_t, std::size_t>
+base64_decode(void* dest, char const* src, std::size_t len)
 {
-    auto in_len = data.size();
-    unsigned char c3[3], c4[4];
+    auto out = static_cast<std::uint8_t*>(dest);
+    auto in = src;
+    auto const inverse = base64_inverse();
+#if BEAST_X86_INTRINSICS
+    if(len >= 16 && get_cpu_info().ssse3)
+    {
+        auto const n = base64_decode_ssse3(out, in, len);
+        out += n / 4 * 3;
+        in += n;
+        len -= n;
+    }
+#endif
+    unsigned char c4[4];
     int i = 0;
-    int j = 0;
-    int in_ = 0;
-
-    std::string ret;
-    ret.reserve (in_len * 6 / 8); // ???
-
-    while(in_len-- && (data[in_] != '=') &&
-        is_base64(data[in_]))
+    for(; len > 0; --len)
     {
-        c4[i++] = data[in_]; in_++;
-        if(i == 4) {
-            for(i = 0; i < 4; i++)
-                c4[i] = static_cast<unsigned char>(
-                    base64_alphabet().find(c4[i]));
-
-            c3[0] = (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
-            c3[1] = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
-            c3[2] = ((c4[2] & 0x3) << 6) + c4[3];
-
-            for(i = 0; (i < 3); i++)
-                ret += c3[i];
+        auto const c = inverse[
+            static_cast<unsigned char>(*in)];
+        if(c == -1)
+            break;
+        ++in;
+        c4[i++] = static_cast<unsigned char>(c);
+        if(i == 4)
+        {
+            *out++ =  (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
+            *out++ = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
+            *out++ = ((c4[2] & 0x3) << 6) + c4[3];
             i = 0;
         }
     }
-
-    if(i)
+    if(i > 1)
     {
-        for(j = i; j < 4; j++)
-            c4[j] = 0;
-
-        for(j = 0; j < 4; j++)
-            c4[j] = static_cast<unsigned char>(
-                base64_alphabet().find(c4[j]));
+        *out++ = (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
+        if(i > 2)
+            *out++ = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
+    }
+    return {static_cast<std::size_t>(
+        out - static_cast<std::uint8_t*>(dest)),
+            static_cast<std::size_t>(in - src)};
+}
 
-        c3[0] = (c4[0] << 2) + ((c4[1] & 0x30) >> 4);
-        c3[1] = ((c4[1] & 0xf) << 4) + ((c4[2] & 0x3c) >> 2);
-        c3[2] = ((c4[2] & 0x3) << 6) + c4[3];
+template<class = void>
+std::string
+base64_encode (std::uint8_t const* data,
+    std::size_t len)
+{
+    std::string dest;
+    dest.resize(base64_encoded_size(len));
+    dest.resize(base64_encode(&dest[0], data, len));
+    return dest;
+}
 
-        for(j = 0; (j < i - 1); j++)
-            ret += c3[j];
-    }
+template<class = void>
+std::string
+base64_encode (std::string const& s)
+{
+    return base64_encode (reinterpret_cast <
+        std::uint8_t const*> (s.data()), s.size());
+}
 
-    return ret;
+template<class = void>
+std::string
+base64_decode(std::string const& data)
+{
+    std::string dest;
+    dest.resize(base64_decoded_size(data.size()));
+    auto const result = base64_decode(
+        &dest[0], data.data(), data.size());
+    dest.resize(result.first);
+    return dest;
 }
 
 } // detail
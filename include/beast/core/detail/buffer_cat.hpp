@@ -11,6 +11,7 @@
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
+#include <array>
 #include <cstdint>
 #include <iterator>
 #include <new>
@@ -470,6 +471,185 @@ buffer_cat_helper<Bn...>::end() const ->
     return const_iterator{bn_, true};
 }
 
+//------------------------------------------------------------------------------
+
+// The non-empty buffers of a concatenation in an array, or
+// the concatenation iterated lazily if they do not fit, so
+// that constructing the sequence never allocates.
+//
+template<std::size_t N, class... Bn>
+class flat_buffer_cat_helper
+{
+    using lazy_type = buffer_cat_helper<Bn...>;
+
+public:
+    using value_type = typename lazy_type::value_type;
+
+    class const_iterator;
+
+private:
+    lazy_type bs_;
+    std::array<value_type, N> a_;
+    // Number of buffers in a_, or N+1 if they did not fit
+    std::size_t n_ = 0;
+
+public:
+    flat_buffer_cat_helper(flat_buffer_cat_helper&&) = default;
+    flat_buffer_cat_helper(flat_buffer_cat_helper const&) = default;
+    flat_buffer_cat_helper& operator=(flat_buffer_cat_helper&&) = delete;
+    flat_buffer_cat_helper& operator=(flat_buffer_cat_helper const&) = delete;
+
+    explicit
+    flat_buffer_cat_helper(Bn const&... bn)
+        : bs_(bn...)
+    {
+        using boost::asio::buffer_size;
+        for(auto it = bs_.begin(); it != bs_.end(); ++it)
+        {
+            value_type const b = *it;
+            if(buffer_size(b) == 0)
+                continue;
+            if(n_ == N)
+            {
+                n_ = N + 1;
+                break;
+            }
+            a_[n_++] = b;
+        }
+    }
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    end() const;
+};
+
+template<std::size_t N, class... Bn>
+class flat_buffer_cat_helper<N, Bn...>::const_iterator
+{
+public:
+    using value_type = typename
+        flat_buffer_cat_helper<N, Bn...>::value_type;
+    using pointer = value_type const*;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+private:
+    using lazy_iterator =
+        typename buffer_cat_helper<Bn...>::const_iterator;
+
+    // Points into the array, or null if using the lazy iterator
+    value_type const* p_ = nullptr;
+    lazy_iterator it_;
+
+    friend class flat_buffer_cat_helper<N, Bn...>;
+
+    explicit
+    const_iterator(value_type const* p)
+        : p_(p)
+    {
+    }
+
+    explicit
+    const_iterator(lazy_iterator&& it)
+        : it_(std::move(it))
+    {
+    }
+
+public:
+    const_iterator() = default;
+    const_iterator(const_iterator&& other) = default;
+    const_iterator(const_iterator const& other) = default;
+    const_iterator& operator=(const_iterator&& other) = default;
+    const_iterator& operator=(const_iterator const& other) = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        if(p_ || other.p_)
+            return p_ == other.p_;
+        return it_ == other.it_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        if(p_)
+            return *p_;
+        return *it_;
+    }
+
+    pointer
+    operator->() const = delete;
+
+    const_iterator&
+    operator++()
+    {
+        if(p_)
+            ++p_;
+        else
+            ++it_;
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    const_iterator&
+    operator--()
+    {
+        if(p_)
+            --p_;
+        else
+            --it_;
+        return *this;
+    }
+
+    const_iterator
+    operator--(int)
+    {
+        auto temp = *this;
+        --(*this);
+        return temp;
+    }
+};
+
+template<std::size_t N, class... Bn>
+inline
+auto
+flat_buffer_cat_helper<N, Bn...>::begin() const ->
+    const_iterator
+{
+    if(n_ <= N)
+        return const_iterator{a_.data()};
+    return const_iterator{bs_.begin()};
+}
+
+template<std::size_t N, class... Bn>
+inline
+auto
+flat_buffer_cat_helper<N, Bn...>::end() const ->
+    const_iterator
+{
+    if(n_ <= N)
+        return const_iterator{a_.data() + n_};
+    return const_iterator{bs_.end()};
+}
+
 } // detail
 } // beast
 
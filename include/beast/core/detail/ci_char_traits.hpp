@@ -8,10 +8,11 @@
 #ifndef BEAST_DETAIL_CI_CHAR_TRAITS_HPP
 #define BEAST_DETAIL_CI_CHAR_TRAITS_HPP
 
-#include <boost/range/algorithm/equal.hpp>
 #include <boost/utility/string_ref.hpp>
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 
 namespace beast {
 namespace detail {
@@ -57,26 +58,81 @@ string_helper(T const& t)
     return t;
 }
 
+template<class S>
+inline
+boost::string_ref
+ci_string(S const& s)
+{
+    auto const& t = string_helper(s);
+    return boost::string_ref{t.data(), t.size()};
+}
+
+// Load up to 8 bytes into a word, zero filled
+inline
+std::uint64_t
+ci_load(char const* p, std::size_t n = 8)
+{
+    std::uint64_t w = 0;
+    std::memcpy(&w, p, n);
+    return w;
+}
+
+/*  Convert the ASCII upper case letters in each byte
+    of a word to lower case, leaving the others alone.
+
+    This gives the same result as `tolower` on every
+    byte, eight bytes at a time.
+*/
+inline
+std::uint64_t
+ci_fold(std::uint64_t w)
+{
+    std::uint64_t constexpr ones = 0x0101010101010101ULL;
+    std::uint64_t constexpr high = 0x8080808080808080ULL;
+    // Only the high bit of each byte can carry out
+    auto const h = w & ~high;
+    auto const ge_A = h + ones * (0x80 - 'A');
+    auto const gt_Z = h + ones * (0x7f - 'Z');
+    auto const upper = (ge_A ^ gt_Z) & ~w & high;
+    return w | (upper >> 2);
+}
+
+// Case-insensitive three way compare of n bytes
+inline
+int
+ci_compare(char const* p1, char const* p2, std::size_t n)
+{
+    for(; n >= 8; p1 += 8, p2 += 8, n -= 8)
+        if(ci_fold(ci_load(p1)) != ci_fold(ci_load(p2)))
+            break;
+    for(; n > 0; ++p1, ++p2, --n)
+    {
+        auto const c1 =
+            static_cast<std::uint8_t>(tolower(*p1));
+        auto const c2 =
+            static_cast<std::uint8_t>(tolower(*p2));
+        if(c1 != c2)
+            return c1 < c2 ? -1 : 1;
+    }
+    return 0;
+}
+
 // Case-insensitive less
 struct ci_less
 {
-    static bool const is_transparent = true;
+    using is_transparent = void;
 
     template<class S1, class S2>
     bool
     operator()(S1 const& lhs, S2 const& rhs) const noexcept
     {
-        using std::begin;
-        using std::end;
-        auto const s1 = string_helper(lhs);
-        auto const s2 = string_helper(rhs);
-        return std::lexicographical_compare(
-            begin(s1), end(s1), begin(s2), end(s2),
-            [](char lhs, char rhs)
-            {
-                return tolower(lhs) < tolower(rhs);
-            }
-        );
+        auto const s1 = ci_string(lhs);
+        auto const s2 = ci_string(rhs);
+        auto const n = (std::min)(s1.size(), s2.size());
+        auto const c = ci_compare(s1.data(), s2.data(), n);
+        if(c != 0)
+            return c < 0;
+        return s1.size() < s2.size();
     }
 };
 
@@ -95,11 +151,57 @@ template<class S1, class S2>
 bool
 ci_equal(S1 const& lhs, S2 const& rhs)
 {
-    return boost::range::equal(
-        string_helper(lhs), string_helper(rhs),
-            ci_equal_pred{});
+    auto const s1 = ci_string(lhs);
+    auto const s2 = ci_string(rhs);
+    if(s1.size() != s2.size())
+        return false;
+    auto p1 = s1.data();
+    auto p2 = s2.data();
+    auto n = s1.size();
+    for(; n >= 8; p1 += 8, p2 += 8, n -= 8)
+        if(ci_fold(ci_load(p1)) != ci_fold(ci_load(p2)))
+            return false;
+    return n == 0 || ci_fold(ci_load(p1, n)) ==
+        ci_fold(ci_load(p2, n));
 }
 
+/*  Case-insensitive hash
+
+    Strings which are equal according to @ref ci_equal
+    produce the same hash. This is suitable for use with
+    unordered containers keyed on field names.
+*/
+struct ci_hash
+{
+    using is_transparent = void;
+
+    template<class S>
+    std::size_t
+    operator()(S const& s) const noexcept
+    {
+        std::uint64_t constexpr k = 0x9e3779b97f4a7c15ULL;
+        auto const t = ci_string(s);
+        auto p = t.data();
+        auto n = t.size();
+        std::uint64_t h = n * k;
+        for(; n >= 8; p += 8, n -= 8)
+        {
+            h = (h ^ ci_fold(ci_load(p))) * k;
+            h ^= h >> 29;
+        }
+        if(n > 0)
+        {
+            h = (h ^ ci_fold(ci_load(p, n))) * k;
+            h ^= h >> 29;
+        }
+        // Mix the high bits into the low bits
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
 } // detail
 } // beast
 
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_CONSUMING_BUFFERS_HPP
+#define BEAST_DETAIL_CONSUMING_BUFFERS_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+
+namespace beast {
+namespace detail {
+
+/** A consumable sequence holding at most one buffer.
+
+    This provides the behavior of `consuming_buffers` for a
+    sequence of exactly one buffer, using pointer arithmetic
+    on the buffer in place of iterators into a copy of the
+    sequence.
+
+    @tparam ValueType The type of buffer, either
+    `boost::asio::const_buffer` or `boost::asio::mutable_buffer`.
+*/
+template<class ValueType>
+class consuming_buffer
+{
+    ValueType b_;
+    // One until the buffer is consumed
+    std::size_t n_ = 1;
+
+public:
+    /// The type for each element in the list of buffers.
+    using value_type = ValueType;
+
+    /// A bidirectional iterator type that may be used to read elements.
+    using const_iterator = value_type const*;
+
+    consuming_buffer(consuming_buffer const&) = default;
+    consuming_buffer& operator=(consuming_buffer const&) = default;
+
+    explicit
+    consuming_buffer(value_type const& b)
+        : b_(b)
+    {
+    }
+
+    /// Get a bidirectional iterator to the first element.
+    const_iterator
+    begin() const
+    {
+        return &b_;
+    }
+
+    /// Get a bidirectional iterator to one past the last element.
+    const_iterator
+    end() const
+    {
+        return &b_ + n_;
+    }
+
+    /** Remove bytes from the beginning of the sequence.
+
+        @param n The number of bytes to remove. If this is
+        larger than the number of bytes remaining, all the
+        bytes remaining are removed.
+    */
+    void
+    consume(std::size_t n)
+    {
+        using boost::asio::buffer_size;
+        if(n == 0 || n_ == 0)
+            return;
+        auto const len = buffer_size(b_);
+        if(n < len)
+        {
+            b_ = b_ + n;
+            return;
+        }
+        b_ = b_ + len;
+        n_ = 0;
+    }
+
+    // The remaining bytes, as a single buffer
+    value_type
+    get() const
+    {
+        return b_;
+    }
+};
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_CPU_INFO_HPP
+#define BEAST_DETAIL_CPU_INFO_HPP
+
+// Instruction set extensions are used through function
+// level target attributes, selected at run time, so that
+// no special compiler flags are needed. Define
+// BEAST_NO_INTRINSICS to use only portable code.
+#if ! defined(BEAST_NO_INTRINSICS) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define BEAST_X86_INTRINSICS 1
+#include <cpuid.h>
+#endif
+
+namespace beast {
+namespace detail {
+
+struct cpu_info
+{
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sha = false;
+
+    cpu_info();
+};
+
+inline
+cpu_info::
+cpu_info()
+{
+#if BEAST_X86_INTRINSICS
+    unsigned eax, ebx, ecx, edx;
+    if(! __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return;
+    ssse3 = (ecx & bit_SSSE3) != 0;
+    sse41 = (ecx & bit_SSE4_1) != 0;
+    if(__get_cpuid_max(0, nullptr) < 7)
+        return;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    sha = (ebx & (1u << 29)) != 0;
+#endif
+}
+
+/// Returns the instruction set extensions of the processor.
+inline
+cpu_info const&
+get_cpu_info()
+{
+    static cpu_info const ci;
+    return ci;
+}
+
+} // detail
+} // beast
+
+#endif
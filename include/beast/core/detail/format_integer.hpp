@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_FORMAT_INTEGER_HPP
+#define BEAST_DETAIL_FORMAT_INTEGER_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace beast {
+namespace detail {
+
+// The most characters needed to format an integer
+template<class Integer>
+struct max_digits : std::integral_constant<std::size_t,
+    // digits10 is one short, plus the sign
+    std::numeric_limits<Integer>::digits10 + 2>
+{
+};
+
+template<class = void>
+char const*
+get_digit_pairs()
+{
+    static char const s[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    return s;
+}
+
+// Format an unsigned integer into the
+// characters ending at `end`, returning
+// a pointer to the first character.
+template<class Unsigned>
+char*
+format_unsigned(char* end, Unsigned v)
+{
+    auto const d = get_digit_pairs();
+    while(v >= 100)
+    {
+        auto const i = static_cast<unsigned>(v % 100) * 2;
+        v /= 100;
+        *--end = d[i + 1];
+        *--end = d[i];
+    }
+    if(v >= 10)
+    {
+        auto const i = static_cast<unsigned>(v) * 2;
+        *--end = d[i + 1];
+        *--end = d[i];
+    }
+    else
+    {
+        *--end = static_cast<char>('0' + v);
+    }
+    return end;
+}
+
+template<class Integer>
+char*
+format_integer(char* end, Integer v, std::false_type)
+{
+    return format_unsigned(end, v);
+}
+
+template<class Integer>
+char*
+format_integer(char* end, Integer v, std::true_type)
+{
+    using U = typename std::make_unsigned<Integer>::type;
+    if(v >= 0)
+        return format_unsigned(end, static_cast<U>(v));
+    // negate in unsigned arithmetic so
+    // the lowest value does not overflow
+    auto const p = format_unsigned(
+        end, static_cast<U>(U{0} - static_cast<U>(v)));
+    *(p - 1) = '-';
+    return p - 1;
+}
+
+// Format an integer into the characters ending at
+// `end`, returning a pointer to the first character.
+template<class Integer>
+char*
+format_integer(char* end, Integer v)
+{
+    return format_integer(end, v,
+        std::is_signed<Integer>{});
+}
+
+} // detail
+} // beast
+
+#endif
@@ -8,10 +8,15 @@
 #ifndef BEAST_DETAIL_SHA1_HPP
 #define BEAST_DETAIL_SHA1_HPP
 
+#include <beast/core/detail/cpu_info.hpp>
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
 
+#if BEAST_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
 // Based on https://github.com/vog/sha1
 /*
     Original authors:
@@ -214,6 +219,107 @@ transform(
     digest[4] += e;
 }
 
+#if BEAST_X86_INTRINSICS
+
+// One group of four rounds using the SHA extensions. The
+// message schedule is kept in a ring of four registers,
+// and the E values alternate between two registers.
+//
+// Based on the Intel SHA Extensions reference code.
+//
+template<int G>
+__attribute__((target("sha,sse4.1,ssse3"), always_inline))
+inline
+void
+round4_ni(__m128i& abcd, __m128i (&e)[2],
+    __m128i (&msg)[4], std::uint8_t const* p)
+{
+    auto const mask = _mm_set_epi64x(
+        0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    if(G < 4)
+        msg[G%4] = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 16*G)), mask);
+    if(G == 0)
+        e[G%2] = _mm_add_epi32(e[G%2], msg[G%4]);
+    else
+        e[G%2] = _mm_sha1nexte_epu32(e[G%2], msg[G%4]);
+    e[1-G%2] = abcd;
+    if(G >= 3 && G <= 18)
+        msg[(G+1)%4] = _mm_sha1msg2_epu32(msg[(G+1)%4], msg[G%4]);
+    abcd = _mm_sha1rnds4_epu32(abcd, e[G%2], G/5);
+    if(G >= 1 && G <= 16)
+        msg[(G+3)%4] = _mm_sha1msg1_epu32(msg[(G+3)%4], msg[G%4]);
+    if(G >= 2 && G <= 17)
+        msg[(G+2)%4] = _mm_xor_si128(msg[(G+2)%4], msg[G%4]);
+}
+
+// Process whole blocks using the SHA extensions
+__attribute__((target("sha,sse4.1,ssse3")))
+inline
+void
+transform_ni(std::uint32_t digest[],
+    std::uint8_t const* p, std::size_t blocks)
+{
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(digest)), 0x1b);
+    __m128i e[2];
+    e[0] = _mm_set_epi32(static_cast<int>(digest[4]), 0, 0, 0);
+    __m128i msg[4];
+    for(; blocks > 0; --blocks, p += BLOCK_BYTES)
+    {
+        auto const abcd0 = abcd;
+        auto const e0 = e[0];
+        round4_ni< 0>(abcd, e, msg, p);
+        round4_ni< 1>(abcd, e, msg, p);
+        round4_ni< 2>(abcd, e, msg, p);
+        round4_ni< 3>(abcd, e, msg, p);
+        round4_ni< 4>(abcd, e, msg, p);
+        round4_ni< 5>(abcd, e, msg, p);
+        round4_ni< 6>(abcd, e, msg, p);
+        round4_ni< 7>(abcd, e, msg, p);
+        round4_ni< 8>(abcd, e, msg, p);
+        round4_ni< 9>(abcd, e, msg, p);
+        round4_ni<10>(abcd, e, msg, p);
+        round4_ni<11>(abcd, e, msg, p);
+        round4_ni<12>(abcd, e, msg, p);
+        round4_ni<13>(abcd, e, msg, p);
+        round4_ni<14>(abcd, e, msg, p);
+        round4_ni<15>(abcd, e, msg, p);
+        round4_ni<16>(abcd, e, msg, p);
+        round4_ni<17>(abcd, e, msg, p);
+        round4_ni<18>(abcd, e, msg, p);
+        round4_ni<19>(abcd, e, msg, p);
+        e[0] = _mm_sha1nexte_epu32(e[0], e0);
+        abcd = _mm_add_epi32(abcd, abcd0);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digest),
+        _mm_shuffle_epi32(abcd, 0x1b));
+    digest[4] = static_cast<std::uint32_t>(
+        _mm_extract_epi32(e[0], 3));
+}
+
+#endif
+
+// Process whole blocks, using the
+// SHA extensions when they are available.
+template<class = void>
+void
+process(std::uint32_t digest[],
+    std::uint8_t const* p, std::size_t blocks)
+{
+#if BEAST_X86_INTRINSICS
+    auto const& ci = get_cpu_info();
+    if(ci.sha && ci.sse41 && ci.ssse3)
+        return transform_ni(digest, p, blocks);
+#endif
+    std::uint32_t block[BLOCK_INTS];
+    for(; blocks > 0; --blocks, p += BLOCK_BYTES)
+    {
+        make_block(p, block);
+        transform(digest, block);
+    }
+}
+
 } // sha1
 
 struct sha1_context
@@ -247,7 +353,7 @@ update(sha1_context& ctx,
 {
     auto p = reinterpret_cast<
         std::uint8_t const*>(message);
-    for(;;)
+    if(ctx.buflen > 0)
     {
         auto const n = (std::min)(
             size, sizeof(ctx.buf) - ctx.buflen);
@@ -258,40 +364,47 @@ update(sha1_context& ctx,
         p += n;
         size -= n;
         ctx.buflen = 0;
-        std::uint32_t block[sha1::BLOCK_INTS];
-        sha1::make_block(ctx.buf, block);
-        sha1::transform(ctx.digest, block);
+        sha1::process(ctx.digest, ctx.buf, 1);
         ++ctx.blocks;
     }
+    // Whole blocks are processed without copying
+    auto const blocks = size / sha1::BLOCK_BYTES;
+    if(blocks > 0)
+    {
+        sha1::process(ctx.digest, p, blocks);
+        ctx.blocks += blocks;
+        p += blocks * sha1::BLOCK_BYTES;
+        size -= blocks * sha1::BLOCK_BYTES;
+    }
+    std::memcpy(ctx.buf, p, size);
+    ctx.buflen = size;
 }
 
 template<class = void>
 void
 finish(sha1_context& ctx, void* digest) noexcept
 {
-    using sha1::BLOCK_INTS;
     using sha1::BLOCK_BYTES;
 
     std::uint64_t total_bits =
         (ctx.blocks*64 + ctx.buflen) * 8;
     // pad
     ctx.buf[ctx.buflen++] = 0x80;
-    auto const buflen = ctx.buflen;
-    while(ctx.buflen < 64)
-        ctx.buf[ctx.buflen++] = 0x00;
-    std::uint32_t block[BLOCK_INTS];
-    sha1::make_block(ctx.buf, block);
-    if(buflen > BLOCK_BYTES - 8)
+    if(ctx.buflen > BLOCK_BYTES - 8)
     {
-        sha1::transform(ctx.digest, block);
-        for(size_t i = 0; i < BLOCK_INTS - 2; i++)
-            block[i] = 0;
+        std::memset(ctx.buf + ctx.buflen, 0,
+            BLOCK_BYTES - ctx.buflen);
+        sha1::process(ctx.digest, ctx.buf, 1);
+        ctx.buflen = 0;
     }
+    std::memset(ctx.buf + ctx.buflen, 0,
+        BLOCK_BYTES - 8 - ctx.buflen);
 
-    /* Append total_bits, split this uint64_t into two uint32_t */
-    block[BLOCK_INTS - 1] = total_bits & 0xffffffff;
-    block[BLOCK_INTS - 2] = (total_bits >> 32);
-    sha1::transform(ctx.digest, block);
+    // Append total_bits, big-endian
+    for(std::size_t i = 0; i < 8; ++i)
+        ctx.buf[BLOCK_BYTES - 1 - i] =
+            static_cast<std::uint8_t>(total_bits >> (8 * i));
+    sha1::process(ctx.digest, ctx.buf, 1);
     for(std::size_t i = 0; i < sha1::DIGEST_BYTES/4; i++)
     {
         std::uint8_t* d =
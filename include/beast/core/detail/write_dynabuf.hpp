@@ -9,8 +9,11 @@
 #define BEAST_DETAIL_WRITE_DYNABUF_HPP
 
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/detail/format_integer.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <type_traits>
 #include <utility>
 
 namespace beast {
@@ -42,6 +45,22 @@ public:
         ! is_string_literal<T>::value;
 };
 
+// `true` for integers which are formatted as numbers.
+// Character types are excluded, lexical_cast writes
+// those as characters.
+template<class T>
+struct is_formattable_integer : std::integral_constant<bool,
+    std::is_integral<T>::value &&
+    ! std::is_same<T, bool>::value &&
+    ! std::is_same<T, char>::value &&
+    ! std::is_same<T, signed char>::value &&
+    ! std::is_same<T, unsigned char>::value &&
+    ! std::is_same<T, wchar_t>::value &&
+    ! std::is_same<T, char16_t>::value &&
+    ! std::is_same<T, char32_t>::value>
+{
+};
+
 template<class DynamicBuffer>
 void
 write_dynabuf(DynamicBuffer& dynabuf,
@@ -108,8 +127,43 @@ write_dynabuf(DynamicBuffer& dynabuf, const char (&s)[N])
             boost::asio::buffer(s, N - 1)));
 }
 
+// Integers are formatted on the stack,
+// without allocating a temporary string.
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    is_formattable_integer<T>::value>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer;
+    using boost::asio::buffer_copy;
+    char buf[max_digits<T>::value];
+    auto const end = buf + sizeof(buf);
+    auto const p = format_integer(end, t);
+    auto const n = static_cast<std::size_t>(end - p);
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(n), buffer(p, n)));
+}
+
+// Strings which are not buffers, such as string_ref and
+// static_string, are copied without a temporary string.
+template<class DynamicBuffer, class T>
+typename std::enable_if<
+    std::is_convertible<T, boost::string_ref>::value &&
+    ! is_string_literal<T>::value &&
+    ! is_BufferConvertible<T>::value>::type
+write_dynabuf(DynamicBuffer& dynabuf, T const& t)
+{
+    using boost::asio::buffer;
+    using boost::asio::buffer_copy;
+    boost::string_ref const s = t;
+    dynabuf.commit(buffer_copy(
+        dynabuf.prepare(s.size()), buffer(s.data(), s.size())));
+}
+
 template<class DynamicBuffer, class T>
 typename std::enable_if<
+    ! is_formattable_integer<T>::value &&
+    ! std::is_convertible<T, boost::string_ref>::value &&
     ! is_string_literal<T>::value &&
     ! is_ConstBufferSequence<T>::value &&
     ! is_BufferConvertible<T>::value &&
@@ -9,8 +9,10 @@
 #define BEAST_DYNABUF_READSTREAM_HPP
 
 #include <beast/core/async_completion.hpp>
+#include <beast/core/block_pool.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/error.hpp>
+#include <beast/core/read_size.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/streambuf.hpp>
 #include <beast/core/detail/get_lowest_layer.hpp>
@@ -97,6 +99,9 @@ class dynabuf_readstream
 
     DynamicBuffer sb_;
     std::size_t capacity_ = 0;
+    read_size_policy rs_;
+    bool adaptive_ = false;
+    bool wait_ = false;
     Stream next_layer_;
 
 public:
@@ -138,6 +143,19 @@ public:
     explicit
     dynabuf_readstream(Args&&... args);
 
+    /** Construct the wrapping stream with a buffer.
+
+        This allows the use of a buffer which cannot be default
+        constructed, such as one with a @ref pool_allocator.
+
+        @param buffer The buffer to use, which is moved into
+        the object.
+
+        @param args Parameters forwarded to the `Stream` constructor.
+    */
+    template<class... Args>
+    dynabuf_readstream(DynamicBuffer&& buffer, Args&&... args);
+
     /// Get a reference to the next layer.
     next_layer_type&
     next_layer()
@@ -211,6 +229,98 @@ public:
     capacity(std::size_t size)
     {
         capacity_ = size;
+        adaptive_ = false;
+    }
+
+    /** Size buffered reads using a policy.
+
+        When a policy is set, the number of bytes read into the
+        internal buffer each time it is empty is chosen by the
+        policy instead of the fixed maximum set with @ref capacity.
+        A later call to @ref capacity removes the policy.
+
+        Thread safety:
+            The caller is responsible for making sure the call is
+            made from the same implicit or explicit strand.
+
+        @param policy The policy to use. A copy is made.
+    */
+    void
+    read_size(read_size_policy const& policy)
+    {
+        rs_ = policy;
+        adaptive_ = true;
+    }
+
+    /** Return the read size policy.
+
+        The counters in the returned policy reflect the reads made
+        into the internal buffer since the policy was set.
+    */
+    read_size_policy const&
+    read_size() const
+    {
+        return rs_;
+    }
+
+    /** Wait for data before allocating the internal buffer.
+
+        Normally a buffered asynchronous read prepares space in the
+        internal buffer and then waits for data to arrive, so that
+        every idle connection with a pending read holds a buffer.
+        When this mode is enabled, a buffered asynchronous read
+        first waits until the next layer is readable, using
+        `null_buffers`, and prepares the buffer only when data is
+        ready. After the buffered bytes have all been consumed, the
+        memory is released again. Connections then hold buffer
+        memory only while they have data to read, at the cost of
+        an extra operation and an allocation per read.
+
+        The next layer must support reads with `null_buffers`, as
+        `boost::asio::ip::tcp::socket` does. Memory is released if
+        the @b DynamicBuffer provides a member function
+        `shrink_to_fit`. With a @ref pooled_readstream the memory
+        is borrowed from a pool shared by many connections, and
+        returned to it.
+
+        Thread safety:
+            The caller is responsible for making sure the call is
+            made from the same implicit or explicit strand.
+
+        @param value `true` to wait for data before preparing
+        the buffer.
+    */
+    void
+    wait_readable(bool value)
+    {
+        wait_ = value;
+    }
+
+    /// Return `true` if reads wait for data before preparing the buffer.
+    bool
+    wait_readable() const
+    {
+        return wait_;
+    }
+
+    /** Release the memory held by the internal buffer.
+
+        Bytes already read into the buffer are kept, while all
+        other memory is returned to the buffer's allocator. This
+        may be called on a connection which is expected to stay
+        idle, so that its memory grows with the number of active
+        connections rather than open ones. The buffer is allocated
+        again by the next buffered read.
+
+        This function must not be called while a read operation
+        is pending. The @b DynamicBuffer must provide a member
+        function `shrink_to_fit`, as @ref basic_streambuf and
+        @ref basic_flat_streambuf do.
+    */
+    void
+    shrink_to_fit()
+    {
+        sb_.shrink_to_fit();
     }
 
     /// Write the given data to the stream. Returns the number of bytes written.
@@ -272,6 +382,28 @@ public:
         ReadHandler&& handler);
 };
 
+/** A @ref dynabuf_readstream whose buffer uses a @ref block_pool.
+
+    With @ref dynabuf_readstream::wait_readable enabled, each
+    connection borrows blocks from the pool only while it has
+    data to read, and gives them back once the buffered bytes
+    are consumed. The memory for reading is then shared by the
+    connections, and grows with the number which are active
+    rather than the number which are open.
+
+    @par Example
+    @code
+        block_pool pool;
+        pooled_readstream<boost::asio::ip::tcp::socket> stream{
+            basic_streambuf<pool_allocator<char>>{
+                4096, pool_allocator<char>{pool}}, ios};
+        stream.wait_readable(true);
+    @endcode
+*/
+template<class Stream>
+using pooled_readstream = dynabuf_readstream<
+    Stream, basic_streambuf<pool_allocator<char>>>;
+
 } // beast
 
 #include <beast/core/impl/dynabuf_readstream.ipp>
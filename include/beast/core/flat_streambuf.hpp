@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_FLAT_STREAMBUF_HPP
+#define BEAST_FLAT_STREAMBUF_HPP
+
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` using a single contiguous allocation.
+
+    The input sequence is always represented by exactly one buffer,
+    and so is the output sequence returned by `prepare`. This allows
+    algorithms that scan the input to operate on a single range of
+    memory without handling buffer boundaries.
+
+    When `prepare` is called and there is not enough space after
+    the input sequence, the input is first moved to the beginning
+    of the storage if that produces enough room. Otherwise the
+    storage grows geometrically, up to the limit set at
+    construction. The input sequence is never moved more than a
+    constant number of times per byte, on average.
+
+    @note Unlike @ref basic_streambuf, buffers representing the
+    input sequence are invalidated by calls to `prepare`.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_flat_streambuf
+#if ! GENERATING_DOCS
+    : private detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>;
+#endif
+
+private:
+    template<class OtherAlloc>
+    friend class basic_flat_streambuf;
+
+    using alloc_traits =
+        std::allocator_traits<allocator_type>;
+
+    static
+    inline
+    std::size_t
+    dist(std::uint8_t const* first, std::uint8_t const* last)
+    {
+        return static_cast<std::size_t>(last - first);
+    }
+
+    std::uint8_t* begin_;
+    std::uint8_t* in_;
+    std::uint8_t* out_;
+    std::uint8_t* last_;
+    std::uint8_t* end_;
+    std::size_t max_;
+
+public:
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = boost::asio::const_buffers_1;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = boost::asio::mutable_buffers_1;
+
+    /// Destructor.
+    ~basic_flat_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf(basic_flat_streambuf&&);
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+
+        @param alloc The allocator to associate with the
+        stream buffer.
+    */
+    basic_flat_streambuf(basic_flat_streambuf&&,
+        Allocator const& alloc);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf(basic_flat_streambuf const&);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+
+        @param alloc The allocator to associate with the
+        stream buffer.
+    */
+    basic_flat_streambuf(basic_flat_streambuf const&,
+        Allocator const& alloc);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    template<class OtherAlloc>
+    basic_flat_streambuf(
+        basic_flat_streambuf<OtherAlloc> const&);
+
+    /** Move assignment.
+
+        This object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf&&);
+
+    /** Copy assignment.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf const&);
+
+    /** Construct a flat stream buffer.
+
+        No memory is allocated until the first call to `prepare`.
+
+        @param limit The largest number of bytes which may be held
+        in the input and output sequences together. Calls to
+        `prepare` which would exceed this limit throw.
+
+        @param alloc The allocator to use. If this parameter is
+        unspecified, a default constructed allocator will be used.
+    */
+    explicit
+    basic_flat_streambuf(std::size_t limit =
+        (std::numeric_limits<std::size_t>::max)(),
+            Allocator const& alloc = Allocator{});
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return dist(in_, out_);
+    }
+
+    /// Return the maximum sum of the input and output sequence sizes.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Return the maximum sum of input and output sizes that can be held without an allocation.
+    std::size_t
+    capacity() const
+    {
+        return dist(in_, end_);
+    }
+
+    /// Get a list of buffers that represent the input sequence.
+    const_buffers_type
+    data() const
+    {
+        return {in_, dist(in_, out_)};
+    }
+
+    /** Get a list of buffers that represent the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+
+        @note All previous buffers sequences obtained from
+        calls to @ref data or @ref prepare are invalidated.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /** Move bytes from the output sequence to the input sequence.
+
+        @note Buffers representing the input sequence acquired prior to
+        this call remain valid.
+    */
+    void
+    commit(std::size_t n)
+    {
+        out_ += (std::min)(n, dist(out_, last_));
+    }
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    /** Reallocate the storage to exactly fit the input sequence.
+
+        This releases the memory held by an idle stream buffer.
+    */
+    void
+    shrink_to_fit();
+
+    // Helper for boost::asio::read_until
+    template<class OtherAlloc>
+    friend
+    std::size_t
+    read_size_helper(basic_flat_streambuf<
+        OtherAlloc> const&, std::size_t);
+
+private:
+    void
+    move_from(basic_flat_streambuf& other);
+
+    template<class OtherAlloc>
+    void
+    copy_from(basic_flat_streambuf<OtherAlloc> const& other);
+
+    void
+    move_assign(basic_flat_streambuf&, std::false_type);
+
+    void
+    move_assign(basic_flat_streambuf&, std::true_type);
+
+    void
+    copy_assign(basic_flat_streambuf const&, std::false_type);
+
+    void
+    copy_assign(basic_flat_streambuf const&, std::true_type);
+};
+
+/// A flat stream buffer using the default allocator.
+using flat_streambuf =
+    basic_flat_streambuf<std::allocator<char>>;
+
+} // beast
+
+#include <beast/core/impl/flat_streambuf.ipp>
+
+#endif
@@ -404,6 +404,7 @@ basic_streambuf(basic_streambuf&& other)
     : detail::empty_base_optimization<allocator_type>(
         std::move(other.member()))
     , alloc_size_(other.alloc_size_)
+    , list_size_(other.list_size_)
     , in_size_(other.in_size_)
     , in_pos_(other.in_pos_)
     , out_pos_(other.out_pos_)
@@ -413,6 +414,7 @@ basic_streambuf(basic_streambuf&& other)
         other.out_ == other.list_.end();
     list_ = std::move(other.list_);
     out_ = at_end ? list_.end() : other.out_;
+    other.list_size_ = 0;
     other.in_size_ = 0;
     other.out_ = other.list_.end();
     other.in_pos_ = 0;
@@ -528,19 +530,6 @@ basic_streambuf<Allocator>::basic_streambuf(
             "basic_streambuf: invalid alloc_size");
 }
 
-template<class Allocator>
-std::size_t
-basic_streambuf<Allocator>::capacity() const
-{
-    auto pos = out_;
-    if(pos == list_.end())
-        return in_size_;
-    auto n = pos->size() - out_pos_;
-    while(++pos != list_.end())
-        n += pos->size();
-    return in_size_ + n;
-}
-
 template<class Allocator>
 auto
 basic_streambuf<Allocator>::
@@ -563,6 +552,8 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
             out_end_ = out_->size();
             reuse.splice(reuse.end(), list_,
                 std::next(out_), list_.end());
+            for(auto const& e : reuse)
+                list_size_ -= e.size();
             debug_check();
         }
         auto const avail = out_->size() - out_pos_;
@@ -583,6 +574,7 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
         auto& e = reuse.front();
         reuse.erase(reuse.iterator_to(e));
         list_.push_back(e);
+        list_size_ += e.size();
         if(n > e.size())
         {
             out_end_ = e.size();
@@ -603,6 +595,7 @@ basic_streambuf<Allocator>::prepare(size_type n) ->
                 sizeof(element) + size));
         alloc_traits::construct(this->member(), &e, size);
         list_.push_back(e);
+        list_size_ += e.size();
         if(out_ == list_.end())
             out_ = list_.iterator_to(e);
         if(n >= e.size())
@@ -693,6 +686,7 @@ basic_streambuf<Allocator>::consume(size_type n)
             in_pos_ = 0;
             auto& e = list_.front();
             list_.erase(list_.iterator_to(e));
+            list_size_ -= e.size();
             auto const len = e.size() + sizeof(e);
             alloc_traits::destroy(this->member(), &e);
             alloc_traits::deallocate(this->member(),
@@ -730,6 +724,33 @@ basic_streambuf<Allocator>::consume(size_type n)
     }
 }
 
+template<class Allocator>
+void
+basic_streambuf<Allocator>::
+shrink_to_fit()
+{
+    if(in_size_ == 0)
+    {
+        clear();
+        return;
+    }
+    if(list_size_ - in_pos_ == in_size_)
+        return;
+    // Move the input sequence to one element of exactly its size
+    auto& e = *reinterpret_cast<element*>(
+        alloc_traits::allocate(this->member(),
+            sizeof(element) + in_size_));
+    alloc_traits::construct(this->member(), &e, in_size_);
+    boost::asio::buffer_copy(
+        boost::asio::buffer(e.data(), in_size_), data());
+    auto const size = in_size_;
+    clear();
+    list_.push_back(e);
+    list_size_ = size;
+    in_size_ = size;
+    debug_check();
+}
+
 template<class Allocator>
 void
 basic_streambuf<Allocator>::
@@ -738,6 +759,7 @@ clear()
     delete_list();
     list_.clear();
     out_ = list_.begin();
+    list_size_ = 0;
     in_size_ = 0;
     in_pos_ = 0;
     out_pos_ = 0;
@@ -770,11 +792,13 @@ move_assign(basic_streambuf& other, std::true_type)
     list_ = std::move(other.list_);
     out_ = at_end ? list_.end() : other.out_;
 
+    list_size_ = other.list_size_;
     in_size_ = other.in_size_;
     in_pos_ = other.in_pos_;
     out_pos_ = other.out_pos_;
     out_end_ = other.out_end_;
 
+    other.list_size_ = 0;
     other.in_size_ = 0;
     other.out_ = other.list_.end();
     other.in_pos_ = 0;
@@ -819,6 +843,12 @@ basic_streambuf<Allocator>::debug_check() const
 #ifndef NDEBUG
     using boost::asio::buffer_size;
     BOOST_ASSERT(buffer_size(data()) == in_size_);
+    {
+        size_type n = 0;
+        for(auto const& e : list_)
+            n += e.size();
+        BOOST_ASSERT(n == list_size_);
+    }
     if(list_.empty())
     {
         BOOST_ASSERT(in_pos_ == 0);
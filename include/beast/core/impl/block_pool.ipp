@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_BLOCK_POOL_IPP
+#define BEAST_IMPL_BLOCK_POOL_IPP
+
+#include <boost/assert.hpp>
+#include <new>
+
+namespace beast {
+
+inline
+block_pool::
+block_pool(std::size_t max_idle)
+    : block_pool({4096, 16384, 65536}, max_idle)
+{
+}
+
+inline
+block_pool::
+block_pool(std::initializer_list<std::size_t> sizes,
+        std::size_t max_idle)
+    : buckets_(new bucket[sizes.size()])
+    , n_(sizes.size())
+    , max_idle_(max_idle)
+    , idle_(0)
+    , oversize_(0)
+    , oversize_used_(0)
+{
+    auto b = buckets_.get();
+    for(auto size : sizes)
+    {
+        BOOST_ASSERT(b == buckets_.get() || size > b[-1].size);
+        b->size = size;
+        ++b;
+    }
+}
+
+inline
+block_pool::
+~block_pool()
+{
+    shrink_to_fit();
+}
+
+inline
+auto
+block_pool::
+find(std::size_t size) const ->
+    bucket*
+{
+    for(std::size_t i = 0; i < n_; ++i)
+        if(size <= buckets_[i].size + headroom)
+            return &buckets_[i];
+    return nullptr;
+}
+
+inline
+void*
+block_pool::
+allocate(std::size_t size)
+{
+    auto const b = find(size);
+    if(! b)
+    {
+        auto const p = ::operator new(size);
+        ++oversize_;
+        oversize_used_ += size;
+        return p;
+    }
+    auto const n = b->size + headroom;
+    {
+        std::lock_guard<std::mutex> lock(b->m);
+        if(b->free)
+        {
+            auto const p = b->free;
+            b->free = p->next;
+            ++b->stats.hits;
+            b->stats.idle -= n;
+            b->stats.used += n;
+            idle_ -= n;
+            return p;
+        }
+        ++b->stats.misses;
+        b->stats.used += n;
+    }
+    try
+    {
+        return ::operator new(n);
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(b->m);
+        b->stats.used -= n;
+        throw;
+    }
+}
+
+inline
+void
+block_pool::
+deallocate(void* p, std::size_t size) noexcept
+{
+    auto const b = find(size);
+    if(! b)
+    {
+        oversize_used_ -= size;
+        ::operator delete(p);
+        return;
+    }
+    auto const n = b->size + headroom;
+    {
+        std::lock_guard<std::mutex> lock(b->m);
+        b->stats.used -= n;
+        if(idle_ + n <= max_idle_)
+        {
+            auto const e = static_cast<node*>(p);
+            e->next = b->free;
+            b->free = e;
+            b->stats.idle += n;
+            idle_ += n;
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+inline
+void
+block_pool::
+shrink_to_fit()
+{
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto& b = buckets_[i];
+        node* list;
+        {
+            std::lock_guard<std::mutex> lock(b.m);
+            list = b.free;
+            b.free = nullptr;
+            idle_ -= b.stats.idle;
+            b.stats.idle = 0;
+        }
+        while(list)
+        {
+            auto const next = list->next;
+            ::operator delete(list);
+            list = next;
+        }
+    }
+}
+
+inline
+auto
+block_pool::
+stats() const ->
+    stats_type
+{
+    stats_type result;
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto const s = stats(i);
+        result.hits += s.hits;
+        result.misses += s.misses;
+        result.idle += s.idle;
+        result.used += s.used;
+    }
+    result.oversize = oversize_;
+    result.used += oversize_used_;
+    return result;
+}
+
+inline
+auto
+block_pool::
+stats(std::size_t i) const ->
+    stats_type
+{
+    auto const& b = buckets_[i];
+    std::lock_guard<std::mutex> lock(b.m);
+    return b.stats;
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+#define BEAST_IMPL_CIRCULAR_STREAMBUF_IPP
+
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace beast {
+
+// A sequence of one or two buffers
+template<class Allocator>
+template<class Buffer>
+class basic_circular_streambuf<Allocator>::buffers_type
+{
+    Buffer b_[2];
+    std::size_t n_;
+
+public:
+    using value_type = Buffer;
+
+    using const_iterator = Buffer const*;
+
+    buffers_type() = delete;
+    buffers_type(buffers_type const&) = default;
+    buffers_type& operator=(buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return &b_[0];
+    }
+
+    const_iterator
+    end() const
+    {
+        return &b_[n_];
+    }
+
+private:
+    friend class basic_circular_streambuf;
+
+    template<class Pointer>
+    buffers_type(Pointer p, std::size_t cap,
+            std::size_t pos, std::size_t size)
+        : n_(0)
+    {
+        if(size == 0)
+            return;
+        if(pos + size <= cap)
+        {
+            b_[n_++] = Buffer{p + pos, size};
+            return;
+        }
+        b_[n_++] = Buffer{p + pos, cap - pos};
+        b_[n_++] = Buffer{p, size - (cap - pos)};
+    }
+};
+
+template<class Allocator>
+basic_circular_streambuf<Allocator>::
+~basic_circular_streambuf()
+{
+    if(p_)
+        alloc_traits::deallocate(
+            this->member(), p_, cap_);
+}
+
+template<class Allocator>
+basic_circular_streambuf<Allocator>::
+basic_circular_streambuf(basic_circular_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+    , p_(other.p_)
+    , cap_(other.cap_)
+    , in_pos_(other.in_pos_)
+    , in_size_(other.in_size_)
+    , out_size_(other.out_size_)
+{
+    other.p_ = nullptr;
+    other.cap_ = 0;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+}
+
+template<class Allocator>
+basic_circular_streambuf<Allocator>::
+basic_circular_streambuf(std::size_t capacity,
+        Allocator const& alloc)
+    : detail::empty_base_optimization<
+        allocator_type>(alloc)
+    , p_(capacity > 0 ? alloc_traits::allocate(
+        this->member(), capacity) : nullptr)
+    , cap_(capacity)
+{
+}
+
+template<class Allocator>
+auto
+basic_circular_streambuf<Allocator>::
+data() const ->
+    const_buffers_type
+{
+    return const_buffers_type{
+        static_cast<std::uint8_t const*>(p_),
+            cap_, in_pos_, in_size_};
+}
+
+template<class Allocator>
+auto
+basic_circular_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n > cap_ - in_size_)
+        throw std::length_error{
+            "circular_streambuf overflow"};
+    out_size_ = n;
+    auto pos = in_pos_ + in_size_;
+    if(pos >= cap_)
+        pos -= cap_;
+    return mutable_buffers_type{
+        p_, cap_, pos, out_size_};
+}
+
+template<class Allocator>
+void
+basic_circular_streambuf<Allocator>::
+commit(std::size_t n)
+{
+    in_size_ += (std::min)(n, out_size_);
+    out_size_ = 0;
+}
+
+template<class Allocator>
+void
+basic_circular_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n >= in_size_ && out_size_ == 0)
+    {
+        // rewind so the next input is not
+        // split across the end of the ring
+        in_pos_ = 0;
+        in_size_ = 0;
+        return;
+    }
+    n = (std::min)(n, in_size_);
+    in_pos_ += n;
+    if(in_pos_ >= cap_)
+        in_pos_ -= cap_;
+    in_size_ -= n;
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_circular_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    BOOST_ASSERT(max_size >= 1);
+    auto const avail =
+        streambuf.capacity() - streambuf.size();
+    if(avail == 0)
+        // prepare will throw
+        return 1;
+    return (std::min)(avail, max_size);
+}
+
+} // beast
+
+#endif
@@ -12,9 +12,41 @@
 #include <beast/core/error.hpp>
 #include <beast/core/handler_concepts.hpp>
 #include <beast/core/handler_alloc.hpp>
+#include <beast/core/detail/type_traits.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace beast {
 
+namespace detail {
+
+template<class T, class = void>
+struct has_shrink_to_fit : std::false_type
+{
+};
+
+template<class T>
+struct has_shrink_to_fit<T, void_t<decltype(
+        std::declval<T&>().shrink_to_fit())>>
+    : std::true_type
+{
+};
+
+template<class DynamicBuffer>
+void
+shrink_to_fit(DynamicBuffer& db, std::true_type)
+{
+    db.shrink_to_fit();
+}
+
+template<class DynamicBuffer>
+void
+shrink_to_fit(DynamicBuffer&, std::false_type)
+{
+}
+
+} // detail
+
 template<class Stream, class DynamicBuffer>
 template<class MutableBufferSequence, class Handler>
 class dynabuf_readstream<
@@ -28,6 +60,7 @@ class dynabuf_readstream<
         dynabuf_readstream& srs;
         MutableBufferSequence bs;
         Handler h;
+        std::size_t size = 0;
         int state = 0;
 
         template<class DeducedHandler>
@@ -108,11 +141,11 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
         case 0:
             if(d.srs.sb_.size() == 0)
             {
-                d.state =
-                    d.srs.capacity_ > 0 ? 2 : 1;
+                d.state = (d.srs.capacity_ > 0 ||
+                    d.srs.adaptive_) ? 2 : 1;
                 break;
             }
-            d.state = 4;
+            d.state = 5;
             d.srs.get_io_service().post(
                 bind_handler(std::move(*this), ec, 0));
             return;
@@ -125,25 +158,45 @@ read_some_op<MutableBufferSequence, Handler>::operator()(
             return;
 
         case 2:
+            if(d.srs.wait_)
+            {
+                // wait until readable
+                d.state = 3;
+                d.srs.next_layer_.async_read_some(
+                    boost::asio::null_buffers{},
+                        std::move(*this));
+                return;
+            }
+            // fall through
+
+        case 3:
             // read
-            d.state = 3;
+            d.state = 4;
+            d.size = d.srs.adaptive_ ?
+                d.srs.rs_.read_size(d.srs.next_layer_) :
+                    d.srs.capacity_;
             d.srs.next_layer_.async_read_some(
-                d.srs.sb_.prepare(d.srs.capacity_),
-                    std::move(*this));
+                d.srs.sb_.prepare(d.size), std::move(*this));
             return;
 
         // got data
-        case 3:
-            d.state = 4;
+        case 4:
+            d.state = 5;
+            if(d.srs.adaptive_)
+                d.srs.rs_.on_read(d.size, bytes_transferred);
             d.srs.sb_.commit(bytes_transferred);
             break;
 
         // copy
-        case 4:
+        case 5:
             bytes_transferred =
                 boost::asio::buffer_copy(
                     d.bs, d.srs.sb_.data());
             d.srs.sb_.consume(bytes_transferred);
+            if(d.srs.wait_ && d.srs.sb_.size() == 0)
+                // give the memory back while idle
+                detail::shrink_to_fit(d.srs.sb_, typename
+                    detail::has_shrink_to_fit<DynamicBuffer>::type{});
             // call handler
             d.state = 99;
             break;
@@ -162,6 +215,15 @@ dynabuf_readstream(Args&&... args)
 {
 }
 
+template<class Stream, class DynamicBuffer>
+template<class... Args>
+dynabuf_readstream<Stream, DynamicBuffer>::
+dynabuf_readstream(DynamicBuffer&& buffer, Args&&... args)
+    : sb_(std::move(buffer))
+    , next_layer_(std::forward<Args>(args)...)
+{
+}
+
 template<class Stream, class DynamicBuffer>
 template<class ConstBufferSequence, class WriteHandler>
 auto
@@ -218,16 +280,24 @@ read_some(MutableBufferSequence const& buffers,
     using boost::asio::buffer_copy;
     if(sb_.size() == 0)
     {
-        if(capacity_ == 0)
+        if(capacity_ == 0 && ! adaptive_)
             return next_layer_.read_some(buffers, ec);
-        sb_.commit(next_layer_.read_some(
-            sb_.prepare(capacity_), ec));
+        auto const size = adaptive_ ?
+            rs_.read_size(next_layer_) : capacity_;
+        auto const n = next_layer_.read_some(
+            sb_.prepare(size), ec);
+        if(adaptive_)
+            rs_.on_read(size, n);
+        sb_.commit(n);
         if(ec)
             return 0;
     }
     auto bytes_transferred =
         buffer_copy(buffers, sb_.data());
     sb_.consume(bytes_transferred);
+    if(wait_ && sb_.size() == 0)
+        detail::shrink_to_fit(sb_, typename
+            detail::has_shrink_to_fit<DynamicBuffer>::type{});
     return bytes_transferred;
 }
 
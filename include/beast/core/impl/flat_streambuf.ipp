@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_FLAT_STREAMBUF_IPP
+#define BEAST_IMPL_FLAT_STREAMBUF_IPP
+
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace beast {
+
+/*  Memory is laid out thus:
+
+      begin_ --> in_ --> out_ --> last_ --> end_
+
+    The input sequence is [in_, out_) and the output
+    sequence is [out_, last_). All pointers are null
+    when no storage is allocated.
+*/
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+~basic_flat_streambuf()
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, dist(begin_, end_));
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(std::size_t limit,
+        Allocator const& alloc)
+    : detail::empty_base_optimization<
+        allocator_type>(alloc)
+    , begin_(nullptr)
+    , in_(nullptr)
+    , out_(nullptr)
+    , last_(nullptr)
+    , end_(nullptr)
+    , max_(limit)
+{
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+{
+    move_from(other);
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other,
+        Allocator const& alloc)
+    : basic_flat_streambuf(other.max_, alloc)
+{
+    if(this->member() != other.member())
+    {
+        copy_from(other);
+        other.consume(other.size());
+        other.shrink_to_fit();
+    }
+    else
+    {
+        move_from(other);
+    }
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other)
+    : basic_flat_streambuf(other.max_,
+        alloc_traits::select_on_container_copy_construction(
+            other.member()))
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other,
+        Allocator const& alloc)
+    : basic_flat_streambuf(other.max_, alloc)
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(
+        basic_flat_streambuf<OtherAlloc> const& other)
+    : basic_flat_streambuf(other.max_)
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf&& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    move_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_move_assignment::value>{});
+    return *this;
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf const& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    copy_assign(other, std::integral_constant<bool,
+        alloc_traits::propagate_on_container_copy_assignment::value>{});
+    return *this;
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n <= dist(out_, end_))
+    {
+        // existing capacity is sufficient
+        last_ = out_ + n;
+        return{out_, n};
+    }
+    auto const len = size();
+    if(n > max_ - len)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n <= dist(begin_, end_) - len)
+    {
+        // after a memmove,
+        // existing capacity is sufficient
+        if(len > 0)
+            std::memmove(begin_, in_, len);
+        in_ = begin_;
+        out_ = in_ + len;
+        last_ = out_ + n;
+        return {out_, n};
+    }
+    // allocate a new buffer, growing
+    // geometrically to amortize the copies
+    auto const cap = dist(begin_, end_);
+    auto new_size = (std::max)(len + n,
+        cap < max_ / 2 ? 2 * cap : max_);
+    new_size = (std::max)(new_size,
+        (std::min)(max_, std::size_t{512}));
+    auto const p = alloc_traits::allocate(
+        this->member(), new_size);
+    if(begin_)
+    {
+        if(len > 0)
+            std::memcpy(p, in_, len);
+        alloc_traits::deallocate(
+            this->member(), begin_, cap);
+    }
+    begin_ = p;
+    in_ = begin_;
+    out_ = in_ + len;
+    last_ = out_ + n;
+    end_ = begin_ + new_size;
+    return {out_, n};
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n >= dist(in_, out_))
+    {
+        in_ = out_;
+        // rewind so the next prepare can
+        // use the whole buffer without a move
+        if(out_ == last_)
+        {
+            in_ = begin_;
+            out_ = begin_;
+            last_ = begin_;
+        }
+        return;
+    }
+    in_ += n;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+shrink_to_fit()
+{
+    auto const len = size();
+    if(len == dist(begin_, end_))
+        return;
+    std::uint8_t* p = nullptr;
+    if(len > 0)
+    {
+        p = alloc_traits::allocate(
+            this->member(), len);
+        std::memcpy(p, in_, len);
+    }
+    alloc_traits::deallocate(
+        this->member(), begin_, dist(begin_, end_));
+    begin_ = p;
+    in_ = begin_;
+    out_ = begin_ + len;
+    last_ = out_;
+    end_ = out_;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_from(basic_flat_streambuf& other)
+{
+    begin_ = other.begin_;
+    in_ = other.in_;
+    out_ = other.out_;
+    last_ = out_;
+    end_ = other.end_;
+    max_ = other.max_;
+    other.begin_ = nullptr;
+    other.in_ = nullptr;
+    other.out_ = nullptr;
+    other.last_ = nullptr;
+    other.end_ = nullptr;
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+void
+basic_flat_streambuf<Allocator>::
+copy_from(basic_flat_streambuf<OtherAlloc> const& other)
+{
+    auto const n = other.size();
+    consume(size());
+    if(n > 0)
+    {
+        auto const mb = prepare(n);
+        std::memcpy(boost::asio::buffer_cast<void*>(mb),
+            other.in_, n);
+        commit(n);
+    }
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::false_type)
+{
+    if(this->member() != other.member())
+    {
+        max_ = other.max_;
+        copy_from(other);
+        other.consume(other.size());
+        other.shrink_to_fit();
+    }
+    else
+    {
+        move_assign(other, std::true_type{});
+    }
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_assign(basic_flat_streambuf& other, std::true_type)
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, dist(begin_, end_));
+    this->member() = std::move(other.member());
+    move_from(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::false_type)
+{
+    max_ = other.max_;
+    copy_from(other);
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_assign(basic_flat_streambuf const& other, std::true_type)
+{
+    if(this->member() != other.member())
+    {
+        consume(size());
+        shrink_to_fit();
+    }
+    this->member() = other.member();
+    copy_assign(other, std::false_type{});
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_flat_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    BOOST_ASSERT(max_size >= 1);
+    auto const size = streambuf.size();
+    auto const limit = streambuf.max_size() - size;
+    if(limit == 0)
+        // prepare will throw
+        return 1;
+    // If we already have an allocated
+    // buffer, try to fill that up first
+    auto const avail = streambuf.capacity() - size;
+    if(avail > 0)
+        return (std::min)({avail, max_size, limit});
+    // ...but enforce a 512 byte minimum.
+    return (std::min)({max_size, limit, (std::max)(
+        size, std::size_t{512})});
+}
+
+} // beast
+
+#endif
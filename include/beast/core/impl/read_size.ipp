@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_READ_SIZE_IPP
+#define BEAST_IMPL_READ_SIZE_IPP
+
+#include <boost/assert.hpp>
+#include <algorithm>
+
+namespace beast {
+
+inline
+read_size_policy::
+read_size_policy(std::size_t min_size, std::size_t max_size)
+    : min_((std::max)(min_size, std::size_t{1}))
+    , max_((std::max)(max_size, min_))
+    , size_(min_)
+{
+    BOOST_ASSERT(min_size <= max_size);
+}
+
+inline
+void
+read_size_policy::
+on_read(std::size_t prepared, std::size_t bytes_transferred)
+{
+    ++reads_;
+    bytes_ += bytes_transferred;
+    // A read which fills less space than the current size,
+    // for example the end of a partly used buffer, says
+    // nothing about whether more data was waiting.
+    full_ = prepared >= size_ &&
+        bytes_transferred >= prepared;
+    if(full_)
+    {
+        size_ = (std::min)(
+            (std::max)(size_ * 2, bytes_transferred), max_);
+        short_ = 0;
+        return;
+    }
+    if(bytes_transferred >= size_ / 4)
+    {
+        short_ = 0;
+        return;
+    }
+    if(++short_ < shrink_after)
+        return;
+    short_ = 0;
+    size_ = (std::max)(size_ / 2, min_);
+}
+
+inline
+void
+read_size_policy::
+reset()
+{
+    size_ = min_;
+    short_ = 0;
+    full_ = false;
+    reads_ = 0;
+    bytes_ = 0;
+}
+
+inline
+std::size_t
+read_size_policy::
+adjust(std::size_t available) const
+{
+    return (std::max)(size_, (std::min)(available, max_));
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_SERVER_GROUP_IPP
+#define BEAST_IMPL_SERVER_GROUP_IPP
+
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/socket_option.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace beast {
+
+namespace detail {
+
+// Only Linux spreads connections across sockets sharing a port
+// with SO_REUSEPORT; FreeBSD does so with SO_REUSEPORT_LB. Other
+// systems, such as macOS, define SO_REUSEPORT but deliver every
+// connection to one socket, so they use a single listener.
+#if defined(__linux__) && defined(SO_REUSEPORT)
+#define BEAST_SERVER_GROUP_REUSE_PORT SO_REUSEPORT
+#elif defined(SO_REUSEPORT_LB)
+#define BEAST_SERVER_GROUP_REUSE_PORT SO_REUSEPORT_LB
+#endif
+
+#ifdef BEAST_SERVER_GROUP_REUSE_PORT
+using reuse_port = boost::asio::detail::socket_option::
+    boolean<SOL_SOCKET, BEAST_SERVER_GROUP_REUSE_PORT>;
+#endif
+
+// Bind the calling thread to a CPU, if supported
+inline
+void
+pin_thread(std::size_t index)
+{
+#if defined(__linux__)
+    auto const n = (std::max)(1u,
+        std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % n), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+} // detail
+
+inline
+server_group::context::
+context(std::size_t index)
+    : index_(index)
+    // Tell the io_service it is run by one thread
+    , ios_(1)
+    , acceptor_(ios_)
+    , sock_(ios_)
+{
+}
+
+inline
+server_group::
+server_group(std::size_t threads, bool pin)
+    : pin_(pin)
+{
+    if(threads == 0)
+        threads = (std::max)(1u,
+            std::thread::hardware_concurrency());
+    ctx_.reserve(threads);
+    for(std::size_t i = 0; i < threads; ++i)
+        ctx_.emplace_back(new context{i});
+}
+
+inline
+server_group::
+~server_group()
+{
+    close();
+}
+
+inline
+void
+server_group::
+open(endpoint_type const& ep, handler_type handler)
+{
+    error_code ec;
+    open(ep, std::move(handler), ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+inline
+void
+server_group::
+open(endpoint_type const& ep,
+    handler_type handler, error_code& ec)
+{
+    BOOST_ASSERT(! open_);
+    handler_ = std::move(handler);
+    ep_ = ep;
+#ifdef BEAST_SERVER_GROUP_REUSE_PORT
+    reuse_port_ = true;
+#endif
+    // The first socket chooses the port
+    listen(*ctx_[0], reuse_port_, ec);
+    if(ec && reuse_port_)
+    {
+        // Fall back to a single listening socket
+        reuse_port_ = false;
+        ctx_[0]->acceptor_.close(ec);
+        ec = {};
+        listen(*ctx_[0], false, ec);
+    }
+    if(ec)
+        return;
+    ep_ = ctx_[0]->acceptor_.local_endpoint();
+    if(reuse_port_)
+    {
+        for(std::size_t i = 1; i < ctx_.size(); ++i)
+        {
+            listen(*ctx_[i], true, ec);
+            if(ec)
+            {
+                error_code ev;
+                for(std::size_t j = 0; j <= i; ++j)
+                    ctx_[j]->acceptor_.close(ev);
+                return;
+            }
+        }
+    }
+    open_ = true;
+    for(auto& p : ctx_)
+    {
+        auto& ctx = *p;
+        if(ctx.acceptor_.is_open())
+            do_accept(ctx);
+        // Clear the stopped state left by close
+        ctx.ios_.reset();
+        ctx.thread_ = std::thread{
+            [this, &ctx]
+            {
+                if(pin_)
+                    detail::pin_thread(ctx.index_);
+                // Keep running while the acceptor is idle
+                boost::asio::io_service::work work{ctx.ios_};
+                ctx.ios_.run();
+            }};
+    }
+}
+
+inline
+void
+server_group::
+close()
+{
+    if(! open_)
+        return;
+    open_ = false;
+    for(auto& p : ctx_)
+        p->ios_.stop();
+    for(auto& p : ctx_)
+        p->thread_.join();
+    // Handlers of accepts started before now do nothing if
+    // they run after the group is opened again.
+    ++gen_;
+    error_code ec;
+    for(auto& p : ctx_)
+    {
+        auto& ctx = *p;
+        ctx.acceptor_.close(ec);
+        ctx.sock_.close(ec);
+    }
+}
+
+inline
+void
+server_group::
+listen(context& ctx, bool reuse_port, error_code& ec)
+{
+    auto& a = ctx.acceptor_;
+    a.open(ep_.protocol(), ec);
+    if(ec)
+        return;
+    a.set_option(boost::asio::socket_base::reuse_address{true}, ec);
+    if(ec)
+        return;
+#ifdef BEAST_SERVER_GROUP_REUSE_PORT
+    if(reuse_port)
+    {
+        a.set_option(detail::reuse_port{true}, ec);
+        if(ec)
+            return;
+    }
+#else
+    (void)reuse_port;
+#endif
+    a.bind(ep_, ec);
+    if(ec)
+        return;
+    a.listen(boost::asio::socket_base::max_connections, ec);
+}
+
+inline
+void
+server_group::
+do_accept(context& ctx)
+{
+    auto const gen = gen_;
+    if(reuse_port_)
+    {
+        ctx.acceptor_.async_accept(ctx.sock_,
+            [this, &ctx, gen](error_code const& ec)
+            {
+                if(gen != gen_)
+                    return;
+                on_accept(ctx, ec);
+            });
+        return;
+    }
+    // Accept into a socket belonging to the next
+    // thread, then run the handler on that thread.
+    auto& to = *ctx_[next_];
+    next_ = (next_ + 1) % ctx_.size();
+    auto sock = std::make_shared<socket_type>(to.ios_);
+    ctx.acceptor_.async_accept(*sock,
+        [this, &ctx, &to, sock, gen](error_code const& ec)
+        {
+            if(gen != gen_ || ! ctx.acceptor_.is_open())
+                return;
+            if(! ec)
+                to.ios_.post(
+                    [this, &to, sock, gen]
+                    {
+                        if(gen != gen_)
+                            return;
+                        socket_type s{std::move(*sock)};
+                        handler_(std::move(s), to);
+                    });
+            do_accept(ctx);
+        });
+}
+
+inline
+void
+server_group::
+on_accept(context& ctx, error_code const& ec)
+{
+    if(! ctx.acceptor_.is_open())
+        return;
+    if(! ec)
+    {
+        // The socket is closed on return
+        // unless the handler takes it.
+        socket_type sock{std::move(ctx.sock_)};
+        handler_(std::move(sock), ctx);
+    }
+    do_accept(ctx);
+}
+
+} // beast
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BEAST_PREPARE_BUFFERS_HPP
 #define BEAST_PREPARE_BUFFERS_HPP
 
+#include <beast/core/prepare_buffer.hpp>
 #include <beast/core/detail/prepare_buffers.hpp>
 #include <boost/asio/buffer.hpp>
 #include <algorithm>
@@ -47,6 +48,31 @@ prepare_buffers(std::size_t n, BufferSequence const& buffers)
     return detail::prepared_buffers<BufferSequence>(n, buffers);
 }
 
+#if ! GENERATING_DOCS
+
+// Overloads for a sequence of one buffer, which
+// shorten the buffer rather than adapt the sequence.
+
+inline
+boost::asio::const_buffers_1
+prepare_buffers(std::size_t n,
+    boost::asio::const_buffers_1 const& buffers)
+{
+    return boost::asio::const_buffers_1{
+        prepare_buffer(n, *buffers.begin())};
+}
+
+inline
+boost::asio::mutable_buffers_1
+prepare_buffers(std::size_t n,
+    boost::asio::mutable_buffers_1 const& buffers)
+{
+    return boost::asio::mutable_buffers_1{
+        prepare_buffer(n, *buffers.begin())};
+}
+
+#endif
+
 } // beast
 
 #endif
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_READ_SIZE_HPP
+#define BEAST_READ_SIZE_HPP
+
+#include <beast/core/error.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+
+namespace detail {
+
+template<class T>
+class has_available
+{
+    template<class U, class R = decltype(
+        std::declval<U>().available(std::declval<error_code&>()))>
+    static std::true_type check(int);
+
+    template<class>
+    static std::false_type check(...);
+
+public:
+    using type = decltype(check<T>(0));
+};
+
+template<class Stream>
+std::size_t
+bytes_available(Stream& stream, std::true_type)
+{
+    error_code ec;
+    auto const n = stream.available(ec);
+    return ec ? 0 : n;
+}
+
+template<class Stream>
+std::size_t
+bytes_available(Stream&, std::false_type)
+{
+    return 0;
+}
+
+} // detail
+
+/** A policy which adapts the size of reads to the traffic observed.
+
+    Objects of this type choose how many bytes to prepare in a
+    dynamic buffer before each call to `read_some`, in place of a
+    fixed size. The size starts at the minimum and doubles after
+    each read which fills the space prepared for it, up to the
+    maximum. After several reads in a row which fill less than a
+    quarter of the space, the size is halved, down to the minimum.
+    Connections carrying small messages keep small buffers, while
+    bulk transfers quickly reach the maximum and need fewer calls.
+
+    When the previous read filled its space and the stream has an
+    `available` member, as sockets do, the number of bytes waiting
+    to be read (`FIONREAD`) is also used to size the next read. The
+    stream is not queried otherwise, so a connection which is idle
+    or carrying small messages pays no extra system calls.
+
+    The policy counts the reads and bytes it observes, so that its
+    limits may be tuned for a service.
+
+    A policy may be used with @ref dynabuf_readstream, the HTTP
+    parse functions, and the WebSocket stream.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Unsafe.
+*/
+class read_size_policy
+{
+    std::size_t min_;
+    std::size_t max_;
+    std::size_t size_;
+    std::size_t short_ = 0;
+    bool full_ = false;
+    std::size_t reads_ = 0;
+    std::uint64_t bytes_ = 0;
+
+public:
+    /// The number of reads in a row below a quarter of the size which halve it.
+    static std::size_t constexpr shrink_after = 4;
+
+    /** Constructor.
+
+        @param min_size The smallest read size.
+
+        @param max_size The largest read size. This must
+        not be less than `min_size`.
+    */
+    explicit
+    read_size_policy(std::size_t min_size = 512,
+        std::size_t max_size = 65536);
+
+    /// Return the smallest read size.
+    std::size_t
+    min_size() const
+    {
+        return min_;
+    }
+
+    /// Return the largest read size.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Return the current read size.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /// Return the number of reads observed.
+    std::size_t
+    reads() const
+    {
+        return reads_;
+    }
+
+    /// Return the number of bytes observed.
+    std::uint64_t
+    bytes() const
+    {
+        return bytes_;
+    }
+
+    /** Return the number of bytes to prepare for the next read.
+
+        @param stream The stream which will be read. If the previous
+        read filled its space and the stream provides `available`,
+        the bytes waiting on the stream raise the result, up to the
+        maximum size.
+    */
+    template<class Stream>
+    std::size_t
+    read_size(Stream& stream) const
+    {
+        if(! full_)
+            return size_;
+        return adjust(detail::bytes_available(stream,
+            typename detail::has_available<Stream>::type{}));
+    }
+
+    /** Record the result of a read.
+
+        @param prepared The number of bytes of space given to
+        the read.
+
+        @param bytes_transferred The number of bytes read.
+    */
+    void
+    on_read(std::size_t prepared,
+        std::size_t bytes_transferred);
+
+    /// Restore the initial size and clear the counters.
+    void
+    reset();
+
+private:
+    std::size_t
+    adjust(std::size_t available) const;
+};
+
+} // beast
+
+#include <beast/core/impl/read_size.ipp>
+
+#endif
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_SERVER_GROUP_HPP
+#define BEAST_SERVER_GROUP_HPP
+
+#include <beast/core/block_pool.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace beast {
+
+/** Accepts TCP connections on a group of single-threaded io_services.
+
+    A server group runs a number of threads, each with its own
+    `io_service` and its own listening socket bound to the same
+    endpoint with the `SO_REUSEPORT` option, so that the operating
+    system distributes incoming connections across the threads.
+    Every accepted socket is passed to the handler on the thread
+    which accepted it, together with the @ref context for that
+    thread.
+
+    Since each `io_service` is run by exactly one thread, the
+    asynchronous operations of a connection created with the
+    context's `io_service` are never executed concurrently, and
+    need no strand. Threads share no state after startup, so
+    they do not contend on a common reactor or handler queue.
+
+    Separate listening sockets are used on Linux, and on FreeBSD
+    with `SO_REUSEPORT_LB`. Elsewhere, including platforms where
+    `SO_REUSEPORT` exists but does not balance connections such
+    as macOS, the first thread accepts all connections and hands
+    each one to the threads in turn.
+
+    Each context also provides a @ref block_pool for connections
+    to draw their buffers from, for example using a
+    @ref basic_streambuf with a @ref pool_allocator. Since the
+    pool is used only from one thread, its locks never contend.
+
+    @par Example
+    @code
+        server_group g{4};
+        g.open(ep,
+            [](boost::asio::ip::tcp::socket&& sock,
+                server_group::context& ctx)
+            {
+                std::make_shared<session>(
+                    std::move(sock), ctx.pool())->run();
+            });
+        ...
+        g.close();
+    @endcode
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Unsafe.
+*/
+class server_group
+{
+public:
+    /// The type of endpoint the group listens on.
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+
+    /// The type of socket passed to the handler.
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    /// The state belonging to one thread of the group.
+    class context
+    {
+        friend class server_group;
+
+        std::size_t index_;
+        // Declared before the io_service, so that connections
+        // destroyed along with it can return their memory.
+        block_pool pool_;
+        boost::asio::io_service ios_;
+        boost::asio::ip::tcp::acceptor acceptor_;
+        socket_type sock_;
+        std::thread thread_;
+
+    public:
+        /// Constructor (for internal use only)
+        explicit
+        context(std::size_t index);
+
+        /// Return the `io_service` run by this thread.
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        /// Return the memory pool for this thread.
+        block_pool&
+        pool()
+        {
+            return pool_;
+        }
+
+        /// Return the zero-based index of this thread in the group.
+        std::size_t
+        index() const
+        {
+            return index_;
+        }
+    };
+
+    /** The type of handler called for each accepted connection.
+
+        The handler is invoked on the thread belonging to the
+        context, with a socket created on the context's
+        `io_service`.
+    */
+    using handler_type =
+        std::function<void(socket_type&&, context&)>;
+
+private:
+    std::vector<std::unique_ptr<context>> ctx_;
+    handler_type handler_;
+    endpoint_type ep_;
+    std::size_t next_ = 0;
+    std::size_t gen_ = 0;
+    bool pin_;
+    bool reuse_port_ = false;
+    bool open_ = false;
+
+public:
+    /** Constructor.
+
+        @param threads The number of threads in the group. If this
+        is zero, one thread is used for each hardware thread.
+
+        @param pin `true` to bind each thread to a CPU, where the
+        platform supports it. Thread `i` is bound to CPU `i`
+        modulo the number of hardware threads.
+    */
+    explicit
+    server_group(std::size_t threads = 0, bool pin = false);
+
+    /// Destructor. Calls @ref close.
+    ~server_group();
+
+    /// Copy constructor (disallowed)
+    server_group(server_group const&) = delete;
+
+    /// Copy assignment (disallowed)
+    server_group& operator=(server_group const&) = delete;
+
+    /// Return the number of threads in the group.
+    std::size_t
+    size() const
+    {
+        return ctx_.size();
+    }
+
+    /// Return the context for a thread.
+    context&
+    at(std::size_t index)
+    {
+        return *ctx_.at(index);
+    }
+
+    /** Return `true` if each thread has its own listening socket.
+
+        This is `false` if the platform cannot balance connections
+        across listening sockets, or before @ref open is called.
+    */
+    bool
+    reuse_port() const
+    {
+        return reuse_port_;
+    }
+
+    /** Return the endpoint the group is listening on.
+
+        If the group was opened with port zero, this returns the
+        port chosen by the operating system.
+    */
+    endpoint_type
+    local_endpoint() const
+    {
+        return ep_;
+    }
+
+    /** Start listening and run the threads.
+
+        @param ep The endpoint to listen on.
+
+        @param handler The handler to call for each connection.
+
+        @throws system_error Thrown on failure.
+    */
+    void
+    open(endpoint_type const& ep, handler_type handler);
+
+    /** Start listening and run the threads.
+
+        @param ep The endpoint to listen on.
+
+        @param handler The handler to call for each connection.
+
+        @param ec Set to indicate what error occurred, if any.
+    */
+    void
+    open(endpoint_type const& ep,
+        handler_type handler, error_code& ec);
+
+    /** Stop listening and stop the threads.
+
+        Every `io_service` in the group is stopped, and this
+        function blocks until all threads exit. No handlers are
+        invoked on the calling thread. Handlers which are pending
+        at that point stay queued: they run on their own thread
+        if the group is opened again, otherwise they are destroyed
+        along with the group. Accepts cancelled by this call are
+        discarded without calling the handler.
+
+        The group may be opened again after it is closed.
+    */
+    void
+    close();
+
+private:
+    void
+    listen(context& ctx, bool reuse_port, error_code& ec);
+
+    void
+    do_accept(context& ctx);
+
+    void
+    on_accept(context& ctx, error_code const& ec);
+};
+
+} // beast
+
+#include <beast/core/impl/server_group.ipp>
+
+#endif
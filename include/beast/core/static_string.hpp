@@ -8,14 +8,43 @@
 #ifndef BEAST_WEBSOCKET_STATIC_STRING_HPP
 #define BEAST_WEBSOCKET_STATIC_STRING_HPP
 
+#include <beast/core/detail/format_integer.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <array>
 #include <cstdint>
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace beast {
 
+namespace detail {
+
+template<class Traits, class CharT>
+int
+static_string_compare(CharT const* s1, std::size_t n1,
+    CharT const* s2, std::size_t n2)
+{
+    if(n1 < n2)
+    {
+        auto const v = Traits::compare(s1, s2, n1);
+        if(v == 0)
+            return -1;
+        return v;
+    }
+    else if(n1 > n2)
+    {
+        auto const v = Traits::compare(s1, s2, n2);
+        if(v == 0)
+            return 1;
+        return v;
+    }
+    return Traits::compare(s1, s2, n1);
+}
+
+} // detail
+
 /** A string with a fixed-size storage area.
 
     These objects behave like `std::string` except that the storage
@@ -54,6 +83,10 @@ public:
     using const_reverse_iterator =
         std::reverse_iterator<const_iterator>;
 
+    /// The type of string reference the string converts to.
+    using string_ref_type =
+        boost::basic_string_ref<CharT, Traits>;
+
     /** Default constructor.
 
         The string is initially empty, and null terminated.
@@ -84,6 +117,22 @@ public:
     template<std::size_t M>
     static_string& operator=(const CharT (&s)[M]);
 
+    /** Construct from a string reference.
+
+        @throws std::length_error if the string is too large.
+    */
+    explicit
+    static_string(string_ref_type s)
+    {
+        assign(s.data(), s.size());
+    }
+
+    /// Returns a string reference to the characters.
+    operator string_ref_type() const
+    {
+        return {&s_[0], n_};
+    }
+
     /// Access specified character with bounds checking.
     reference
     at(size_type pos);
@@ -289,10 +338,94 @@ public:
     void
     resize(std::size_t n, CharT c);
 
+    /** Replace the contents with a null-terminated string.
+
+        @throws std::length_error if the string is too large.
+    */
+    static_string&
+    assign(CharT const* s);
+
+    /** Replace the contents with a range of characters.
+
+        @throws std::length_error if the string is too large.
+    */
+    static_string&
+    assign(CharT const* s, size_type n);
+
+    /** Replace the contents with a string reference.
+
+        @throws std::length_error if the string is too large.
+    */
+    static_string&
+    assign(string_ref_type s)
+    {
+        return assign(s.data(), s.size());
+    }
+
+    /** Append a range of characters.
+
+        @throws std::length_error if the result is too large.
+    */
+    static_string&
+    append(CharT const* s, size_type n);
+
+    /** Append a string reference.
+
+        @throws std::length_error if the result is too large.
+    */
+    static_string&
+    append(string_ref_type s)
+    {
+        return append(s.data(), s.size());
+    }
+
+    /** Append `count` copies of the character `c`.
+
+        @throws std::length_error if the result is too large.
+    */
+    static_string&
+    append(size_type count, CharT c);
+
+    /** Append a character.
+
+        @throws std::length_error if the string is full.
+    */
+    void
+    push_back(CharT c)
+    {
+        append(1, c);
+    }
+
+    /// Append a string reference.
+    static_string&
+    operator+=(string_ref_type s)
+    {
+        return append(s.data(), s.size());
+    }
+
+    /// Append a character.
+    static_string&
+    operator+=(CharT c)
+    {
+        return append(1, c);
+    }
+
     /// Compare two character sequences.
     template<std::size_t M>
     int
-    compare(static_string<M, CharT, Traits> const& rhs) const;
+    compare(static_string<M, CharT, Traits> const& rhs) const
+    {
+        return detail::static_string_compare<Traits>(
+            data(), size(), rhs.data(), rhs.size());
+    }
+
+    /// Compare with a string reference.
+    int
+    compare(string_ref_type s) const
+    {
+        return detail::static_string_compare<Traits>(
+            data(), size(), s.data(), s.size());
+    }
 
     /// Return the characters as a `basic_string`.
     std::basic_string<CharT, Traits>
@@ -301,10 +434,6 @@ public:
         return std::basic_string<
             CharT, Traits>{&s_[0], n_};
     }
-
-private:
-    void
-    assign(CharT const* s);
 };
 
 template<std::size_t N, class CharT, class Traits>
@@ -431,40 +560,55 @@ resize(std::size_t n, CharT c)
 }
 
 template<std::size_t N, class CharT, class Traits>
-template<std::size_t M>
-int
+auto
 static_string<N, CharT, Traits>::
-compare(static_string<M, CharT, Traits> const& rhs) const
+assign(CharT const* s) ->
+    static_string&
 {
-    if(size() < rhs.size())
-    {
-        auto const v = Traits::compare(
-            data(), rhs.data(), size());
-        if(v == 0)
-            return -1;
-        return v;
-    }
-    else if(size() > rhs.size())
-    {
-        auto const v = Traits::compare(
-            data(), rhs.data(), rhs.size());
-        if(v == 0)
-            return 1;
-        return v;
-    }
-    return Traits::compare(data(), rhs.data(), size());
+    return assign(s, Traits::length(s));
 }
 
 template<std::size_t N, class CharT, class Traits>
-void
+auto
 static_string<N, CharT, Traits>::
-assign(CharT const* s)
+assign(CharT const* s, size_type n) ->
+    static_string&
 {
-    auto const n = Traits::length(s);
     if(n > N)
-        throw std::out_of_range("too large");
+        throw std::length_error("static_string overflow");
+    // s may point into this string
+    Traits::move(&s_[0], s, n);
     n_ = n;
-    Traits::copy(&s_[0], s, n_ + 1);
+    s_[n_] = 0;
+    return *this;
+}
+
+template<std::size_t N, class CharT, class Traits>
+auto
+static_string<N, CharT, Traits>::
+append(CharT const* s, size_type n) ->
+    static_string&
+{
+    if(n > N - n_)
+        throw std::length_error("static_string overflow");
+    Traits::copy(&s_[n_], s, n);
+    n_ += n;
+    s_[n_] = 0;
+    return *this;
+}
+
+template<std::size_t N, class CharT, class Traits>
+auto
+static_string<N, CharT, Traits>::
+append(size_type count, CharT c) ->
+    static_string&
+{
+    if(count > N - n_)
+        throw std::length_error("static_string overflow");
+    Traits::assign(&s_[n_], count, c);
+    n_ += count;
+    s_[n_] = 0;
+    return *this;
 }
 
 namespace detail {
@@ -475,23 +619,8 @@ compare(
     static_string<N, CharT, Traits> const& lhs,
     const CharT (&s)[M])
 {
-    if(lhs.size() < M-1)
-    {
-        auto const v = Traits::compare(
-            lhs.data(), &s[0], lhs.size());
-        if(v == 0)
-            return -1;
-        return v;
-    }
-    else if(lhs.size() > M-1)
-    {
-        auto const v = Traits::compare(
-            lhs.data(), &s[0], M-1);
-        if(v == 0)
-            return 1;
-        return v;
-    }
-    return Traits::compare(lhs.data(), &s[0], lhs.size());
+    return static_string_compare<Traits>(
+        lhs.data(), lhs.size(), &s[0], M-1);
 }
 
 template<std::size_t N, std::size_t M, class CharT, class Traits>
@@ -670,6 +799,69 @@ operator>=(
     return detail::compare(lhs, s) >= 0;
 }
 
+//---
+
+template<std::size_t N, class CharT, class Traits>
+bool
+operator==(
+    static_string<N, CharT, Traits> const& lhs,
+    boost::basic_string_ref<CharT, Traits> rhs)
+{
+    return lhs.compare(rhs) == 0;
+}
+
+template<std::size_t N, class CharT, class Traits>
+bool
+operator==(
+    boost::basic_string_ref<CharT, Traits> lhs,
+    static_string<N, CharT, Traits> const& rhs)
+{
+    return rhs.compare(lhs) == 0;
+}
+
+template<std::size_t N, class CharT, class Traits>
+bool
+operator!=(
+    static_string<N, CharT, Traits> const& lhs,
+    boost::basic_string_ref<CharT, Traits> rhs)
+{
+    return lhs.compare(rhs) != 0;
+}
+
+template<std::size_t N, class CharT, class Traits>
+bool
+operator!=(
+    boost::basic_string_ref<CharT, Traits> lhs,
+    static_string<N, CharT, Traits> const& rhs)
+{
+    return rhs.compare(lhs) != 0;
+}
+
+/** Returns a static string representing an integer as a decimal.
+
+    The integer is formatted without allocating memory, into
+    a string large enough to hold any value of the type.
+
+    @param x The integer to convert.
+
+    @return A @ref static_string holding the decimal digits
+    of the integer, preceded by a minus sign if negative.
+*/
+template<class Integer>
+static_string<detail::max_digits<Integer>::value>
+to_static_string(Integer x)
+{
+    static_assert(std::is_integral<Integer>::value &&
+        ! std::is_same<Integer, bool>::value,
+            "Integer requirements not met");
+    char buf[detail::max_digits<Integer>::value];
+    auto const end = buf + sizeof(buf);
+    auto const p = detail::format_integer(end, x);
+    static_string<detail::max_digits<Integer>::value> s;
+    s.assign(p, static_cast<std::size_t>(end - p));
+    return s;
+}
+
 } // beast
 
 #endif
@@ -31,6 +31,12 @@ namespace beast {
 
     @li A type meeting the requirements of @b `MutableBufferSequence`
 
+    @li An integer type other than `bool` and the character types.
+    These are formatted directly, without creating a temporary string.
+
+    @li A type convertible to `boost::string_ref`, such as
+    @ref static_string. The characters are copied directly.
+
     For all types not listed above, the function will invoke
     `boost::lexical_cast` on the argument in an attempt to convert to
     a string, which is then appended to the dynamic buffer.
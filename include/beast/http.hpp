@@ -11,7 +11,11 @@
 #include <beast/http/basic_fields.hpp>
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/http/chunk_encode.hpp>
+#include <beast/http/client_pool.hpp>
+#include <beast/http/date.hpp>
+#include <beast/http/deflate_body.hpp>
 #include <beast/http/empty_body.hpp>
+#include <beast/http/file_body.hpp>
 #include <beast/http/fields.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/parse.hpp>
@@ -21,6 +25,7 @@
 #include <beast/http/reason.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/rfc7230.hpp>
+#include <beast/http/spill_body.hpp>
 #include <beast/http/streambuf_body.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/http/write.hpp>
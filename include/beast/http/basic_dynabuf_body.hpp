@@ -37,10 +37,9 @@ private:
         value_type& sb_;
 
     public:
-        template<bool isRequest, class Fields>
+        template<bool isRequest, class Body, class Fields>
         explicit
-        reader(message<isRequest,
-                basic_dynabuf_body, Fields>& m) noexcept
+        reader(message<isRequest, Body, Fields>& m) noexcept
             : sb_(m.body)
         {
         }
@@ -66,10 +65,10 @@ private:
         DynamicBuffer const& body_;
 
     public:
-        template<bool isRequest, class Fields>
+        template<bool isRequest, class Body, class Fields>
         explicit
         writer(message<
-                isRequest, basic_dynabuf_body, Fields> const& m) noexcept
+                isRequest, Body, Fields> const& m) noexcept
             : body_(m.body)
         {
         }
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_CLIENT_POOL_HPP
+#define BEAST_HTTP_CLIENT_POOL_HPP
+
+#include <beast/http/message.hpp>
+#include <beast/core/async_completion.hpp>
+#include <beast/core/error.hpp>
+#include <beast/core/streambuf.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** A pool of outgoing HTTP/1 connections.
+
+    Objects of this type send requests to HTTP servers over TCP/IP
+    and receive the responses, reusing connections between requests
+    when the server allows it. For each remote endpoint the pool
+    keeps the set of idle connections left open after a previous
+    response. A request to an endpoint is sent on one of its idle
+    connections if there is one, otherwise a new connection is
+    established.
+
+    The number of connections to each endpoint is bounded by a
+    limit set at construction. Requests issued while the limit is
+    reached are queued, and sent in the order issued as connections
+    become available.
+
+    A connection is returned to the pool after the response is
+    received, unless the server or the request indicated that the
+    connection should close, or the response is delimited by the
+    end of file. Since the server may close an idle connection at
+    any time, a request which fails on a reused connection because
+    the server closed it is sent again, once, on a new connection.
+    This is done only for the idempotent methods GET, HEAD, PUT,
+    DELETE, OPTIONS and TRACE; other requests fail with the error.
+
+    Requests are not pipelined; each connection carries at most one
+    outstanding request.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Unsafe. The application must ensure that
+    all asynchronous operations are performed within the same
+    implicit or explicit strand.
+
+    @note The pool must not be destroyed while there are pending
+    asynchronous operations associated with it, other than requests
+    waiting for a connection, which complete with
+    `boost::asio::error::operation_aborted`.
+*/
+class client_pool
+{
+public:
+    /// The type of endpoint used to identify a server.
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+
+private:
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    template<class ReqBody, class ResBody,
+        class Fields, class Handler>
+    class request_op;
+
+    struct connection
+    {
+        socket_type sock;
+        streambuf sb;
+        endpoint_type ep;
+        bool reused = false;
+
+        connection(boost::asio::io_service& ios,
+                endpoint_type const& ep_)
+            : sock(ios)
+            , ep(ep_)
+        {
+        }
+    };
+
+    struct host
+    {
+        // Connections checked out by requests
+        std::size_t active = 0;
+
+        // Connections kept open for reuse
+        std::vector<std::unique_ptr<connection>> idle;
+
+        // Requests waiting for a connection
+        std::deque<std::function<void(connection*)>> waiters;
+    };
+
+    boost::asio::io_service& ios_;
+    std::size_t limit_;
+    std::map<endpoint_type, host> hosts_;
+    std::size_t connects_ = 0;
+    std::size_t reuses_ = 0;
+
+public:
+    /** Constructor.
+
+        @param ios The io_service used to perform
+        asynchronous operations.
+
+        @param limit The largest number of connections
+        kept open to each endpoint. This may not be zero.
+    */
+    explicit
+    client_pool(boost::asio::io_service& ios,
+        std::size_t limit = 6);
+
+    /// Destructor
+    ~client_pool();
+
+    /// Copy constructor (disallowed)
+    client_pool(client_pool const&) = delete;
+
+    /// Copy assignment (disallowed)
+    client_pool& operator=(client_pool const&) = delete;
+
+    /// Return the `io_service` associated with the pool.
+    boost::asio::io_service&
+    get_io_service()
+    {
+        return ios_;
+    }
+
+    /// Return the largest number of connections to each endpoint.
+    std::size_t
+    limit() const
+    {
+        return limit_;
+    }
+
+    /// Return the number of connections established by the pool.
+    std::size_t
+    connects() const
+    {
+        return connects_;
+    }
+
+    /// Return the number of requests sent on a reused connection.
+    std::size_t
+    reuses() const
+    {
+        return reuses_;
+    }
+
+    /// Return the number of idle connections to an endpoint.
+    std::size_t
+    idle(endpoint_type const& ep) const;
+
+    /** Close all idle connections.
+
+        Requests waiting for a connection complete with
+        `boost::asio::error::operation_aborted`. Connections
+        in use by pending requests are unaffected.
+    */
+    void
+    close();
+
+    /** Start an asynchronous HTTP request.
+
+        This function is used to asynchronously send a request to
+        the server at the specified endpoint, and receive the
+        response. The function call always returns immediately.
+        The asynchronous operation will continue until one of the
+        following conditions is true:
+
+        @li The complete response has been received.
+
+        @li An error occurs.
+
+        This operation is implemented in terms of one or more calls
+        to the socket functions `async_connect`, `async_write_some`
+        and `async_read_some`. If the response is to a HEAD request,
+        the response body is not read.
+
+        @param ep The endpoint of the server.
+
+        @param req The request to send. The object must remain valid
+        at least until the completion handler is called; ownership
+        is not transferred. The caller is responsible for setting
+        the fields of the request, including Host and Content-Length
+        or Transfer-Encoding, for example by calling @ref prepare.
+
+        @param res An object to receive the response. The object must
+        remain valid at least until the completion handler is called;
+        ownership is not transferred.
+
+        @param handler The handler to be called when the request
+        completes. Copies will be made of the handler as required.
+        The equivalent function signature of the handler must be:
+        @code void handler(
+            error_code const& error // result of operation
+        ); @endcode
+        Regardless of whether the asynchronous operation completes
+        immediately or not, the handler will not be invoked from
+        within this function. Invocation of the handler will be
+        performed in a manner equivalent to using
+        `boost::asio::io_service::post`.
+    */
+    template<class ReqBody, class ResBody,
+        class Fields, class RequestHandler>
+#if GENERATING_DOCS
+    void_or_deduced
+#else
+    typename async_completion<
+        RequestHandler, void(error_code)>::result_type
+#endif
+    async_request(endpoint_type const& ep,
+        request<ReqBody, Fields> const& req,
+            response<ResBody, Fields>& res,
+                RequestHandler&& handler);
+
+private:
+    template<class Waiter>
+    std::unique_ptr<connection>
+    acquire(endpoint_type const& ep, Waiter&& w);
+
+    void
+    release(std::unique_ptr<connection> c, bool keep);
+};
+
+} // http
+} // beast
+
+#include <beast/http/impl/client_pool.ipp>
+
+#endif
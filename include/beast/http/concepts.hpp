@@ -36,6 +36,20 @@ struct has_value_type<T, beast::detail::void_t<
     typename T::value_type
         > > : std::true_type {};
 
+template<class T, class = beast::detail::void_t<>>
+struct has_content_encoding : std::false_type {};
+
+template<class T>
+struct has_content_encoding<T, beast::detail::void_t<decltype(
+    T::content_encoding()
+        )> > : std::true_type
+{
+    static_assert(std::is_convertible<
+        decltype(T::content_encoding()),
+            char const*>::value,
+        "Body::content_encoding requirements not met");
+};
+
 template<class T, class = beast::detail::void_t<>>
 struct has_content_length : std::false_type {};
 
@@ -50,6 +64,14 @@ struct has_content_length<T, beast::detail::void_t<decltype(
         "Writer::content_length requirements not met");
 };
 
+template<class T, class = beast::detail::void_t<>>
+struct has_finish : std::false_type {};
+
+template<class T>
+struct has_finish<T, beast::detail::void_t<decltype(
+    std::declval<T>().finish(std::declval<error_code&>())
+        )> > : std::true_type {};
+
 #if 0
 template<class T, class M, class = beast::detail::void_t<>>
 struct is_Writer : std::false_type {};
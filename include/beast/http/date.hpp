@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DATE_HPP
+#define BEAST_HTTP_DATE_HPP
+
+#include <beast/core/static_string.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+namespace beast {
+namespace http {
+
+/// The type of string holding a formatted HTTP date.
+using date_string_type = static_string<29>;
+
+namespace detail {
+
+/*  Format a time as an IMF-fixdate, for example
+    "Sun, 06 Nov 1994 08:49:37 GMT" (RFC 7231 section 7.1.1.1).
+
+    The time is the number of seconds since the epoch, which
+    must not be negative. Exactly 29 characters are written,
+    without a null terminator.
+*/
+template<class = void>
+void
+format_date(char* out, std::int64_t t)
+{
+    static char const days[] = "SunMonTueWedThuFriSat";
+    static char const months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    auto const two =
+        [&](unsigned v)
+        {
+            *out++ = static_cast<char>('0' + v / 10);
+            *out++ = static_cast<char>('0' + v % 10);
+        };
+    auto const secs = static_cast<unsigned>(t % 86400);
+    auto z = t / 86400;
+    // 1970-01-01 was a Thursday
+    auto const wday = static_cast<unsigned>((z + 4) % 7);
+
+    // Convert days to a civil date, from
+    // http://howardhinnant.github.io/date_algorithms.html
+    z += 719468;
+    auto const era = z / 146097;
+    auto const doe = static_cast<unsigned>(z - era * 146097);
+    auto const yoe =
+        (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    auto const doy = doe - (365*yoe + yoe/4 - yoe/100);
+    auto const mp = (5*doy + 2) / 153;
+    auto const day = doy - (153*mp + 2)/5 + 1;
+    auto const month = mp < 10 ? mp + 3 : mp - 9;
+    auto const year = static_cast<unsigned>(
+        era * 400 + yoe + (month <= 2 ? 1 : 0));
+
+    std::memcpy(out, &days[3 * wday], 3);
+    out += 3;
+    *out++ = ',';
+    *out++ = ' ';
+    two(day);
+    *out++ = ' ';
+    std::memcpy(out, &months[3 * (month - 1)], 3);
+    out += 3;
+    *out++ = ' ';
+    two(year / 100);
+    two(year % 100);
+    *out++ = ' ';
+    two(secs / 3600);
+    *out++ = ':';
+    two(secs / 60 % 60);
+    *out++ = ':';
+    two(secs % 60);
+    std::memcpy(out, " GMT", 4);
+}
+
+/*  Holds the formatted date for the current second.
+
+    The first thread to see that the second has changed
+    formats the new date. The characters are kept in atomic
+    words guarded by a sequence number, so readers never
+    block and never observe a partially written date.
+*/
+class date_cache
+{
+    static std::size_t constexpr words = 4;
+
+    std::atomic<std::int64_t> sec_;
+    std::atomic<unsigned> seq_;
+    std::atomic<std::uint64_t> buf_[words];
+
+public:
+    explicit
+    date_cache(std::int64_t now)
+        : sec_(now)
+        , seq_(0)
+    {
+        store(now);
+    }
+
+    void
+    get(date_string_type& s, std::int64_t now)
+    {
+        auto prev = sec_.load(std::memory_order_relaxed);
+        if(prev != now && sec_.compare_exchange_strong(
+                prev, now, std::memory_order_relaxed))
+            update(now);
+        load(s);
+    }
+
+private:
+    void
+    update(std::int64_t now)
+    {
+        auto seq = seq_.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            if((seq & 1) == 0 && seq_.compare_exchange_weak(
+                    seq, seq + 1, std::memory_order_relaxed))
+                break;
+            seq = seq_.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        // A later second may have been stored already
+        if(sec_.load(std::memory_order_relaxed) == now)
+            store(now);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    void
+    store(std::int64_t now)
+    {
+        std::uint64_t w[words] = {};
+        format_date(reinterpret_cast<char*>(&w[0]), now);
+        for(std::size_t i = 0; i < words; ++i)
+            buf_[i].store(w[i], std::memory_order_relaxed);
+    }
+
+    void
+    load(date_string_type& s)
+    {
+        std::uint64_t w[words];
+        for(;;)
+        {
+            auto const seq =
+                seq_.load(std::memory_order_acquire);
+            if((seq & 1) != 0)
+                continue;
+            for(std::size_t i = 0; i < words; ++i)
+                w[i] = buf_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(seq_.load(std::memory_order_relaxed) == seq)
+                break;
+        }
+        s.assign(reinterpret_cast<char const*>(&w[0]),
+            s.max_size());
+    }
+};
+
+inline
+std::int64_t
+seconds_since_epoch()
+{
+    return static_cast<std::int64_t>(
+        std::chrono::system_clock::to_time_t(
+            std::chrono::system_clock::now()));
+}
+
+} // detail
+
+/** Returns the current date formatted for the HTTP Date field.
+
+    The string is an IMF-fixdate as described in RFC 7231
+    section 7.1.1.1, for example "Sun, 06 Nov 1994 08:49:37 GMT".
+
+    The date is formatted at most once per second, by the first
+    thread to call this function after the second changes, and
+    is copied from a cache otherwise. No memory is allocated,
+    and no locks are taken.
+
+    @par Example
+    @code
+        response<string_body> res;
+        ...
+        res.fields.insert("Date", date_string());
+    @endcode
+
+    @par Thread Safety
+    This function may be called concurrently.
+*/
+inline
+date_string_type
+date_string()
+{
+    static detail::date_cache cache{
+        detail::seconds_since_epoch()};
+    date_string_type s;
+    cache.get(s, detail::seconds_since_epoch());
+    return s;
+}
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,607 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DEFLATE_BODY_HPP
+#define BEAST_HTTP_DEFLATE_BODY_HPP
+
+#include <beast/core/error.hpp>
+#include <beast/http/concepts.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/resume_context.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+#include <beast/zlib/detail/checksum.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/logic/tribool.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** A Body adapter which applies a deflate based content coding.
+
+    This wraps another Body, whose `value_type` becomes the type of
+    the message body. When the message is serialized, the buffers
+    produced by the wrapped writer are compressed incrementally with
+    @ref zlib::deflate_stream and framed in the zlib (rfc1950) or
+    gzip (rfc1952) format. Only a small, fixed amount of compressed
+    output is held at any time, regardless of the size of the body.
+
+    The writer does not report a content length, so calling
+    @ref prepare on the message selects chunked framing for HTTP/1.1
+    and sets the Content-Encoding field.
+
+    When a message is parsed, the reader inflates the body before
+    passing it to the wrapped reader, if the Content-Encoding field
+    names the coding. A message without a Content-Encoding field, or
+    with the value "identity", is passed through unchanged. A coded
+    body which ends before the trailer fails with
+    `zlib::error::stream_error`.
+
+    The wrapped reader and writer must be constructible from any
+    message whose body has their `value_type`, as is the case for
+    the bodies provided with the library.
+
+    @note Use @ref deflate_body or @ref gzip_body instead of naming
+    this type directly.
+
+    @tparam Body The wrapped body.
+
+    @tparam isGzip `true` for the gzip coding, `false` for deflate.
+*/
+template<class Body, bool isGzip>
+struct basic_deflate_body
+{
+    /// The type of the `message::body` member
+    using value_type = typename Body::value_type;
+
+    /// Returns the value of the Content-Encoding field.
+    static
+    char const*
+    content_encoding()
+    {
+        return isGzip ? "gzip" : "deflate";
+    }
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class reader
+    {
+        enum state
+        {
+            s_head,
+            s_xlen,
+            s_extra,
+            s_name,
+            s_comment,
+            s_hcrc,
+            s_body,
+            s_trailer,
+            s_done
+        };
+
+        static std::size_t constexpr head_size = isGzip ? 10 : 2;
+        static std::size_t constexpr trailer_size = isGzip ? 8 : 4;
+        static std::size_t constexpr capacity = 16384;
+
+        typename Body::reader r_;
+        boost::optional<zlib::inflate_stream> is_;
+        std::unique_ptr<std::uint8_t[]> buf_;
+        std::uint8_t hdr_[10];
+        std::uint8_t flags_ = 0;
+        std::size_t have_ = 0;
+        std::size_t skip_ = 0;
+        std::uint32_t check_ = isGzip ? 0 : 1;
+        std::uint32_t size_ = 0;
+        state s_ = s_head;
+        bool identity_;
+
+    public:
+        template<bool isRequest, class Fields>
+        explicit
+        reader(message<isRequest,
+                basic_deflate_body, Fields>& m) noexcept
+            : r_(m)
+            , identity_(m.fields["Content-Encoding"].empty() ||
+                beast::detail::ci_equal(
+                    m.fields["Content-Encoding"], "identity"))
+        {
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            r_.init(ec);
+            if(ec || identity_)
+                return;
+            try
+            {
+                is_.emplace();
+                buf_.reset(new std::uint8_t[capacity]);
+            }
+            catch(std::bad_alloc const&)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+            }
+        }
+
+        void
+        write(void const* data,
+            std::size_t size, error_code& ec) noexcept
+        {
+            if(identity_)
+                return r_.write(data, size, ec);
+            auto p = reinterpret_cast<std::uint8_t const*>(data);
+            while(size > 0)
+            {
+                switch(s_)
+                {
+                case s_head:
+                {
+                    auto const n = (std::min)(
+                        size, head_size - have_);
+                    std::memcpy(&hdr_[have_], p, n);
+                    have_ += n;
+                    p += n;
+                    size -= n;
+                    if(have_ < head_size)
+                        break;
+                    have_ = 0;
+                    if(! parse_head(ec))
+                        return;
+                    break;
+                }
+
+                case s_xlen:
+                    hdr_[have_++] = *p++;
+                    --size;
+                    if(have_ < 2)
+                        break;
+                    have_ = 0;
+                    skip_ = hdr_[0] | (hdr_[1] << 8);
+                    s_ = s_extra;
+                    break;
+
+                case s_extra:
+                {
+                    auto const n = (std::min)(size, skip_);
+                    p += n;
+                    size -= n;
+                    skip_ -= n;
+                    if(skip_ == 0)
+                        next_field();
+                    break;
+                }
+
+                case s_name:
+                case s_comment:
+                    --size;
+                    if(*p++ == 0)
+                        next_field();
+                    break;
+
+                case s_hcrc:
+                {
+                    auto const n = (std::min)(size, skip_);
+                    p += n;
+                    size -= n;
+                    skip_ -= n;
+                    if(skip_ == 0)
+                        s_ = s_body;
+                    break;
+                }
+
+                case s_body:
+                {
+                    zlib::z_params zs;
+                    zs.next_in = p;
+                    zs.avail_in = size;
+                    zs.next_out = buf_.get();
+                    zs.avail_out = capacity;
+                    is_->write(zs, zlib::Flush::none, ec);
+                    auto const n = capacity - zs.avail_out;
+                    if(ec == zlib::error::end_of_stream)
+                    {
+                        ec = {};
+                        s_ = s_trailer;
+                    }
+                    else if(ec == zlib::error::need_buffers)
+                    {
+                        ec = {};
+                    }
+                    else if(ec)
+                    {
+                        return;
+                    }
+                    if(n > 0)
+                    {
+                        check_ = isGzip ?
+                            zlib::detail::crc32(check_, buf_.get(), n) :
+                            zlib::detail::adler32(check_, buf_.get(), n);
+                        size_ += static_cast<std::uint32_t>(n);
+                        r_.write(buf_.get(), n, ec);
+                        if(ec)
+                            return;
+                    }
+                    p += size - zs.avail_in;
+                    size = zs.avail_in;
+                    break;
+                }
+
+                case s_trailer:
+                {
+                    auto const n = (std::min)(
+                        size, trailer_size - have_);
+                    std::memcpy(&hdr_[have_], p, n);
+                    have_ += n;
+                    p += n;
+                    size -= n;
+                    if(have_ < trailer_size)
+                        break;
+                    if(! check_trailer())
+                    {
+                        ec = zlib::error::incorrect_check;
+                        return;
+                    }
+                    s_ = s_done;
+                    break;
+                }
+
+                case s_done:
+                    // data after the end of the stream
+                    ec = zlib::error::stream_error;
+                    return;
+                }
+            }
+        }
+
+        void
+        finish(error_code& ec) noexcept
+        {
+            if(! identity_ && s_ != s_done)
+            {
+                // The body ended before the trailer
+                ec = zlib::error::stream_error;
+                return;
+            }
+            finish(detail::has_finish<
+                typename Body::reader>{}, ec);
+        }
+
+    private:
+        void
+        finish(std::true_type, error_code& ec)
+        {
+            r_.finish(ec);
+        }
+
+        void
+        finish(std::false_type, error_code&)
+        {
+        }
+
+        bool
+        parse_head(error_code& ec)
+        {
+            if(isGzip)
+            {
+                if(hdr_[0] != 0x1f || hdr_[1] != 0x8b ||
+                    hdr_[2] != 8 || (hdr_[3] & 0xe0) != 0)
+                {
+                    ec = zlib::error::invalid_header;
+                    return false;
+                }
+                flags_ = hdr_[3];
+                s_ = s_head;
+                next_field();
+                return true;
+            }
+            // preset dictionaries are not supported
+            if((hdr_[0] & 0x0f) != 8 || (hdr_[0] >> 4) > 7 ||
+                ((hdr_[0] << 8) | hdr_[1]) % 31 != 0 ||
+                (hdr_[1] & 0x20) != 0)
+            {
+                ec = zlib::error::invalid_header;
+                return false;
+            }
+            s_ = s_body;
+            return true;
+        }
+
+        // Advance to the next optional gzip header
+        // field which is present.
+        void
+        next_field()
+        {
+            switch(s_)
+            {
+            case s_head:
+                if(flags_ & 0x04)
+                {
+                    s_ = s_xlen;
+                    return;
+                }
+                // fall through
+            case s_xlen:
+            case s_extra:
+                if(flags_ & 0x08)
+                {
+                    s_ = s_name;
+                    return;
+                }
+                // fall through
+            case s_name:
+                if(flags_ & 0x10)
+                {
+                    s_ = s_comment;
+                    return;
+                }
+                // fall through
+            case s_comment:
+                if(flags_ & 0x02)
+                {
+                    skip_ = 2;
+                    s_ = s_hcrc;
+                    return;
+                }
+                // fall through
+            default:
+                s_ = s_body;
+                break;
+            }
+        }
+
+        bool
+        check_trailer() const
+        {
+            if(isGzip)
+                return get32le(&hdr_[0]) == check_ &&
+                    get32le(&hdr_[4]) == size_;
+            return (
+                (std::uint32_t{hdr_[0]} << 24) |
+                (std::uint32_t{hdr_[1]} << 16) |
+                (std::uint32_t{hdr_[2]} <<  8) |
+                 std::uint32_t{hdr_[3]}) == check_;
+        }
+
+        static
+        std::uint32_t
+        get32le(std::uint8_t const* p)
+        {
+            return
+                 std::uint32_t{p[0]} |
+                (std::uint32_t{p[1]} <<  8) |
+                (std::uint32_t{p[2]} << 16) |
+                (std::uint32_t{p[3]} << 24);
+        }
+    };
+
+    class writer
+    {
+        class write_function
+        {
+            writer& self_;
+
+        public:
+            explicit
+            write_function(writer& self)
+                : self_(self)
+            {
+            }
+
+            template<class ConstBufferSequence>
+            void
+            operator()(ConstBufferSequence const& buffers) const
+            {
+                for(auto const& b : buffers)
+                    self_.in_.emplace_back(b);
+            }
+        };
+
+        static std::size_t constexpr capacity = 16384;
+
+        typename Body::writer w_;
+        boost::optional<zlib::deflate_stream> ds_;
+        std::unique_ptr<std::uint8_t[]> buf_;
+        std::vector<boost::asio::const_buffer> in_;
+        std::size_t pos_ = 0;
+        std::size_t n_ = 0;
+        std::uint32_t check_ = isGzip ? 0 : 1;
+        std::uint32_t size_ = 0;
+        bool more_ = true;
+        bool finished_ = false;
+
+    public:
+        template<bool isRequest, class Fields>
+        explicit
+        writer(message<isRequest,
+                basic_deflate_body, Fields> const& m) noexcept
+            : w_(m)
+        {
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            w_.init(ec);
+            if(ec)
+                return;
+            try
+            {
+                ds_.emplace();
+                buf_.reset(new std::uint8_t[capacity]);
+                in_.reserve(8);
+            }
+            catch(std::bad_alloc const&)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+                return;
+            }
+            if(isGzip)
+            {
+                // no name, no time stamp, unknown OS
+                static std::uint8_t constexpr head[] = {
+                    0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+                std::memcpy(buf_.get(), head, sizeof(head));
+                n_ = sizeof(head);
+            }
+            else
+            {
+                // 32K window, default compression level
+                buf_[0] = 0x78;
+                buf_[1] = 0x9c;
+                n_ = 2;
+            }
+        }
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&& rc, error_code& ec,
+            WriteFunction&& wf) noexcept
+        {
+            using boost::asio::buffer_cast;
+            using boost::asio::buffer_size;
+            for(;;)
+            {
+                if(n_ == capacity)
+                {
+                    // output is full
+                    wf(boost::asio::const_buffers_1{
+                        buf_.get(), n_});
+                    n_ = 0;
+                    return false;
+                }
+                if(pos_ < in_.size())
+                {
+                    auto const& b = in_[pos_];
+                    auto const data =
+                        buffer_cast<std::uint8_t const*>(b);
+                    zlib::z_params zs;
+                    zs.next_in = data;
+                    zs.avail_in = buffer_size(b);
+                    zs.next_out = buf_.get() + n_;
+                    zs.avail_out = capacity - n_;
+                    ds_->write(zs, zlib::Flush::none, ec);
+                    if(ec == zlib::error::need_buffers)
+                        ec = {};
+                    else if(ec)
+                        return true;
+                    auto const used = zs.total_in;
+                    check_ = isGzip ?
+                        zlib::detail::crc32(check_, data, used) :
+                        zlib::detail::adler32(check_, data, used);
+                    size_ += static_cast<std::uint32_t>(used);
+                    n_ += zs.total_out;
+                    if(zs.avail_in == 0)
+                        ++pos_;
+                    else
+                        in_[pos_] = b + used;
+                    continue;
+                }
+                if(more_)
+                {
+                    in_.clear();
+                    pos_ = 0;
+                    boost::tribool const result = w_.write(
+                        std::move(rc), ec, write_function{*this});
+                    if(ec)
+                        return true;
+                    if(boost::indeterminate(result))
+                        return result;
+                    if(result)
+                        more_ = false;
+                    continue;
+                }
+                if(! finished_)
+                {
+                    zlib::z_params zs;
+                    zs.avail_in = 0;
+                    zs.next_out = buf_.get() + n_;
+                    zs.avail_out = capacity - n_;
+                    ds_->write(zs, zlib::Flush::finish, ec);
+                    n_ += zs.total_out;
+                    if(ec == zlib::error::end_of_stream)
+                        finished_ = true;
+                    else if(ec && ec != zlib::error::need_buffers)
+                        return true;
+                    ec = {};
+                    continue;
+                }
+                if(capacity - n_ < 8)
+                {
+                    // make room for the trailer
+                    wf(boost::asio::const_buffers_1{
+                        buf_.get(), n_});
+                    n_ = 0;
+                    return false;
+                }
+                if(isGzip)
+                {
+                    put32le(check_);
+                    put32le(size_);
+                }
+                else
+                {
+                    buf_[n_++] = static_cast<std::uint8_t>(check_ >> 24);
+                    buf_[n_++] = static_cast<std::uint8_t>(check_ >> 16);
+                    buf_[n_++] = static_cast<std::uint8_t>(check_ >>  8);
+                    buf_[n_++] = static_cast<std::uint8_t>(check_);
+                }
+                wf(boost::asio::const_buffers_1{
+                    buf_.get(), n_});
+                return true;
+            }
+        }
+
+    private:
+        void
+        put32le(std::uint32_t v)
+        {
+            buf_[n_++] = static_cast<std::uint8_t>(v);
+            buf_[n_++] = static_cast<std::uint8_t>(v >>  8);
+            buf_[n_++] = static_cast<std::uint8_t>(v >> 16);
+            buf_[n_++] = static_cast<std::uint8_t>(v >> 24);
+        }
+    };
+};
+
+/** A Body adapter which applies the deflate content coding.
+
+    The body is sent in the zlib format (rfc1950), with the
+    Content-Encoding field set to "deflate".
+
+    @see basic_deflate_body
+*/
+template<class Body>
+using deflate_body = basic_deflate_body<Body, false>;
+
+/** A Body adapter which applies the gzip content coding.
+
+    The body is sent in the gzip format (rfc1952), with the
+    Content-Encoding field set to "gzip".
+
+    @see basic_deflate_body
+*/
+template<class Body>
+using gzip_body = basic_deflate_body<Body, true>;
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,489 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_FILE_BODY_HPP
+#define BEAST_HTTP_FILE_BODY_HPP
+
+#include <beast/core/async_completion.hpp>
+#include <beast/core/error.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/resume_context.hpp>
+#include <beast/http/write.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/logic/tribool.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/*  When non-zero, file_body maps regular files into memory
+    instead of reading them through a buffer. This defaults
+    to on for POSIX systems.
+*/
+#ifndef BEAST_HTTP_FILE_BODY_MMAP
+# if defined(__unix__) || defined(__APPLE__)
+#  define BEAST_HTTP_FILE_BODY_MMAP 1
+# else
+#  define BEAST_HTTP_FILE_BODY_MMAP 0
+# endif
+#endif
+
+/*  When non-zero, responses with a file_body written to a TCP
+    socket are sent with sendfile. This defaults to on for Linux.
+*/
+#ifndef BEAST_HTTP_FILE_BODY_SENDFILE
+# if defined(__linux__) && BEAST_HTTP_FILE_BODY_MMAP
+#  define BEAST_HTTP_FILE_BODY_SENDFILE 1
+# else
+#  define BEAST_HTTP_FILE_BODY_SENDFILE 0
+# endif
+#endif
+
+#if BEAST_HTTP_FILE_BODY_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#if BEAST_HTTP_FILE_BODY_SENDFILE
+# include <sys/sendfile.h>
+#endif
+
+namespace beast {
+namespace http {
+
+/** A Body which stores its contents in a file.
+
+    The `message::body` member holds the path of the file. When
+    a message is serialized the file is opened for reading and the
+    `Content-Length` is set from the size of the file. When a
+    message is parsed the file is created, or truncated, and the
+    body is written to it through a buffer of
+    @ref file_body::buffer_size bytes, so the memory used does
+    not depend on the size of the body.
+
+    On Linux, a response written with @ref write or @ref async_write
+    directly to a `boost::asio::ip::tcp::socket` sends the file with
+    `sendfile`, so the contents go from the page cache to the socket
+    without passing through user space. Chunked responses, and all
+    other streams such as `boost::asio::ssl::stream`, use the
+    writer below.
+
+    On POSIX systems the writer maps a regular file into memory and
+    presents the mapping to the serializer as a single buffer, so
+    there are no intermediate copies or per-chunk read calls. Files
+    which cannot be mapped, and all files on systems without `mmap`,
+    are read sequentially through a buffer of
+    @ref file_body::buffer_size bytes.
+
+    Only files whose size is known in advance can be sent. The
+    writer fails with `errc::not_supported` for FIFOs, devices,
+    directories, and files which report a size of zero but have
+    contents, such as those in `/proc`.
+
+    Meets the requirements of @b `Body`.
+
+    @note The parser limits the size of request bodies by default.
+    Use the @ref body_max_size option to receive larger bodies.
+
+    @note The file must not be truncated while a mapped file is
+    being sent, or the process will receive `SIGBUS`. Define
+    `BEAST_HTTP_FILE_BODY_MMAP` to zero to always use buffered
+    reads, or `BEAST_HTTP_FILE_BODY_SENDFILE` to zero to always
+    use the writer.
+*/
+struct file_body
+{
+    /// The type of the `message::body` member
+    using value_type = std::string;
+
+    /// The size of the buffer used when the file is not mapped.
+    static std::size_t constexpr buffer_size = 65536;
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    static
+    error_code
+    errno_code()
+    {
+        return boost::system::errc::make_error_code(
+            static_cast<boost::system::errc::errc_t>(errno));
+    }
+
+#if BEAST_HTTP_FILE_BODY_MMAP
+    // Open a file to send, returning the descriptor and setting
+    // `size`. Only regular files have a size known in advance.
+    // Files which report a size of zero while having contents,
+    // such as those in /proc, are rejected as well.
+    static
+    int
+    open_file(std::string const& path,
+        std::uint64_t& size, error_code& ec)
+    {
+        // Opening a FIFO without O_NONBLOCK waits for a writer
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK);
+        if(fd < 0)
+        {
+            ec = errno_code();
+            return -1;
+        }
+        struct stat st;
+        if(::fstat(fd, &st) != 0)
+        {
+            ec = errno_code();
+            ::close(fd);
+            return -1;
+        }
+        if(! S_ISREG(st.st_mode))
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_supported);
+            ::close(fd);
+            return -1;
+        }
+        size = static_cast<std::uint64_t>(st.st_size);
+        if(size == 0)
+        {
+            char c;
+            auto const n = ::read(fd, &c, 1);
+            if(n != 0)
+            {
+                ec = n < 0 ? errno_code() :
+                    boost::system::errc::make_error_code(
+                        boost::system::errc::not_supported);
+                ::close(fd);
+                return -1;
+            }
+        }
+        return fd;
+    }
+#endif
+
+    class reader
+    {
+        value_type const& path_;
+        std::FILE* file_ = nullptr;
+        std::unique_ptr<char[]> buf_;
+
+    public:
+        reader(reader const&) = delete;
+        reader& operator=(reader const&) = delete;
+
+        reader(reader&& other) noexcept
+            : path_(other.path_)
+            , file_(other.file_)
+            , buf_(std::move(other.buf_))
+        {
+            other.file_ = nullptr;
+        }
+
+        template<bool isRequest, class Body, class Fields>
+        explicit
+        reader(message<isRequest, Body, Fields>& m) noexcept
+            : path_(m.body)
+        {
+        }
+
+        ~reader()
+        {
+            if(file_)
+                std::fclose(file_);
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            file_ = std::fopen(path_.c_str(), "wb");
+            if(! file_)
+            {
+                ec = errno_code();
+                return;
+            }
+            // Without a buffer writes go through the stdio default
+            buf_.reset(new(std::nothrow) char[buffer_size]);
+            if(buf_)
+                std::setvbuf(file_, buf_.get(), _IOFBF, buffer_size);
+        }
+
+        void
+        write(void const* data,
+            std::size_t size, error_code& ec) noexcept
+        {
+            if(std::fwrite(data, 1, size, file_) != size)
+                ec = errno_code();
+        }
+
+        void
+        finish(error_code& ec) noexcept
+        {
+            if(! file_)
+                return;
+            auto const file = file_;
+            file_ = nullptr;
+            if(std::fclose(file) != 0)
+                ec = errno_code();
+        }
+    };
+
+    class writer
+    {
+        value_type const& path_;
+        std::uint64_t size_ = 0;
+        std::uint64_t offset_ = 0;
+        void const* map_ = nullptr;
+        std::FILE* file_ = nullptr;
+        std::unique_ptr<char[]> buf_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Body, class Fields>
+        explicit
+        writer(message<isRequest,
+                Body, Fields> const& m) noexcept
+            : path_(m.body)
+        {
+        }
+
+        ~writer()
+        {
+#if BEAST_HTTP_FILE_BODY_MMAP
+            if(map_)
+                ::munmap(const_cast<void*>(map_),
+                    static_cast<std::size_t>(size_));
+#endif
+            if(file_)
+                std::fclose(file_);
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+#if BEAST_HTTP_FILE_BODY_MMAP
+            if(map(ec) || ec)
+                return;
+#endif
+            if(! file_)
+            {
+                file_ = std::fopen(path_.c_str(), "rb");
+                if(! file_)
+                {
+                    ec = errno_code();
+                    return;
+                }
+                if(std::fseek(file_, 0, SEEK_END) != 0)
+                {
+                    ec = errno_code();
+                    return;
+                }
+                auto const size = std::ftell(file_);
+                if(size < 0)
+                {
+                    ec = errno_code();
+                    return;
+                }
+                size_ = static_cast<std::uint64_t>(size);
+                std::rewind(file_);
+            }
+            // Files such as those in /proc report a size of zero
+            // while having contents, which cannot be sent with a
+            // Content-Length.
+            if(size_ == 0 && std::fgetc(file_) != EOF)
+            {
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_supported);
+                return;
+            }
+            buf_.reset(new(std::nothrow) char[buffer_size]);
+            if(! buf_)
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::not_enough_memory);
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return size_;
+        }
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&&, error_code& ec,
+            WriteFunction&& wf) noexcept
+        {
+            if(map_)
+            {
+                wf(boost::asio::const_buffers_1{map_,
+                    static_cast<std::size_t>(size_)});
+                return true;
+            }
+            auto const n = static_cast<std::size_t>((std::min)(
+                static_cast<std::uint64_t>(buffer_size),
+                    size_ - offset_));
+            if(n > 0 && std::fread(
+                buf_.get(), 1, n, file_) != n)
+            {
+                // short read, the file shrank or failed
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return true;
+            }
+            offset_ += n;
+            wf(boost::asio::const_buffers_1{buf_.get(), n});
+            return offset_ >= size_;
+        }
+
+    private:
+#if BEAST_HTTP_FILE_BODY_MMAP
+        // Returns `true` if the file was mapped. Otherwise,
+        // if no error is set, `file_` is open for reading.
+        bool
+        map(error_code& ec)
+        {
+            auto const fd = open_file(path_, size_, ec);
+            if(ec)
+                return false;
+            if(size_ > 0 &&
+                size_ <= (std::numeric_limits<std::size_t>::max)())
+            {
+                auto const p = ::mmap(nullptr,
+                    static_cast<std::size_t>(size_),
+                        PROT_READ, MAP_PRIVATE, fd, 0);
+                if(p != MAP_FAILED)
+                {
+                    ::madvise(p, static_cast<std::size_t>(size_),
+                        MADV_SEQUENTIAL);
+                    ::close(fd);
+                    map_ = p;
+                    return true;
+                }
+            }
+            // fall back to buffered reads
+            file_ = ::fdopen(fd, "rb");
+            if(! file_)
+            {
+                ec = errno_code();
+                ::close(fd);
+            }
+            return false;
+        }
+#endif
+    };
+};
+
+#if BEAST_HTTP_FILE_BODY_SENDFILE || GENERATING_DOCS
+
+namespace detail {
+
+template<class Stream>
+using is_tcp_socket = std::is_base_of<
+    boost::asio::ip::tcp::socket, Stream>;
+
+} // detail
+
+/** Write a HTTP/1 response with a @ref file_body to a TCP socket.
+
+    This overload of @ref write sends the header, then sends the
+    file directly from the page cache to the socket with `sendfile`.
+    The call will block until the entire message is written or an
+    error occurs. A chunked response is written by the general
+    overload, through the writer.
+
+    It is used only when the stream is a TCP socket, since the file
+    is written to the socket's descriptor. Streams which transform
+    the data, such as `boost::asio::ssl::stream`, use the writer.
+
+    If the semantics of the message indicate that the connection
+    should be closed after the message is sent, the error returned
+    from this function will be `boost::asio::error::eof`.
+
+    @param stream The socket to which the data is to be written.
+
+    @param msg The message to write.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream, class Fields>
+#if GENERATING_DOCS
+void
+#else
+typename std::enable_if<
+    detail::is_tcp_socket<SyncWriteStream>::value>::type
+#endif
+write(SyncWriteStream& stream,
+    message<false, file_body, Fields> const& msg,
+        error_code& ec);
+
+/** Write a HTTP/1 response with a @ref file_body to a TCP socket asynchronously.
+
+    This overload of @ref async_write sends the header, then sends
+    the file directly from the page cache to the socket with
+    `sendfile`, waiting for the socket to become writable whenever
+    its send buffer is full. A chunked response is written by the
+    general overload, through the writer.
+
+    It is used only when the stream is a TCP socket, since the file
+    is written to the socket's descriptor. Streams which transform
+    the data, such as `boost::asio::ssl::stream`, use the writer.
+    The program must ensure that the socket performs no other write
+    operations until this operation completes.
+
+    If the semantics of the message indicate that the connection
+    should be closed after the message is sent, the operation will
+    complete with the error set to `boost::asio::error::eof`.
+
+    @param stream The socket to which the data is to be written.
+
+    @param msg The message to write. The object must remain valid
+    at least until the completion handler is called; ownership is
+    not transferred.
+
+    @param handler The handler to be called when the operation
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncWriteStream, class Fields, class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename std::enable_if<
+    detail::is_tcp_socket<AsyncWriteStream>::value,
+    typename async_completion<
+        WriteHandler, void(error_code)>::result_type>::type
+#endif
+async_write(AsyncWriteStream& stream,
+    message<false, file_body, Fields> const& msg,
+        WriteHandler&& handler);
+
+#endif
+
+} // http
+} // beast
+
+#if BEAST_HTTP_FILE_BODY_SENDFILE
+#include <beast/http/impl/file_body.ipp>
+#endif
+
+#endif
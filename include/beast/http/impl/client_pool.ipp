@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_CLIENT_POOL_IPP
+#define BEAST_HTTP_IMPL_CLIENT_POOL_IPP
+
+#include <beast/http/parse.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <boost/assert.hpp>
+#include <boost/optional.hpp>
+
+namespace beast {
+namespace http {
+
+template<class ReqBody, class ResBody,
+    class Fields, class Handler>
+class client_pool::request_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    using parser_type =
+        parser_v1<false, ResBody, Fields>;
+
+    struct data
+    {
+        client_pool& pool;
+        endpoint_type ep;
+        request<ReqBody, Fields> const& req;
+        response<ResBody, Fields>& res;
+        Handler h;
+        std::unique_ptr<connection> c;
+        boost::optional<parser_type> p;
+        bool retried = false;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, client_pool& pool_,
+            endpoint_type const& ep_,
+                request<ReqBody, Fields> const& req_,
+                    response<ResBody, Fields>& res_)
+            : pool(pool_)
+            , ep(ep_)
+            , req(req_)
+            , res(res_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    request_op(request_op&&) = default;
+    request_op(request_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    request_op(DeducedHandler&& h,
+            client_pool& pool, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), pool,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, false);
+    }
+
+    void
+    operator()(error_code ec, bool again = true);
+
+    void
+    operator()(connection* c);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, request_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, request_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(request_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, request_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+
+private:
+    // Returns `true` if the failed request
+    // should be sent again on a new connection.
+    bool
+    should_retry(error_code const& ec)
+    {
+        auto& d = *d_;
+        if(! d.c->reused || d.retried)
+            return false;
+        // The server may have acted on the request before
+        // closing, so only idempotent requests are sent
+        // again (rfc7230 section 6.3.1).
+        auto const& m = d.req.method;
+        if(m != "GET" && m != "HEAD" && m != "PUT" &&
+                m != "DELETE" && m != "OPTIONS" && m != "TRACE")
+            return false;
+        return
+            ec == boost::asio::error::eof ||
+            ec == boost::asio::error::connection_reset ||
+            ec == boost::asio::error::connection_aborted ||
+            ec == boost::asio::error::broken_pipe;
+    }
+};
+
+template<class ReqBody, class ResBody,
+    class Fields, class Handler>
+void
+client_pool::request_op<ReqBody, ResBody, Fields, Handler>::
+operator()(connection* c)
+{
+    // A connection was handed over by a
+    // request which finished with it.
+    auto& d = *d_;
+    BOOST_ASSERT(d.state == 1);
+    if(! c)
+    {
+        // The pool was closed
+        d.state = 99;
+        return (*this)(boost::asio::error::operation_aborted);
+    }
+    d.c.reset(c);
+    d.state = 2;
+    (*this)(error_code{});
+}
+
+template<class ReqBody, class ResBody,
+    class Fields, class Handler>
+void
+client_pool::request_op<ReqBody, ResBody, Fields, Handler>::
+operator()(error_code ec, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+        {
+            auto self = *this;
+            d.c = d.pool.acquire(d.ep,
+                [self](connection* c) mutable
+                {
+                    auto& ios = self.d_->pool.ios_;
+                    ios.post(bind_handler(std::move(self), c));
+                });
+            if(! d.c)
+            {
+                // wait for a connection
+                d.state = 1;
+                return;
+            }
+            d.state = 2;
+            break;
+        }
+
+        case 2:
+            if(d.c->sock.is_open())
+            {
+                d.state = 4;
+                break;
+            }
+            // connect
+            d.state = 3;
+            d.c->sock.async_connect(d.ep, std::move(*this));
+            return;
+
+        // connected
+        case 3:
+            if(ec)
+            {
+                d.state = 98;
+                break;
+            }
+            ++d.pool.connects_;
+            d.c->sock.set_option(
+                boost::asio::ip::tcp::no_delay{true}, ec);
+            d.state = 4;
+            break;
+
+        case 4:
+            if(d.c->reused)
+                ++d.pool.reuses_;
+            // write the request
+            d.state = 5;
+            async_write(d.c->sock, d.req, std::move(*this));
+            return;
+
+        case 5:
+            // A request indicating the connection
+            // will close is written with eof.
+            if(ec == boost::asio::error::eof)
+                ec = {};
+            if(ec)
+            {
+                d.state = 97;
+                break;
+            }
+            // read the response
+            d.p.emplace();
+            if(d.req.method == "HEAD")
+                d.p->set_option(skip_body{true});
+            d.state = 6;
+            async_parse(d.c->sock, d.c->sb,
+                *d.p, std::move(*this));
+            return;
+
+        case 6:
+        {
+            if(ec)
+            {
+                d.state = 97;
+                break;
+            }
+            auto const keep =
+                d.p->keep_alive() && is_keep_alive(d.req);
+            d.res = d.p->release();
+            d.p = boost::none;
+            d.pool.release(std::move(d.c), keep);
+            // call handler
+            d.state = 99;
+            break;
+        }
+
+        // failed on the connection
+        case 97:
+            if(should_retry(ec))
+            {
+                // The server closed the idle
+                // connection, try a new one.
+                d.retried = true;
+                d.p = boost::none;
+                d.c->sock.close(ec);
+                ec = {};
+                d.c->sb.consume(d.c->sb.size());
+                d.c->reused = false;
+                d.state = 2;
+                break;
+            }
+            d.state = 98;
+            break;
+
+        // give up the connection
+        case 98:
+            d.p = boost::none;
+            d.pool.release(std::move(d.c), false);
+            // call handler
+            d.state = 99;
+            break;
+        }
+    }
+    d.h(ec);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+client_pool::
+client_pool(boost::asio::io_service& ios,
+        std::size_t limit)
+    : ios_(ios)
+    , limit_(limit)
+{
+    BOOST_ASSERT(limit_ > 0);
+}
+
+inline
+client_pool::
+~client_pool()
+{
+    close();
+}
+
+inline
+std::size_t
+client_pool::
+idle(endpoint_type const& ep) const
+{
+    auto const it = hosts_.find(ep);
+    if(it == hosts_.end())
+        return 0;
+    return it->second.idle.size();
+}
+
+inline
+void
+client_pool::
+close()
+{
+    for(auto& h : hosts_)
+    {
+        h.second.idle.clear();
+        auto waiters = std::move(h.second.waiters);
+        h.second.waiters.clear();
+        for(auto& w : waiters)
+            w(nullptr);
+    }
+}
+
+template<class ReqBody, class ResBody,
+    class Fields, class RequestHandler>
+typename async_completion<
+    RequestHandler, void(error_code)>::result_type
+client_pool::
+async_request(endpoint_type const& ep,
+    request<ReqBody, Fields> const& req,
+        response<ResBody, Fields>& res,
+            RequestHandler&& handler)
+{
+    beast::async_completion<RequestHandler,
+        void(error_code)> completion(handler);
+    request_op<ReqBody, ResBody, Fields,
+        decltype(completion.handler)>{completion.handler,
+            *this, ep, req, res};
+    return completion.result.get();
+}
+
+template<class Waiter>
+std::unique_ptr<client_pool::connection>
+client_pool::
+acquire(endpoint_type const& ep, Waiter&& w)
+{
+    auto& h = hosts_[ep];
+    if(! h.idle.empty())
+    {
+        std::unique_ptr<connection> c =
+            std::move(h.idle.back());
+        h.idle.pop_back();
+        ++h.active;
+        return c;
+    }
+    if(h.active + h.idle.size() < limit_)
+    {
+        ++h.active;
+        return std::unique_ptr<connection>{
+            new connection{ios_, ep}};
+    }
+    h.waiters.emplace_back(std::forward<Waiter>(w));
+    return nullptr;
+}
+
+inline
+void
+client_pool::
+release(std::unique_ptr<connection> c, bool keep)
+{
+    auto& h = hosts_[c->ep];
+    if(keep)
+        c->reused = true;
+    if(! h.waiters.empty())
+    {
+        // Hand the connection over to the
+        // request which has waited longest.
+        if(! keep)
+            c.reset(new connection{ios_, c->ep});
+        auto w = std::move(h.waiters.front());
+        h.waiters.pop_front();
+        w(c.release());
+        return;
+    }
+    --h.active;
+    if(keep)
+        h.idle.emplace_back(std::move(c));
+}
+
+} // http
+} // beast
+
+#endif
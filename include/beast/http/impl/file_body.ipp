@@ -0,0 +1,311 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_FILE_BODY_IPP
+#define BEAST_HTTP_IMPL_FILE_BODY_IPP
+
+#include <beast/http/rfc7230.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/write_dynabuf.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/write.hpp>
+#include <memory>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+template<class Fields>
+struct sendfile_preparation
+{
+    message<false, file_body, Fields> const& msg;
+    streambuf sb;
+    bool chunked;
+    bool close;
+    int fd = -1;
+    std::uint64_t size = 0;
+    std::uint64_t offset = 0;
+
+    explicit
+    sendfile_preparation(
+            message<false, file_body, Fields> const& msg_)
+        : msg(msg_)
+        , chunked(token_list{
+            msg.fields["Transfer-Encoding"]}.exists("chunked"))
+        , close(token_list{
+            msg.fields["Connection"]}.exists("close") ||
+                (msg.version < 11 && ! msg.fields.exists(
+                    "Content-Length")))
+    {
+    }
+
+    ~sendfile_preparation()
+    {
+        if(fd >= 0)
+            ::close(fd);
+    }
+
+    void
+    init(error_code& ec)
+    {
+        fd = file_body::open_file(msg.body, size, ec);
+        if(ec)
+            return;
+        write_start_line(sb, msg);
+        write_fields(sb, msg.fields);
+        beast::write(sb, "\r\n");
+    }
+
+    // Send the rest of the file, or as much of it as the socket
+    // accepts. Sets would_block if the socket is non-blocking
+    // and its send buffer is full.
+    void
+    send(int sock, error_code& ec)
+    {
+        // The most sendfile transfers in one call on Linux
+        std::uint64_t constexpr limit = 0x7ffff000;
+        while(offset < size)
+        {
+            auto off = static_cast<off_t>(offset);
+            auto const n = ::sendfile(sock, fd, &off,
+                static_cast<std::size_t>((std::min)(
+                    size - offset, limit)));
+            if(n < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                if(errno == EAGAIN || errno == EWOULDBLOCK)
+                    ec = boost::asio::error::would_block;
+                else
+                    ec = file_body::errno_code();
+                return;
+            }
+            if(n == 0)
+            {
+                // short read, the file shrank
+                ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return;
+            }
+            offset += static_cast<std::uint64_t>(n);
+        }
+    }
+};
+
+template<class Stream, class Handler, class Fields>
+class sendfile_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    struct data
+    {
+        Stream& s;
+        sendfile_preparation<Fields> wp;
+        Handler h;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_,
+                message<false, file_body, Fields> const& m_)
+            : s(s_)
+            , wp(m_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    sendfile_op(sendfile_op&&) = default;
+    sendfile_op(sendfile_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    sendfile_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, sendfile_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, sendfile_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(sendfile_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, sendfile_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class Handler, class Fields>
+void
+sendfile_op<Stream, Handler, Fields>::
+operator()(error_code ec, std::size_t, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+        {
+            d.wp.init(ec);
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), ec, 0, false));
+                return;
+            }
+            // write header
+            d.state = 1;
+            boost::asio::async_write(d.s,
+                d.wp.sb.data(), std::move(*this));
+            return;
+        }
+
+        case 1:
+            // sendfile must not block the io_service
+            if(! d.s.native_non_blocking())
+            {
+                d.s.native_non_blocking(true, ec);
+                if(ec)
+                    break;
+            }
+            d.state = 2;
+            break;
+
+        case 2:
+            d.wp.send(d.s.native_handle(), ec);
+            if(ec == boost::asio::error::would_block)
+            {
+                // wait until the socket is writable
+                ec = {};
+                d.s.async_write_some(
+                    boost::asio::null_buffers(), std::move(*this));
+                return;
+            }
+            if(ec)
+                break;
+            if(d.wp.close)
+            {
+                // VFALCO TODO Decide on an error code
+                ec = boost::asio::error::eof;
+            }
+            d.state = 99;
+            break;
+        }
+    }
+    d.h(ec);
+}
+
+} // detail
+
+template<class SyncWriteStream, class Fields>
+typename std::enable_if<
+    detail::is_tcp_socket<SyncWriteStream>::value>::type
+write(SyncWriteStream& stream,
+    message<false, file_body, Fields> const& msg,
+        error_code& ec)
+{
+    detail::sendfile_preparation<Fields> wp{msg};
+    if(wp.chunked)
+    {
+        // The general overload chunk-encodes the body
+        http::write<SyncWriteStream,
+            false, file_body, Fields>(stream, msg, ec);
+        return;
+    }
+    wp.init(ec);
+    if(ec)
+        return;
+    boost::asio::write(stream, wp.sb.data(), ec);
+    if(ec)
+        return;
+    for(;;)
+    {
+        wp.send(stream.native_handle(), ec);
+        if(ec != boost::asio::error::would_block)
+            break;
+        // The socket is non-blocking, wait until it is writable
+        ec = {};
+        stream.write_some(boost::asio::null_buffers(), ec);
+        if(ec)
+            return;
+    }
+    if(ec)
+        return;
+    if(wp.close)
+    {
+        // VFALCO TODO Decide on an error code
+        ec = boost::asio::error::eof;
+    }
+}
+
+template<class AsyncWriteStream, class Fields, class WriteHandler>
+typename std::enable_if<
+    detail::is_tcp_socket<AsyncWriteStream>::value,
+    typename async_completion<
+        WriteHandler, void(error_code)>::result_type>::type
+async_write(AsyncWriteStream& stream,
+    message<false, file_body, Fields> const& msg,
+        WriteHandler&& handler)
+{
+    if(token_list{msg.fields["Transfer-Encoding"]}.exists("chunked"))
+        // The general overload chunk-encodes the body
+        return http::async_write<AsyncWriteStream,
+            false, file_body, Fields>(stream, msg,
+                std::forward<WriteHandler>(handler));
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::sendfile_op<AsyncWriteStream,
+        decltype(completion.handler), Fields>{
+            completion.handler, stream, msg};
+    return completion.result.get();
+}
+
+} // http
+} // beast
+
+#endif
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_IMPL_MESSAGE_IPP
 
 #include <beast/core/error.hpp>
+#include <beast/core/static_string.hpp>
 #include <beast/http/concepts.hpp>
 #include <beast/http/rfc7230.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
@@ -150,6 +151,28 @@ prepare_content_length(prepare_info& pi,
     pi.content_length = boost::none;
 }
 
+template<bool isRequest, class Body, class Fields>
+void
+prepare_content_encoding(
+    message<isRequest, Body, Fields>& msg,
+        std::true_type)
+{
+    if(msg.fields.exists("Content-Encoding"))
+        throw std::invalid_argument(
+            "prepare called with Content-Encoding field set");
+    msg.fields.insert("Content-Encoding",
+        Body::content_encoding());
+}
+
+template<bool isRequest, class Body, class Fields>
+void
+prepare_content_encoding(
+    message<isRequest, Body, Fields>& msg,
+        std::false_type)
+{
+    beast::detail::ignore_unused(msg);
+}
+
 } // detail
 
 template<
@@ -185,6 +208,9 @@ prepare(message<isRequest, Body, Fields>& msg,
         throw std::invalid_argument(
             "prepare called with Transfer-Encoding: chunked set");
 
+    detail::prepare_content_encoding(msg,
+        detail::has_content_encoding<Body>{});
+
     if(pi.connection_value != connection::upgrade)
     {
         if(pi.content_length)
@@ -199,8 +225,8 @@ prepare(message<isRequest, Body, Fields>& msg,
                     if(*pi.content_length > 0 ||
                         ci_equal(msg.method, "POST"))
                     {
-                        msg.fields.insert(
-                            "Content-Length", *pi.content_length);
+                        msg.fields.insert("Content-Length",
+                            to_static_string(*pi.content_length));
                     }
                 }
 
@@ -212,8 +238,8 @@ prepare(message<isRequest, Body, Fields>& msg,
                         msg.status != 204 &&
                         msg.status != 304)
                     {
-                        msg.fields.insert(
-                            "Content-Length", *pi.content_length);
+                        msg.fields.insert("Content-Length",
+                            to_static_string(*pi.content_length));
                     }
                 }
             };
@@ -19,6 +19,19 @@ namespace http {
 
 namespace detail {
 
+// Return the number of bytes to prepare for a read. A
+// policy decides the size by itself, otherwise the buffer
+// chooses up to 64KB, preferring space it already has.
+template<class Stream, class DynamicBuffer>
+std::size_t
+parse_read_size(Stream& stream,
+    DynamicBuffer& dynabuf, read_size_policy* rs)
+{
+    if(rs)
+        return rs->read_size(stream);
+    return read_size_helper(dynabuf, 65536);
+}
+
 template<class Stream,
     class DynamicBuffer, class Parser, class Handler>
 class parse_op
@@ -32,21 +45,27 @@ class parse_op
         DynamicBuffer& db;
         Parser& p;
         Handler h;
+        read_size_policy* rs;
+        std::size_t size = 0;
         bool got_some = false;
+        bool some;
         bool cont;
         int state = 0;
 
         template<class DeducedHandler>
         data(DeducedHandler&& h_, Stream& s_,
-                DynamicBuffer& sb_, Parser& p_)
+                DynamicBuffer& sb_, Parser& p_, bool some_,
+                    read_size_policy* rs_)
             : s(s_)
             , db(sb_)
             , p(p_)
             , h(std::forward<DeducedHandler>(h_))
+            , rs(rs_)
+            , some(some_)
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
-            BOOST_ASSERT(! p.complete());
+            BOOST_ASSERT(some || ! p.complete());
         }
     };
 
@@ -130,7 +149,7 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
                 d.got_some = true;
                 d.db.consume(used);
             }
-            if(d.p.complete())
+            if(d.some ? used > 0 : d.p.complete())
             {
                 // call handler
                 d.state = 99;
@@ -149,17 +168,30 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
         {
             // read
             d.state = 2;
-            auto const size = 
-                read_size_helper(d.db, 65536);
-            BOOST_ASSERT(size > 0);
+            d.size = parse_read_size(d.s, d.db, d.rs);
+            BOOST_ASSERT(d.size > 0);
             d.s.async_read_some(
-                d.db.prepare(size), std::move(*this));
+                d.db.prepare(d.size), std::move(*this));
             return;
         }
 
         // got data
         case 2:
         {
+            if(d.rs)
+                d.rs->on_read(d.size, bytes_transferred);
+            if(ec == boost::asio::error::eof && d.some)
+            {
+                // Deliver the eof to the caller
+                // unless it completes the parse.
+                error_code ev;
+                d.p.write_eof(ev);
+                if(! ev && d.p.complete())
+                    ec = {};
+                // call handler
+                d.state = 99;
+                break;
+            }
             if(ec == boost::asio::error::eof)
             {
                 // If we haven't processed any bytes,
@@ -200,7 +232,7 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
             BOOST_ASSERT(used > 0);
             d.got_some = true;
             d.db.consume(used);
-            if(d.p.complete())
+            if(d.p.complete() || d.some)
             {
                 // call handler
                 d.state = 99;
@@ -217,6 +249,84 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
     d.h(ec);
 }
 
+template<class Stream, class DynamicBuffer, class Parser>
+void
+parse(Stream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy* rs, error_code& ec)
+{
+    bool got_some = false;
+    for(;;)
+    {
+        auto used =
+            parser.write(dynabuf.data(), ec);
+        if(ec)
+            return;
+        dynabuf.consume(used);
+        if(used > 0)
+            got_some = true;
+        if(parser.complete())
+            break;
+        auto const size =
+            parse_read_size(stream, dynabuf, rs);
+        auto const n = stream.read_some(
+            dynabuf.prepare(size), ec);
+        if(rs)
+            rs->on_read(size, n);
+        dynabuf.commit(n);
+        if(ec && ec != boost::asio::error::eof)
+            return;
+        if(ec == boost::asio::error::eof)
+        {
+            if(! got_some)
+                return;
+            // Caller will see eof on next read.
+            ec = {};
+            parser.write_eof(ec);
+            if(ec)
+                return;
+            BOOST_ASSERT(parser.complete());
+            break;
+        }
+    }
+}
+
+template<class Stream, class DynamicBuffer, class Parser>
+void
+parse_some(Stream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy* rs, error_code& ec)
+{
+    if(dynabuf.size() > 0)
+    {
+        auto const used =
+            parser.write(dynabuf.data(), ec);
+        if(ec)
+            return;
+        dynabuf.consume(used);
+        if(used > 0)
+            return;
+    }
+    auto const size =
+        parse_read_size(stream, dynabuf, rs);
+    auto const n = stream.read_some(
+        dynabuf.prepare(size), ec);
+    if(rs)
+        rs->on_read(size, n);
+    dynabuf.commit(n);
+    if(ec == boost::asio::error::eof)
+    {
+        // Deliver the eof to the caller
+        // unless it completes the parse.
+        error_code ev;
+        parser.write_eof(ev);
+        if(! ev && parser.complete())
+            ec = {};
+        return;
+    }
+    if(ec)
+        return;
+    dynabuf.consume(parser.write(dynabuf.data(), ec));
+}
+
 } // detail
 
 //------------------------------------------------------------------------------
@@ -249,36 +359,21 @@ parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
         "DynamicBuffer requirements not met");
     static_assert(is_Parser<Parser>::value,
         "Parser requirements not met");
-    bool got_some = false;
-    for(;;)
-    {
-        auto used =
-            parser.write(dynabuf.data(), ec);
-        if(ec)
-            return;
-        dynabuf.consume(used);
-        if(used > 0)
-            got_some = true;
-        if(parser.complete())
-            break;
-        dynabuf.commit(stream.read_some(
-            dynabuf.prepare(read_size_helper(
-                dynabuf, 65536)), ec));
-        if(ec && ec != boost::asio::error::eof)
-            return;
-        if(ec == boost::asio::error::eof)
-        {
-            if(! got_some)
-                return;
-            // Caller will see eof on next read.
-            ec = {};
-            parser.write_eof(ec);
-            if(ec)
-                return;
-            BOOST_ASSERT(parser.complete());
-            break;
-        }
-    }
+    detail::parse(stream, dynabuf, parser, nullptr, ec);
+}
+
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    detail::parse(stream, dynabuf, parser, &policy, ec);
 }
 
 template<class AsyncReadStream,
@@ -298,7 +393,119 @@ async_parse(AsyncReadStream& stream,
         void(error_code)> completion(handler);
     detail::parse_op<AsyncReadStream, DynamicBuffer,
         Parser, decltype(completion.handler)>{
-            completion.handler, stream, dynabuf, parser};
+            completion.handler, stream, dynabuf, parser,
+                false, nullptr};
+    return completion.result.get();
+}
+
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_parse(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    detail::parse_op<AsyncReadStream, DynamicBuffer,
+        Parser, decltype(completion.handler)>{
+            completion.handler, stream, dynabuf, parser,
+                false, &policy};
+    return completion.result.get();
+}
+
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream,
+    DynamicBuffer& dynabuf, Parser& parser)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    error_code ec;
+    parse_some(stream, dynabuf, parser, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    detail::parse_some(stream, dynabuf, parser, nullptr, ec);
+}
+
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    detail::parse_some(stream, dynabuf, parser, &policy, ec);
+}
+
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_parse_some(AsyncReadStream& stream,
+    DynamicBuffer& dynabuf, Parser& parser, ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    detail::parse_op<AsyncReadStream, DynamicBuffer,
+        Parser, decltype(completion.handler)>{
+            completion.handler, stream, dynabuf, parser,
+                true, nullptr};
+    return completion.result.get();
+}
+
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_parse_some(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Parser<Parser>::value,
+        "Parser requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    detail::parse_op<AsyncReadStream, DynamicBuffer,
+        Parser, decltype(completion.handler)>{
+            completion.handler, stream, dynabuf, parser,
+                true, &policy};
     return completion.result.get();
 }
 
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_IMPL_WRITE_IPP
 
 #include <beast/http/concepts.hpp>
+#include <beast/http/reason.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/chunk_encode.hpp>
 #include <beast/core/buffer_cat.hpp>
@@ -58,6 +59,17 @@ write_start_line(DynamicBuffer& dynabuf,
     header<false, Fields> const& msg)
 {
     BOOST_ASSERT(msg.version == 10 || msg.version == 11);
+    // Use the prebuilt line when the reason is the standard one
+    auto const line = status_line(msg.version, msg.status);
+    // "HTTP/1.1 200 " + reason + "\r\n"
+    if(! line.empty() && line.substr(
+        13, line.size() - 15) == msg.reason)
+    {
+        // Qualified, or ADL finds boost::asio::write
+        beast::write(dynabuf, boost::asio::const_buffer{
+            line.data(), line.size()});
+        return;
+    }
     switch(msg.version)
     {
     case 10:
@@ -346,12 +358,12 @@ class write_op
             // write header and body
             if(d.wp.chunked)
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                    flat_buffer_cat(d.wp.sb.data(),
                         chunk_encode(false, buffers)),
                             std::move(self_));
             else
                 boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                    flat_buffer_cat(d.wp.sb.data(),
                         buffers), std::move(self_));
         }
     };
@@ -580,10 +592,10 @@ public:
     {
         // write header and body
         if(chunked_)
-            boost::asio::write(stream_, buffer_cat(
+            boost::asio::write(stream_, flat_buffer_cat(
                 sb_.data(), chunk_encode(false, buffers)), ec_);
         else
-            boost::asio::write(stream_, buffer_cat(
+            boost::asio::write(stream_, flat_buffer_cat(
                 sb_.data(), buffers), ec_);
     }
 };
@@ -450,7 +450,8 @@ enum class connection
 
     This function will adjust the Content-Length, Transfer-Encoding,
     and Connection fields of the message based on the properties of
-    the body and the options passed in.
+    the body and the options passed in. If the body declares a
+    content coding, the Content-Encoding field is also set.
 
     @param msg The message to prepare. The fields may be modified.
 
@@ -10,6 +10,7 @@
 
 #include <beast/core/error.hpp>
 #include <beast/core/async_completion.hpp>
+#include <beast/core/read_size.hpp>
 
 namespace beast {
 namespace http {
@@ -92,6 +93,36 @@ void
 parse(SyncReadStream& stream,
     DynamicBuffer& dynabuf, Parser& parser, error_code& ec);
 
+/** Parse an object from a stream, sizing reads with a policy.
+
+    This function behaves the same as the overload without a
+    policy, except that the number of bytes prepared in the
+    stream buffer for each read is chosen by the policy, and
+    the policy is informed of the result of each read. Without
+    a policy, each read prepares up to 64KB.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data.
+
+    @param policy The policy used to size reads. This is usually
+    kept for the lifetime of the connection.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, error_code& ec);
+
 /** Start an asynchronous operation to parse an object from a stream.
 
     This function is used to asynchronously read from a stream and
@@ -146,6 +177,266 @@ typename async_completion<
 async_parse(AsyncReadStream& stream, DynamicBuffer& dynabuf,
     Parser& parser, ReadHandler&& handler);
 
+/** Start an asynchronous operation to parse an object from a stream, sizing reads with a policy.
+
+    This function behaves the same as the overload without a
+    policy, except that the number of bytes prepared in the
+    stream buffer for each read is chosen by the policy, and
+    the policy is informed of the result of each read.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b AsyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data. This object must remain valid
+    until the completion handler is invoked.
+
+    @param policy The policy used to size reads. This object
+    must remain valid until the completion handler is invoked.
+
+    @param handler The handler to be called when the request
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_parse(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, ReadHandler&& handler);
+
+/** Parse part of an object from a stream.
+
+    This function passes the bytes in the stream buffer to the
+    specified parser. If the stream buffer is empty, it reads from
+    the stream exactly once, and passes the data received to the
+    parser. The call will block until one of the following
+    conditions is met:
+
+    @li The parser has consumed some input.
+
+    @li An error occurs in the stream or parser.
+
+    This allows the caller to observe the parser's progress,
+    and to decide when to read more data. For example, when a
+    body type such as @ref streambuf_body is used, the caller can
+    consume the body data received so far between calls. This
+    bounds the memory used to hold the body by the size of a
+    single read, regardless of the size of the message.
+
+    If the stream reports the end of the file, the parser is
+    informed. If this completes the parse no error is reported,
+    otherwise `boost::asio::error::eof` is returned.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data.
+
+    @throws system_error Thrown on failure.
+
+    @par Example
+    @code
+        header_parser_v1<true, fields> hp;
+        while(! hp.complete())
+            parse_some(sock, sb, hp);
+        // The new parser resumes after the header
+        auto p = with_body<streambuf_body>(hp);
+        do
+        {
+            parse_some(sock, sb, p);
+            forward(p.get().body.data());
+            p.get().body.consume(p.get().body.size());
+        }
+        while(! p.complete());
+    @endcode
+*/
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream,
+    DynamicBuffer& dynabuf, Parser& parser);
+
+/** Parse part of an object from a stream.
+
+    This function passes the bytes in the stream buffer to the
+    specified parser. If the stream buffer is empty, it reads from
+    the stream exactly once, and passes the data received to the
+    parser. The call will block until one of the following
+    conditions is met:
+
+    @li The parser has consumed some input.
+
+    @li An error occurs in the stream or parser.
+
+    If the stream reports the end of the file, the parser is
+    informed. If this completes the parse no error is reported,
+    otherwise `boost::asio::error::eof` is returned.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream,
+    DynamicBuffer& dynabuf, Parser& parser, error_code& ec);
+
+/** Parse part of an object from a stream, sizing reads with a policy.
+
+    This function behaves the same as the overload without a
+    policy, except that the number of bytes prepared in the
+    stream buffer for a read is chosen by the policy, and the
+    policy is informed of the result of the read.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data.
+
+    @param policy The policy used to size reads.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer, class Parser>
+void
+parse_some(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, error_code& ec);
+
+/** Start an asynchronous operation to parse part of an object from a stream.
+
+    This function is used to asynchronously pass the bytes in the
+    stream buffer to the specified parser, or if the stream buffer
+    is empty, to read from the stream exactly once and pass the
+    data received to the parser. The function call always returns
+    immediately. The asynchronous operation will continue until
+    one of the following conditions is true:
+
+    @li The parser has consumed some input.
+
+    @li An error occurs in the stream or parser.
+
+    This operation is implemented in terms of zero or one calls to
+    the next layer's `async_read_some` function, and is known as a
+    <em>composed operation</em>. The program must ensure that the
+    stream performs no other operations until this operation completes.
+
+    If the stream reports the end of the file, the parser is
+    informed. If this completes the parse no error is reported,
+    otherwise `boost::asio::error::eof` is returned.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b AsyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data.
+    This object must remain valid until the completion handler
+    is invoked.
+
+    @param handler The handler to be called when the request
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_parse_some(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, ReadHandler&& handler);
+
+/** Start an asynchronous operation to parse part of an object from a stream, sizing reads with a policy.
+
+    This function behaves the same as the overload without a
+    policy, except that the number of bytes prepared in the
+    stream buffer for a read is chosen by the policy, and the
+    policy is informed of the result of the read.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b AsyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer holding additional bytes
+    read by the implementation from the stream.
+
+    @param parser An object meeting the requirements of @b Parser
+    which will receive the data. This object must remain valid
+    until the completion handler is invoked.
+
+    @param policy The policy used to size reads. This object
+    must remain valid until the completion handler is invoked.
+
+    @param handler The handler to be called when the request
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream,
+    class DynamicBuffer, class Parser, class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_parse_some(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    Parser& parser, read_size_policy& policy, ReadHandler&& handler);
+
 } // http
 } // beast
 
@@ -152,6 +152,11 @@ public:
                 isRequest, Body, Fields>>&>(*this) = parser;
     }
 
+#if ! GENERATING_DOCS
+    using basic_parser_v1<isRequest,
+        parser_v1<isRequest, Body, Fields>>::set_option;
+#endif
+
     /// Set the skip body option.
     void
     set_option(skip_body const& o)
@@ -286,8 +291,21 @@ private:
         r_->write(s.data(), s.size(), ec);
     }
 
-    void on_complete(error_code&)
+    void
+    finish(std::true_type, error_code& ec)
+    {
+        if(r_)
+            r_->finish(ec);
+    }
+
+    void
+    finish(std::false_type, error_code&)
+    {
+    }
+
+    void on_complete(error_code& ec)
     {
+        finish(detail::has_finish<reader>{}, ec);
     }
 };
 
@@ -8,57 +8,72 @@
 #ifndef BEAST_HTTP_REASON_HPP
 #define BEAST_HTTP_REASON_HPP
 
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+
 namespace beast {
 namespace http {
 
 namespace detail {
 
+/*  The status codes with a standard reason phrase.
+
+    This is the only list of reason phrases. Both reason_string
+    and status_line are generated from it, so the two cannot
+    disagree. F is invoked as F(code, "reason") for each entry.
+*/
+#define BEAST_HTTP_STATUS_TABLE(F)            \
+    F(100, "Continue")                        \
+    F(101, "Switching Protocols")             \
+    F(200, "OK")                              \
+    F(201, "Created")                         \
+    F(202, "Accepted")                        \
+    F(203, "Non-Authoritative Information")   \
+    F(204, "No Content")                      \
+    F(205, "Reset Content")                   \
+    F(206, "Partial Content")                 \
+    F(300, "Multiple Choices")                \
+    F(301, "Moved Permanently")               \
+    F(302, "Found")                           \
+    F(303, "See Other")                       \
+    F(304, "Not Modified")                    \
+    F(305, "Use Proxy")                       \
+    F(307, "Temporary Redirect")              \
+    F(400, "Bad Request")                     \
+    F(401, "Unauthorized")                    \
+    F(402, "Payment Required")                \
+    F(403, "Forbidden")                       \
+    F(404, "Not Found")                       \
+    F(405, "Method Not Allowed")              \
+    F(406, "Not Acceptable")                  \
+    F(407, "Proxy Authentication Required")   \
+    F(408, "Request Timeout")                 \
+    F(409, "Conflict")                        \
+    F(410, "Gone")                            \
+    F(411, "Length Required")                 \
+    F(412, "Precondition Failed")             \
+    F(413, "Request Entity Too Large")        \
+    F(414, "Request-URI Too Long")            \
+    F(415, "Unsupported Media Type")          \
+    F(416, "Requested Range Not Satisfiable") \
+    F(417, "Expectation Failed")              \
+    F(500, "Internal Server Error")           \
+    F(501, "Not Implemented")                 \
+    F(502, "Bad Gateway")                     \
+    F(503, "Service Unavailable")             \
+    F(504, "Gateway Timeout")                 \
+    F(505, "HTTP Version Not Supported")
+
 template<class = void>
 char const*
 reason_string(int status)
 {
     switch(status)
     {
-    case 100: return "Continue";
-    case 101: return "Switching Protocols";
-    case 200: return "OK";
-    case 201: return "Created";
-    case 202: return "Accepted";
-    case 203: return "Non-Authoritative Information";
-    case 204: return "No Content";
-    case 205: return "Reset Content";
-    case 206: return "Partial Content";
-    case 300: return "Multiple Choices";
-    case 301: return "Moved Permanently";
-    case 302: return "Found";
-    case 303: return "See Other";
-    case 304: return "Not Modified";
-    case 305: return "Use Proxy";
-    case 307: return "Temporary Redirect";
-    case 400: return "Bad Request";
-    case 401: return "Unauthorized";
-    case 402: return "Payment Required";
-    case 403: return "Forbidden";
-    case 404: return "Not Found";
-    case 405: return "Method Not Allowed";
-    case 406: return "Not Acceptable";
-    case 407: return "Proxy Authentication Required";
-    case 408: return "Request Timeout";
-    case 409: return "Conflict";
-    case 410: return "Gone";
-    case 411: return "Length Required";
-    case 412: return "Precondition Failed";
-    case 413: return "Request Entity Too Large";
-    case 414: return "Request-URI Too Long";
-    case 415: return "Unsupported Media Type";
-    case 416: return "Requested Range Not Satisfiable";
-    case 417: return "Expectation Failed";
-    case 500: return "Internal Server Error";
-    case 501: return "Not Implemented";
-    case 502: return "Bad Gateway";
-    case 503: return "Service Unavailable";
-    case 504: return "Gateway Timeout";
-    case 505: return "HTTP Version Not Supported";
+#define BEAST_HTTP_STATUS_CASE(code, text) \
+    case code: return text;
+    BEAST_HTTP_STATUS_TABLE(BEAST_HTTP_STATUS_CASE)
+#undef BEAST_HTTP_STATUS_CASE
 
     case 306: return "<reserved>";
     default:
@@ -67,6 +82,49 @@ reason_string(int status)
     return "<unknown-status>";
 }
 
+template<std::size_t N>
+inline
+boost::string_ref
+make_line(char const (&s)[N])
+{
+    return {s, N - 1};
+}
+
+/*  Returns the complete status line for a response with
+    the given version and status, using the text from
+    reason_string, for example "HTTP/1.1 200 OK\r\n".
+
+    Each line is a string literal pasted together from the
+    table entry, so a lookup is a switch returning a pointer
+    into static storage. There is no array to build on first
+    use and no initialization guard checked on every call.
+    An empty string is returned for unknown status codes and
+    versions other than 1.0 and 1.1.
+*/
+template<class = void>
+boost::string_ref
+status_line(int version, int status)
+{
+    if(version != 10 && version != 11)
+        return {};
+    auto const v11 = version == 11;
+    switch(status)
+    {
+#define BEAST_HTTP_STATUS_CASE(code, text) \
+    case code: return v11 ? \
+        make_line("HTTP/1.1 " #code " " text "\r\n") : \
+        make_line("HTTP/1.0 " #code " " text "\r\n");
+    BEAST_HTTP_STATUS_TABLE(BEAST_HTTP_STATUS_CASE)
+#undef BEAST_HTTP_STATUS_CASE
+
+    default:
+        break;
+    }
+    return {};
+}
+
+#undef BEAST_HTTP_STATUS_TABLE
+
 } // detail
 
 /** Returns the text for a known status code integer. */
@@ -0,0 +1,266 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_SPILL_BODY_HPP
+#define BEAST_HTTP_SPILL_BODY_HPP
+
+#include <beast/core/error.hpp>
+#include <beast/http/file_body.hpp>
+#include <beast/http/message.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/** A Body which is kept in memory up to a limit, then in a file.
+
+    Bodies no larger than the limit are stored in a `std::string`.
+    When a body grows past the limit, the contents received so far
+    are moved to a temporary file created with `std::tmpfile`, and
+    the rest of the body is appended to the file through a buffer of
+    @ref file_body::buffer_size bytes. The file is removed when it
+    is closed, which happens when the body is destroyed.
+
+    This allows a server to accept uploads of any size while using
+    memory only for small ones.
+
+    Meets the requirements of @b `Body`.
+
+    @par Example
+    @code
+        parser_v1<true, spill_body, fields> p;
+        p.set_option(body_max_size{0});
+        p.get().body.limit(64 * 1024);
+        ...
+        auto const& body = p.get().body;
+        if(body.spilled())
+            process(body.file());
+        else
+            process(body.data());
+    @endcode
+
+    @note The parser limits the size of request bodies by default.
+    Use the @ref body_max_size option to receive larger bodies.
+*/
+struct spill_body
+{
+    /// The type of the `message::body` member
+    class value_type
+    {
+        std::size_t limit_ = 1024 * 1024;
+        std::uint64_t size_ = 0;
+        std::string data_;
+        std::FILE* file_ = nullptr;
+        std::unique_ptr<char[]> buf_;
+
+        friend struct spill_body;
+
+    public:
+        /// Default constructor, using a limit of 1MB.
+        value_type() = default;
+
+        /// Construct with the given memory limit.
+        explicit
+        value_type(std::size_t limit)
+            : limit_(limit)
+        {
+        }
+
+        /// Move constructor
+        value_type(value_type&& other) noexcept
+            : limit_(other.limit_)
+            , size_(other.size_)
+            , data_(std::move(other.data_))
+            , file_(other.file_)
+            , buf_(std::move(other.buf_))
+        {
+            other.size_ = 0;
+            other.file_ = nullptr;
+        }
+
+        /// Move assignment
+        value_type&
+        operator=(value_type&& other) noexcept
+        {
+            close();
+            limit_ = other.limit_;
+            size_ = other.size_;
+            data_ = std::move(other.data_);
+            file_ = other.file_;
+            buf_ = std::move(other.buf_);
+            other.size_ = 0;
+            other.file_ = nullptr;
+            return *this;
+        }
+
+        /// Destructor. Removes the temporary file, if any.
+        ~value_type()
+        {
+            close();
+        }
+
+        /// Returns the number of bytes kept in memory before spilling.
+        std::size_t
+        limit() const
+        {
+            return limit_;
+        }
+
+        /// Set the number of bytes kept in memory before spilling.
+        void
+        limit(std::size_t n)
+        {
+            limit_ = n;
+        }
+
+        /// Returns the size of the body in bytes.
+        std::uint64_t
+        size() const
+        {
+            return size_;
+        }
+
+        /// Returns `true` if the body is stored in a temporary file.
+        bool
+        spilled() const
+        {
+            return file_ != nullptr;
+        }
+
+        /** Returns the body, if it is stored in memory.
+
+            Only valid if @ref spilled would return `false`.
+        */
+        std::string const&
+        data() const
+        {
+            return data_;
+        }
+
+        /** Returns the temporary file holding the body.
+
+            After parsing, the file is positioned at the beginning.
+            Only valid if @ref spilled would return `true`.
+        */
+        std::FILE*
+        file() const
+        {
+            return file_;
+        }
+
+    private:
+        void
+        close()
+        {
+            if(file_)
+            {
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+            buf_.reset();
+        }
+    };
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class reader
+    {
+        value_type& body_;
+
+    public:
+        template<bool isRequest, class Body, class Fields>
+        explicit
+        reader(message<isRequest, Body, Fields>& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code&) noexcept
+        {
+            body_.close();
+            body_.data_.clear();
+            body_.size_ = 0;
+        }
+
+        void
+        write(void const* data,
+            std::size_t size, error_code& ec) noexcept
+        {
+            if(! body_.file_)
+            {
+                if(body_.data_.size() + size <= body_.limit_)
+                {
+                    auto const n = body_.data_.size();
+                    body_.data_.resize(n + size);
+                    std::memcpy(&body_.data_[n], data, size);
+                    body_.size_ += size;
+                    return;
+                }
+                spill(ec);
+                if(ec)
+                    return;
+            }
+            if(std::fwrite(data, 1, size, body_.file_) != size)
+            {
+                ec = file_body::errno_code();
+                return;
+            }
+            body_.size_ += size;
+        }
+
+        void
+        finish(error_code& ec) noexcept
+        {
+            if(! body_.file_)
+                return;
+            if(std::fflush(body_.file_) != 0)
+            {
+                ec = file_body::errno_code();
+                return;
+            }
+            std::rewind(body_.file_);
+        }
+
+    private:
+        void
+        spill(error_code& ec)
+        {
+            body_.file_ = std::tmpfile();
+            if(! body_.file_)
+            {
+                ec = file_body::errno_code();
+                return;
+            }
+            body_.buf_.reset(new(std::nothrow)
+                char[file_body::buffer_size]);
+            if(body_.buf_)
+                std::setvbuf(body_.file_, body_.buf_.get(),
+                    _IOFBF, file_body::buffer_size);
+            auto const n = body_.data_.size();
+            if(n > 0 && std::fwrite(
+                body_.data_.data(), 1, n, body_.file_) != n)
+            {
+                ec = file_body::errno_code();
+                return;
+            }
+            std::string{}.swap(body_.data_);
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
@@ -38,10 +38,9 @@ private:
         value_type& s_;
 
     public:
-        template<bool isRequest, class Fields>
+        template<bool isRequest, class Body, class Fields>
         explicit
-        reader(message<isRequest,
-                string_body, Fields>& m) noexcept
+        reader(message<isRequest, Body, Fields>& m) noexcept
             : s_(m.body)
         {
         }
@@ -66,10 +65,10 @@ private:
         value_type const& body_;
 
     public:
-        template<bool isRequest, class Fields>
+        template<bool isRequest, class Body, class Fields>
         explicit
         writer(message<
-                isRequest, string_body, Fields> const& msg) noexcept
+                isRequest, Body, Fields> const& msg) noexcept
             : body_(msg.body)
         {
         }
@@ -53,6 +53,7 @@ protected:
     std::size_t rd_msg_max_ =
         16 * 1024 * 1024;                   // max message size
     bool wr_autofrag_ = true;               // auto fragment
+    bool auto_release_ = false;             // release idle buffers
     std::size_t wr_buf_size_ = 4096;        // mask buffer size
     opcode wr_opcode_ = opcode::text;       // outgoing message type
     pong_cb pong_cb_;                       // pong callback
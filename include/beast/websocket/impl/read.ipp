@@ -235,6 +235,9 @@ operator()(error_code ec,std::size_t bytes_transferred, bool again)
                 d.fi.op = d.ws.rd_opcode_;
                 d.fi.fin = d.ws.rd_fh_.fin &&
                     d.ws.rd_need_ == 0;
+                if(d.fi.fin && d.ws.auto_release_ &&
+                        d.ws.stream_.buffer().size() == 0)
+                    d.ws.release_buffers();
                 goto upcall;
 
             //------------------------------------------------------------------
@@ -696,6 +699,9 @@ read_frame(frame_info& fi, DynamicBuffer& dynabuf, error_code& ec)
         dynabuf.commit(bytes_transferred);
         fi.op = rd_opcode_;
         fi.fin = rd_fh_.fin && rd_need_ == 0;
+        if(fi.fin && auto_release_ &&
+                stream_.buffer().size() == 0)
+            release_buffers();
         return;
     }
     if(code != close_code::none)
@@ -37,6 +37,17 @@ stream(Args&&... args)
 {
 }
 
+template<class NextLayer>
+void
+stream<NextLayer>::
+release_buffers()
+{
+    stream_.shrink_to_fit();
+    // The write buffer is needed until the message is sent
+    if(! wr_.cont)
+        wr_.buf.reset();
+}
+
 //------------------------------------------------------------------------------
 
 template<class NextLayer>
@@ -134,10 +145,10 @@ build_response(http::request<Body, Fields> const& req)
     res.version = req.version;
     res.fields.insert("Upgrade", "websocket");
     {
-        auto const key =
-            req.fields["Sec-WebSocket-Key"];
-        res.fields.insert("Sec-WebSocket-Accept",
-            detail::make_sec_ws_accept(key));
+        detail::sec_ws_accept_type accept;
+        detail::make_sec_ws_accept(accept,
+            req.fields["Sec-WebSocket-Key"]);
+        res.fields.insert("Sec-WebSocket-Accept", accept);
     }
     res.fields.replace("Server", "Beast.WSProto");
     (*d_)(res);
@@ -164,8 +175,10 @@ do_response(http::response<Body, Fields> const& res,
         return fail();
     if(! res.fields.exists("Sec-WebSocket-Accept"))
         return fail();
+    detail::sec_ws_accept_type accept;
+    detail::make_sec_ws_accept(accept, key);
     if(res.fields["Sec-WebSocket-Accept"] !=
-        detail::make_sec_ws_accept(key))
+            boost::string_ref{accept})
         return fail();
     open(detail::role_type::client);
 }
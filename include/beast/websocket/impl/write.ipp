@@ -273,7 +273,7 @@ operator()(error_code ec, bool again)
                 BOOST_ASSERT(! d.ws.wr_block_);
                 d.ws.wr_block_ = &d;
                 boost::asio::async_write(d.ws.stream_,
-                    buffer_cat(d.fh_buf.data(), d.cb),
+                    flat_buffer_cat(d.fh_buf.data(), d.cb),
                         std::move(*this));
                 return;
             }
@@ -288,7 +288,7 @@ operator()(error_code ec, bool again)
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
             boost::asio::async_write(d.ws.stream_,
-                buffer_cat(d.fh_buf.data(),
+                flat_buffer_cat(d.fh_buf.data(),
                     mb), std::move(*this));
             return;
         }
@@ -422,7 +422,7 @@ write_frame(bool fin,
         detail::fh_streambuf fh_buf;
         detail::write<static_streambuf>(fh_buf, fh);
         boost::asio::write(stream_,
-            buffer_cat(fh_buf.data(), buffers), ec);
+            flat_buffer_cat(fh_buf.data(), buffers), ec);
         failed_ = ec != 0;
         if(failed_)
             return;
@@ -442,7 +442,7 @@ write_frame(bool fin,
             detail::fh_streambuf fh_buf;
             detail::write<static_streambuf>(fh_buf, fh);
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(),
+                flat_buffer_cat(fh_buf.data(),
                     prepare_buffers(n, cb)), ec);
             failed_ = ec != 0;
             if(failed_)
@@ -473,7 +473,7 @@ write_frame(bool fin,
             remain -= n;
             detail::mask_inplace(mb, key);
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), mb), ec);
+                flat_buffer_cat(fh_buf.data(), mb), ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -513,7 +513,7 @@ write_frame(bool fin,
             detail::fh_streambuf fh_buf;
             detail::write<static_streambuf>(fh_buf, fh);
             boost::asio::write(stream_,
-                buffer_cat(fh_buf.data(), mb), ec);
+                flat_buffer_cat(fh_buf.data(), mb), ec);
             failed_ = ec != 0;
             if(failed_)
                 return;
@@ -57,6 +57,43 @@ struct auto_fragment
 };
 #endif
 
+/** Automatic buffer release option.
+
+    Determines if the stream releases the memory held by its
+    buffers each time a complete message is read and no further
+    received data remains buffered. A server holding many mostly
+    idle connections can use this so that its buffer memory grows
+    with the number of active connections rather than open ones.
+    The buffers are allocated again when next needed.
+
+    The default setting is to keep the buffers.
+
+    @note Objects of this type are used with
+          @ref beast::websocket::stream::set_option.
+
+    @par Example
+    Setting the automatic buffer release option.
+    @code
+    ...
+    websocket::stream<ip::tcp::socket> ws(ios);
+    ws.set_option(auto_release{true});
+    @endcode
+*/
+#if GENERATING_DOCS
+using auto_release = implementation_defined;
+#else
+struct auto_release
+{
+    bool value;
+
+    explicit
+    auto_release(bool v)
+        : value(v)
+    {
+    }
+};
+#endif
+
 /** HTTP decorator option.
 
     The decorator transforms the HTTP requests and responses used
@@ -316,6 +353,47 @@ struct read_message_max
 };
 #endif
 
+/** Wait for readable option.
+
+    Determines if buffered reads wait until the socket is readable
+    before allocating the read buffer set with the
+    @ref read_buffer_size option. When enabled, a connection with
+    a pending read and no data holds no read buffer memory, and
+    the buffer is released again once its data is consumed. This
+    suits servers holding many mostly idle connections.
+
+    The next layer must support reads with `null_buffers`, as
+    `boost::asio::ip::tcp::socket` does.
+
+    The default setting is to allocate the buffer before waiting.
+
+    @note Objects of this type are used with
+          @ref beast::websocket::stream::set_option.
+
+    @par Example
+    Setting the wait for readable option.
+    @code
+    ...
+    websocket::stream<ip::tcp::socket> ws(ios);
+    ws.set_option(read_buffer_size{16 * 1024});
+    ws.set_option(wait_readable{true});
+    @endcode
+*/
+#if GENERATING_DOCS
+using wait_readable = implementation_defined;
+#else
+struct wait_readable
+{
+    bool value;
+
+    explicit
+    wait_readable(bool v)
+        : value(v)
+    {
+    }
+};
+#endif
+
 /** Write buffer size option.
 
     Sets the size of the write buffer used by the implementation to
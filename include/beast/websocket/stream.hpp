@@ -173,6 +173,13 @@ public:
         wr_autofrag_ = o.value;
     }
 
+    /// Set the automatic buffer release option
+    void
+    set_option(auto_release const& o)
+    {
+        auto_release_ = o.value;
+    }
+
     /** Set the decorator used for HTTP messages.
 
         The value for this option is a callable type with two
@@ -228,6 +235,19 @@ public:
         stream_.capacity(o.value);
     }
 
+    /** Set the policy used to size buffered reads.
+
+        The read buffer grows and shrinks with the traffic on
+        the connection, instead of using the fixed size set by
+        the @ref read_buffer_size option. Setting that option
+        afterwards removes the policy.
+    */
+    void
+    set_option(read_size_policy const& o)
+    {
+        stream_.read_size(o);
+    }
+
     /// Set the maximum incoming message size allowed
     void
     set_option(read_message_max const& o)
@@ -235,6 +255,13 @@ public:
         rd_msg_max_ = o.value;
     }
 
+    /// Set the wait for readable option
+    void
+    set_option(wait_readable const& o)
+    {
+        stream_.wait_readable(o.value);
+    }
+
     /// Set the size of the write buffer
     void
     set_option(write_buffer_size const& o)
@@ -242,6 +269,32 @@ public:
         wr_buf_size_ = o.value;
     }
 
+    /** Return the policy used to size buffered reads.
+
+        The counters in the returned policy reflect the reads made
+        since the policy was set with @ref set_option.
+    */
+    read_size_policy const&
+    read_size() const
+    {
+        return stream_.read_size();
+    }
+
+    /** Release the memory held by the stream's buffers.
+
+        The read buffer set with the @ref read_buffer_size option
+        is shrunk to the received data it still holds, if any, and
+        the write buffer is freed unless a message is partly sent.
+        The buffers are allocated again when next needed. This may
+        be called on a connection which is expected to stay idle,
+        or automatically using the @ref auto_release option.
+
+        This function must not be called while a read operation
+        is pending.
+    */
+    void
+    release_buffers();
+
     /** Get the io_service associated with the stream.
 
         This function may be used to obtain the io_service object
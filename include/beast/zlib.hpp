@@ -8,6 +8,7 @@
 #ifndef BEAST_ZLIB_HPP
 #define BEAST_ZLIB_HPP
 
+#include <beast/zlib/buffer_pool.hpp>
 #include <beast/zlib/deflate_stream.hpp>
 #include <beast/zlib/inflate_stream.hpp>
 
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_BUFFER_POOL_HPP
+#define BEAST_ZLIB_BUFFER_POOL_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace beast {
+namespace zlib {
+
+/** A pool of working memory shared by compression streams.
+
+    A @ref deflate_stream needs a large working area for its sliding
+    window, hash chains and pending output (several hundred kilobytes
+    at the default settings), and an @ref inflate_stream needs a
+    sliding window. When a stream is given a pool, these buffers are
+    borrowed from the pool when the stream first needs them, and
+    returned to the pool when the stream is cleared or destroyed.
+
+    This allows an application with many mostly idle connections to
+    keep one stream per connection, calling `clear` on the stream when
+    each message is complete, while only paying for the memory of the
+    messages actually in progress.
+
+    Blocks are recycled by exact size. Streams with the same settings
+    always request the same sizes, so in practice the pool holds one
+    list of blocks for each combination of settings in use.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe. Streams running on different threads
+    may share one pool.
+
+    @note The pool must outlive every stream which uses it.
+*/
+class buffer_pool
+{
+    struct bucket
+    {
+        std::size_t size;
+        std::vector<std::uint8_t*> blocks;
+    };
+
+    std::mutex mutable m_;
+    std::vector<bucket> buckets_;
+    std::size_t max_idle_;
+    std::size_t idle_ = 0;
+    std::size_t used_ = 0;
+
+public:
+    /** Construct a pool.
+
+        @param max_idle The maximum number of bytes held in unused
+        blocks. Blocks returned when the limit would be exceeded
+        are freed instead.
+    */
+    explicit
+    buffer_pool(std::size_t max_idle = 16 * 1024 * 1024)
+        : max_idle_(max_idle)
+    {
+    }
+
+    buffer_pool(buffer_pool const&) = delete;
+    buffer_pool& operator=(buffer_pool const&) = delete;
+
+    /// Destructor. Frees all unused blocks.
+    ~buffer_pool();
+
+    /** Borrow a block.
+
+        @param size The number of bytes required.
+
+        @return A pointer to at least `size` bytes.
+    */
+    std::uint8_t*
+    allocate(std::size_t size);
+
+    /** Return a block.
+
+        @param p A block previously returned by `allocate`.
+
+        @param size The size passed to `allocate`.
+    */
+    void
+    deallocate(std::uint8_t* p, std::size_t size);
+
+    /// Free all unused blocks.
+    void
+    shrink_to_fit();
+
+    /// Return the number of bytes in blocks held by the pool and not in use.
+    std::size_t
+    idle() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return idle_;
+    }
+
+    /// Return the number of bytes in blocks currently borrowed by streams.
+    std::size_t
+    used() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return used_;
+    }
+};
+
+} // zlib
+} // beast
+
+#include <beast/zlib/impl/buffer_pool.ipp>
+
+#endif
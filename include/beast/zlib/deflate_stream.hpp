@@ -35,9 +35,12 @@
 #ifndef BEAST_ZLIB_DEFLATE_STREAM_HPP
 #define BEAST_ZLIB_DEFLATE_STREAM_HPP
 
+#include <beast/zlib/buffer_pool.hpp>
 #include <beast/zlib/error.hpp>
 #include <beast/zlib/zlib.hpp>
 #include <beast/zlib/detail/deflate_stream.hpp>
+#include <beast/zlib/detail/write_buffers.hpp>
+#include <beast/core/buffer_concepts.hpp>
 #include <algorithm>
 #include <cstdlib>
 #include <cstdint>
@@ -47,6 +50,8 @@
 namespace beast {
 namespace zlib {
 
+class deflate_dictionary;
+
 /** Raw deflate compressor.
 
     This is a port of zlib's "deflate" functionality to C++.
@@ -54,6 +59,8 @@ namespace zlib {
 class deflate_stream
     : private detail::deflate_stream
 {
+    friend class deflate_dictionary;
+
 public:
     /** Construct a default deflate stream.
 
@@ -117,8 +124,8 @@ public:
     /** Clear the stream.
 
         This function resets the stream and frees all dynamically
-        allocated internal buffers. The compression settings are
-        left unchanged.
+        allocated internal buffers, or returns them to the pool if
+        one is set. The compression settings are left unchanged.
 
         @note Any unprocessed input or pending output from
         previous calls are discarded.
@@ -128,6 +135,27 @@ public:
     {
         doClear();
     }
+
+    /** Set the pool used for internal buffers.
+
+        When a pool is set, the internal buffers are borrowed from
+        the pool when first needed, and returned to the pool when
+        the stream is cleared or destroyed. To hold the buffers only
+        while a message is being compressed, call @ref clear after
+        each message is complete.
+
+        This function performs the equivalent of calling @ref clear
+        before changing the pool.
+
+        @param p A pointer to the pool, or `nullptr` to allocate
+        internal buffers from the free store. The pool must outlive
+        the stream, or remain valid until the pool is changed.
+    */
+    void
+    pool(buffer_pool* p)
+    {
+        doPool(p);
+    }
     
     /** Returns the upper limit on the size of a compressed block.
 
@@ -284,6 +312,57 @@ public:
         doWrite(zs, flush, ec);
     }
 
+    /** Compress a buffer sequence into a dynamic buffer.
+
+        This function compresses all of the input, writing the
+        output directly into memory obtained from the dynamic
+        buffer's `prepare` member and committing it as it is
+        produced. The buffers in the input sequence are presented
+        to the compressor in turn, so no copy of the input or the
+        output is made.
+
+        The flush parameter has the same meaning as for the
+        overload taking @ref z_params, and applies after the last
+        of the input. Unlike that overload, the function returns
+        only when the flush is complete. With `Flush::finish`, the
+        error `error::end_of_stream` is returned on success.
+
+        @param buffers The input to compress.
+
+        @param dynabuf The dynamic buffer to receive the output.
+
+        @param flush The flush to perform after the input.
+
+        @param ec Set to the error, if any occurred.
+
+        @return The number of bytes of input consumed.
+    */
+    template<class ConstBufferSequence, class DynamicBuffer>
+    std::size_t
+    write(
+        ConstBufferSequence const& buffers,
+        DynamicBuffer& dynabuf,
+        Flush flush,
+        error_code& ec)
+    {
+        static_assert(is_ConstBufferSequence<
+            ConstBufferSequence>::value,
+                "ConstBufferSequence requirements not met");
+        static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+            "DynamicBuffer requirements not met");
+        return detail::write_buffers(*this,
+            buffers, dynabuf, flush, ec,
+            [this](std::size_t n)
+            {
+                // Enough for the input and any pending output,
+                // without reserving far ahead on large input. The
+                // minimum keeps a flush from filling the output
+                // exactly, which would repeat the flush marker.
+                return (std::max<std::size_t>)(256,
+                    (std::min<std::size_t>)(upper_bound(n), 65536));
+            });
+    }
+
     /** Update the compression level and strategy.
 
         This function dynamically updates the compression level and
@@ -351,8 +430,141 @@ public:
     {
         return doPrime(bits, value, ec);
     }
+
+    /** Set the preset dictionary.
+
+        This function initializes the compression dictionary from
+        the given byte sequence without producing any compressed
+        output. It may be called after a reset and before the first
+        call to @ref write, or immediately after a `Flush::full`.
+        The decompressor must be given exactly the same dictionary.
+
+        The dictionary should consist of strings (byte sequences)
+        that are likely to be encountered later in the data to be
+        compressed, with the most commonly used strings preferably
+        put towards the end of the dictionary. Using a dictionary
+        is most useful when the data to be compressed is short and
+        can be predicted with good accuracy. Only the last window
+        size bytes of the dictionary are used.
+
+        @param data A pointer to the dictionary bytes.
+
+        @param size The number of bytes in the dictionary.
+
+        @param ec Set to `error::stream_error` if the stream has
+        unprocessed input.
+    */
+    void
+    dictionary(void const* data, std::size_t size, error_code& ec)
+    {
+        doDictionary(static_cast<Byte const*>(data), size, ec);
+    }
+
+    /** Set a precomputed preset dictionary.
+
+        This function has the same effect as setting the bytes of
+        `dict` as the dictionary, but copies the window and hash
+        chains prepared by `dict` instead of hashing the dictionary
+        again. It must be called after a reset and before the first
+        call to @ref write.
+
+        @param dict The precomputed dictionary.
+
+        @param ec Set to `error::stream_error` if the stream was not
+        reset, or if the window size or memory level of the stream
+        do not match those used to construct `dict`.
+    */
+    void
+    dictionary(deflate_dictionary const& dict, error_code& ec);
+};
+
+/** A preset dictionary, prepared once for use by many streams.
+
+    Setting a preset dictionary on a @ref deflate_stream inserts each
+    byte of the dictionary into the compressor's hash chains. When
+    many short messages are compressed with the same dictionary, for
+    example by one stream per connection, this work can dominate.
+    Objects of this type perform the insertion once and retain the
+    resulting window and hash chains; priming a stream from it costs
+    only a copy.
+
+    The object is not modified after construction, and may be used
+    concurrently by any number of streams whose window size and
+    memory level match the values used to construct it.
+
+    Example:
+    @code
+    deflate_dictionary const dict{json_dict.data(), json_dict.size(), 15, 8};
+    ...
+    deflate_stream ds;
+    ds.reset(6, 15, 8, Strategy::normal);
+    error_code ec;
+    ds.dictionary(dict, ec);
+    @endcode
+*/
+class deflate_dictionary
+{
+    friend class deflate_stream;
+
+    detail::deflate_dictionary_state state_;
+
+public:
+    /** Construct a dictionary.
+
+        @param data A pointer to the dictionary bytes.
+
+        @param size The number of bytes in the dictionary. Only the
+        last window size bytes are used.
+
+        @param windowBits The window size of the streams which
+        will use this dictionary.
+
+        @param memLevel The memory level of the streams which
+        will use this dictionary.
+
+        @throws std::invalid_argument if `windowBits` or `memLevel`
+        is out of range.
+    */
+    deflate_dictionary(void const* data, std::size_t size,
+        int windowBits, int memLevel)
+    {
+        deflate_stream ds;
+        ds.reset(Z_DEFAULT_COMPRESSION,
+            windowBits, memLevel, Strategy::normal);
+        error_code ec;
+        ds.dictionary(data, size, ec);
+        BOOST_ASSERT(! ec);
+        ds.doSaveDictionary(state_);
+    }
+
+    /** Return a pointer to the dictionary bytes in use.
+
+        This is the tail of the bytes passed on construction which
+        fits in the window. The same bytes must be set as the
+        dictionary of the decompressor.
+    */
+    void const*
+    data() const
+    {
+        return state_.window.data();
+    }
+
+    /// Return the number of dictionary bytes in use.
+    std::size_t
+    size() const
+    {
+        return state_.window.size();
+    }
 };
 
+inline
+void
+deflate_stream::
+dictionary(deflate_dictionary const& dict, error_code& ec)
+{
+    doDictionary(dict.state_, ec);
+}
+
 /** Returns the upper limit on the size of a compressed block.
 
     This function makes a conservative estimate of the maximum number
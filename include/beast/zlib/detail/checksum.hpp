@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_DETAIL_CHECKSUM_HPP
+#define BEAST_ZLIB_DETAIL_CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace beast {
+namespace zlib {
+namespace detail {
+
+/*  Checksums used by the zlib (rfc1950) and gzip (rfc1952) wrappers.
+
+    The streams in this module only produce and consume raw deflate
+    data, these are provided for callers who add the framing.
+*/
+
+// Update a running Adler-32. The initial value is 1.
+inline
+std::uint32_t
+adler32(std::uint32_t adler,
+    void const* data, std::size_t size)
+{
+    // largest n such that 255n(n+1)/2 + (n+1)(65520) <= 2^32-1
+    std::size_t constexpr nmax = 5552;
+    std::uint32_t constexpr base = 65521;
+    auto p = reinterpret_cast<std::uint8_t const*>(data);
+    std::uint32_t a = adler & 0xffff;
+    std::uint32_t b = adler >> 16;
+    while(size > 0)
+    {
+        auto n = size < nmax ? size : nmax;
+        size -= n;
+        while(n--)
+        {
+            a += *p++;
+            b += a;
+        }
+        a %= base;
+        b %= base;
+    }
+    return (b << 16) | a;
+}
+
+template<class = void>
+std::uint32_t const*
+get_crc32_table()
+{
+    struct table
+    {
+        std::uint32_t v[256];
+
+        table()
+        {
+            for(std::uint32_t n = 0; n < 256; ++n)
+            {
+                auto c = n;
+                for(int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+                v[n] = c;
+            }
+        }
+    };
+    static table const t;
+    return t.v;
+}
+
+// Update a running CRC-32. The initial value is 0.
+inline
+std::uint32_t
+crc32(std::uint32_t crc,
+    void const* data, std::size_t size)
+{
+    auto const t = get_crc32_table();
+    auto p = reinterpret_cast<std::uint8_t const*>(data);
+    crc = ~crc;
+    while(size--)
+        crc = t[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+} // detail
+} // zlib
+} // beast
+
+#endif
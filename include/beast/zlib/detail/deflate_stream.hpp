@@ -36,20 +36,47 @@
 #define BEAST_ZLIB_DETAIL_DEFLATE_STREAM_HPP
 
 #include <beast/zlib/zlib.hpp>
+#include <beast/zlib/detail/pooled_buffer.hpp>
 #include <beast/zlib/detail/ranges.hpp>
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace beast {
 namespace zlib {
 namespace detail {
 
+/*  The state of a deflate stream after a preset dictionary has been
+    inserted into the sliding window and the hash chains. Restoring
+    this state is equivalent to setting the same dictionary again,
+    without hashing the dictionary contents.
+*/
+struct deflate_dictionary_state
+{
+    unsigned w_bits = 0;
+    unsigned hash_bits = 0;
+    unsigned strstart = 0;
+    unsigned insert = 0;
+    unsigned ins_h = 0;
+
+    // window contents, the dictionary (or its tail)
+    std::vector<std::uint8_t> window;
+
+    // links to older strings, indexed by window position
+    std::vector<std::uint16_t> prev;
+
+    // the non-empty hash chain heads, as (hash, position)
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> head;
+};
+
 /*
  *  ALGORITHM
  *
@@ -294,8 +321,7 @@ protected:
     lut_type const& lut_;
 
     bool inited_ = false;
-    std::size_t buf_size_;
-    std::unique_ptr<std::uint8_t[]> buf_;
+    pooled_buffer buf_;
 
     int status_;                    // as the name implies
     Byte* pending_buf_;             // output still pending
@@ -661,11 +687,14 @@ protected:
     template<class = void> void doReset             (int level, int windowBits, int memLevel, Strategy strategy);
     template<class = void> void doReset             ();
     template<class = void> void doClear             ();
+    template<class = void> void doPool              (buffer_pool* pool);
     template<class = void> std::size_t doUpperBound (std::size_t sourceLen) const;
     template<class = void> void doTune              (int good_length, int max_lazy, int nice_length, int max_chain);
     template<class = void> void doParams            (z_params& zs, int level, Strategy strategy, error_code& ec);
     template<class = void> void doWrite             (z_params& zs, Flush flush, error_code& ec);
-    template<class = void> void doDictionary        (Byte const* dict, uInt dictLength, error_code& ec);
+    template<class = void> void doDictionary        (Byte const* dict, std::size_t dictLength, error_code& ec);
+    template<class = void> void doDictionary        (deflate_dictionary_state const& ds, error_code& ec);
+    template<class = void> void doSaveDictionary    (deflate_dictionary_state& ds);
     template<class = void> void doPrime             (int bits, int value, error_code& ec);
     template<class = void> void doPending           (unsigned* value, int* bits);
 
@@ -931,6 +960,15 @@ doClear()
     buf_.reset();
 }
 
+template<class>
+void
+deflate_stream::
+doPool(buffer_pool* pool)
+{
+    inited_ = false;
+    buf_.pool(pool);
+}
+
 template<class>
 std::size_t
 deflate_stream::
@@ -1143,20 +1181,19 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
     }
 }
 
-// VFALCO Warning: untested
 template<class>
 void
 deflate_stream::
-doDictionary(Byte const* dict, uInt dictLength, error_code& ec)
+doDictionary(Byte const* dict, std::size_t dictLength, error_code& ec)
 {
+    maybe_init();
+
     if(lookahead_)
     {
         ec = error::stream_error;
         return;
     }
 
-    maybe_init();
-
     /* if dict would fill window, just replace the history */
     if(dictLength >= w_size_)
     {
@@ -1199,6 +1236,65 @@ doDictionary(Byte const* dict, uInt dictLength, error_code& ec)
     match_available_ = 0;
 }
 
+/*  Restore a dictionary previously captured with doSaveDictionary.
+    The stream must be at the start of a new deflate stream, with
+    nothing yet inserted into the window or the hash chains.
+*/
+template<class>
+void
+deflate_stream::
+doDictionary(deflate_dictionary_state const& ds, error_code& ec)
+{
+    maybe_init();
+
+    if(ds.w_bits != w_bits_ || ds.hash_bits != hash_bits_ ||
+        strstart_ != 0 || lookahead_ != 0 || insert_ != 0)
+    {
+        ec = error::stream_error;
+        return;
+    }
+    auto const n = ds.window.size();
+    if(n == 0)
+        return;
+    std::memcpy(window_, ds.window.data(), n);
+    std::memcpy(prev_, ds.prev.data(),
+        ds.prev.size() * sizeof(std::uint16_t));
+    // The hash table was cleared by lm_init
+    for(auto const& h : ds.head)
+        head_[h.first] = h.second;
+    high_water_ = static_cast<std::uint32_t>(n);
+    strstart_ = ds.strstart;
+    block_start_ = (long)strstart_;
+    insert_ = ds.insert;
+    ins_h_ = ds.ins_h;
+    match_length_ = prev_length_ = minMatch-1;
+    match_available_ = 0;
+}
+
+/*  Capture the window and hash chains after doDictionary, so
+    that other streams can be primed without hashing again.
+*/
+template<class>
+void
+deflate_stream::
+doSaveDictionary(deflate_dictionary_state& ds)
+{
+    maybe_init();
+
+    ds.w_bits = w_bits_;
+    ds.hash_bits = hash_bits_;
+    ds.strstart = strstart_;
+    ds.insert = insert_;
+    ds.ins_h = ins_h_;
+    ds.window.assign(window_, window_ + strstart_);
+    ds.prev.assign(prev_, prev_ + (std::min)(strstart_, w_size_));
+    ds.head.clear();
+    for(uInt h = 0; h < hash_size_; ++h)
+        if(head_[h] != 0)
+            ds.head.emplace_back(
+                static_cast<std::uint16_t>(h), head_[h]);
+}
+
 template<class>
 void
 deflate_stream::
@@ -1265,11 +1361,7 @@ init()
     auto const noverlay = lit_bufsize_ * (sizeof(std::uint16_t)+2);
     auto const needed   = nwindow + nprev + nhead + noverlay;
 
-    if(! buf_ || buf_size_ != needed)
-    {
-        buf_.reset(new std::uint8_t[needed]);
-        buf_size_ = needed;
-    }
+    buf_.reset(needed);
 
     window_ = reinterpret_cast<Byte*>(buf_.get());
     prev_   = reinterpret_cast<std::uint16_t*>(buf_.get() + nwindow);
@@ -68,6 +68,20 @@ protected:
         doReset(w_.bits());
     }
 
+    void
+    doPool(buffer_pool* pool)
+    {
+        w_.pool(pool);
+        doReset(w_.bits());
+    }
+
+    void
+    doDictionary(std::uint8_t const* dict, std::size_t size)
+    {
+        if(size > 0)
+            w_.write(dict, size);
+    }
+
 private:
     enum Mode
     {
@@ -250,6 +264,8 @@ void
 inflate_stream::
 doClear()
 {
+    w_.clear();
+    doReset(w_.bits());
 }
 
 template<class>
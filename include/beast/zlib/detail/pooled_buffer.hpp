@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_DETAIL_POOLED_BUFFER_HPP
+#define BEAST_ZLIB_DETAIL_POOLED_BUFFER_HPP
+
+#include <beast/zlib/buffer_pool.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+namespace beast {
+namespace zlib {
+namespace detail {
+
+// Owns a block of memory which is either allocated
+// from the free store, or borrowed from a buffer_pool.
+//
+class pooled_buffer
+{
+    buffer_pool* pool_ = nullptr;
+    std::uint8_t* p_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    pooled_buffer() = default;
+    pooled_buffer& operator=(pooled_buffer const&) = delete;
+
+    pooled_buffer(pooled_buffer&& other)
+        : pool_(other.pool_)
+        , p_(other.p_)
+        , size_(other.size_)
+    {
+        other.p_ = nullptr;
+        other.size_ = 0;
+    }
+
+    // Returns any block held to its pool
+    pooled_buffer&
+    operator=(pooled_buffer&& other)
+    {
+        if(this == &other)
+            return *this;
+        reset();
+        pool_ = other.pool_;
+        p_ = other.p_;
+        size_ = other.size_;
+        other.p_ = nullptr;
+        other.size_ = 0;
+        return *this;
+    }
+
+    ~pooled_buffer()
+    {
+        reset();
+    }
+
+    explicit
+    operator bool() const
+    {
+        return p_ != nullptr;
+    }
+
+    std::uint8_t*
+    get() const
+    {
+        return p_;
+    }
+
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    buffer_pool*
+    pool() const
+    {
+        return pool_;
+    }
+
+    // Release any block, then use the pool for future allocations
+    void
+    pool(buffer_pool* p)
+    {
+        reset();
+        pool_ = p;
+    }
+
+    // Release the block
+    void
+    reset()
+    {
+        if(! p_)
+            return;
+        if(pool_)
+            pool_->deallocate(p_, size_);
+        else
+            delete[] p_;
+        p_ = nullptr;
+        size_ = 0;
+    }
+
+    // Ensure a block of exactly n bytes is held
+    void
+    reset(std::size_t n)
+    {
+        if(p_ && size_ == n)
+            return;
+        reset();
+        p_ = pool_ ?
+            pool_->allocate(n) : new std::uint8_t[n];
+        size_ = n;
+    }
+
+    std::uint8_t&
+    operator[](std::size_t i) const
+    {
+        return p_[i];
+    }
+};
+
+} // detail
+} // zlib
+} // beast
+
+#endif
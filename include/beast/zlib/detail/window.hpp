@@ -35,10 +35,10 @@
 #ifndef BEAST_ZLIB_DETAIL_WINDOW_HPP
 #define BEAST_ZLIB_DETAIL_WINDOW_HPP
 
+#include <beast/zlib/detail/pooled_buffer.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
 #include <cstring>
-#include <memory>
 
 namespace beast {
 namespace zlib {
@@ -46,7 +46,7 @@ namespace detail {
 
 class window
 {
-    std::unique_ptr<std::uint8_t[]> p_;
+    pooled_buffer p_;
     std::uint16_t i_ = 0;
     std::uint16_t size_ = 0;
     std::uint16_t capacity_ = 0;
@@ -74,6 +74,24 @@ public:
     void
     reset(int bits);
 
+    // Release the buffer, leaving the window empty
+    void
+    clear()
+    {
+        p_.reset();
+        i_ = 0;
+        size_ = 0;
+    }
+
+    // Use the pool for the buffer
+    void
+    pool(buffer_pool* p)
+    {
+        p_.pool(p);
+        i_ = 0;
+        size_ = 0;
+    }
+
     void
     read(std::uint8_t* out, std::size_t pos, std::size_t n);
 
@@ -126,7 +144,7 @@ window::
 write(std::uint8_t const* in, std::size_t n)
 {
     if(! p_)
-        p_.reset(new std::uint8_t[capacity_]);
+        p_.reset(capacity_);
     if(n >= capacity_)
     {
         i_ = 0;
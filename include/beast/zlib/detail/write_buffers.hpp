@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_DETAIL_WRITE_BUFFERS_HPP
+#define BEAST_ZLIB_DETAIL_WRITE_BUFFERS_HPP
+
+#include <beast/core/error.hpp>
+#include <beast/zlib/zlib.hpp>
+#include <beast/zlib/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace beast {
+namespace zlib {
+namespace detail {
+
+/*  Run a stream over a buffer sequence, producing output
+    directly into the memory returned by `prepare`.
+
+    `Stream::write(z_params&, Flush, error_code&)` stops when the
+    input is used up or the output is full, so output space left
+    over after a call means the current input was fully consumed
+    (and any flush completed). At that point the next buffer in
+    the input sequence is presented, and the last buffer is given
+    the caller's flush value.
+
+    `hint` maps the number of input bytes currently presented to
+    the size passed to `prepare`.
+
+    Returns the number of input bytes consumed, which is less than
+    the size of the input only when the stream ended or failed.
+*/
+template<class Stream,
+    class ConstBufferSequence, class DynamicBuffer, class Hint>
+std::size_t
+write_buffers(Stream& s, ConstBufferSequence const& buffers,
+    DynamicBuffer& dynabuf, Flush flush, error_code& ec,
+        Hint const& hint)
+{
+    using boost::asio::buffer_cast;
+    using boost::asio::buffer_size;
+    ec = {};
+    z_params zs;
+    zs.next_in = nullptr;
+    zs.avail_in = 0;
+    auto it = buffers.begin();
+    auto const end = buffers.end();
+    for(;;)
+    {
+        while(zs.avail_in == 0 && it != end)
+        {
+            boost::asio::const_buffer const b = *it++;
+            zs.next_in = buffer_cast<void const*>(b);
+            zs.avail_in = buffer_size(b);
+        }
+        bool const last = it == end;
+        bool full = true;
+        std::size_t n = 0;
+        auto const mb = dynabuf.prepare(hint(zs.avail_in));
+        for(auto mit = mb.begin(); mit != mb.end(); ++mit)
+        {
+            boost::asio::mutable_buffer const b = *mit;
+            zs.next_out = buffer_cast<void*>(b);
+            zs.avail_out = buffer_size(b);
+            if(zs.avail_out == 0)
+                continue;
+            s.write(zs, last ? flush : Flush::none, ec);
+            n += buffer_size(b) - zs.avail_out;
+            if(ec || zs.avail_out > 0)
+            {
+                full = false;
+                break;
+            }
+        }
+        dynabuf.commit(n);
+        if(ec == error::need_buffers)
+            ec = {};
+        else if(ec)
+            break;
+        if(! full && last)
+            break;
+    }
+    return zs.total_in;
+}
+
+} // detail
+} // zlib
+} // beast
+
+#endif
@@ -118,6 +118,15 @@ enum class error
     /// Incomplete length set
     incomplete_length_set,
 
+    //
+    // Errors generated by the zlib and gzip wrappers
+    //
+
+    /// Incorrect header check
+    invalid_header,
+
+    /// Incorrect data check
+    incorrect_check,
 
 
     /// general error
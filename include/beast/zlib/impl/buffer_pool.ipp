@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_ZLIB_IMPL_BUFFER_POOL_IPP
+#define BEAST_ZLIB_IMPL_BUFFER_POOL_IPP
+
+namespace beast {
+namespace zlib {
+
+inline
+buffer_pool::
+~buffer_pool()
+{
+    shrink_to_fit();
+}
+
+inline
+std::uint8_t*
+buffer_pool::
+allocate(std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        used_ += size;
+        for(auto& b : buckets_)
+        {
+            if(b.size != size)
+                continue;
+            if(b.blocks.empty())
+                break;
+            auto const p = b.blocks.back();
+            b.blocks.pop_back();
+            idle_ -= size;
+            return p;
+        }
+    }
+    try
+    {
+        return new std::uint8_t[size];
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        used_ -= size;
+        throw;
+    }
+}
+
+inline
+void
+buffer_pool::
+deallocate(std::uint8_t* p, std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        used_ -= size;
+        if(idle_ + size <= max_idle_)
+        {
+            bucket* pb = nullptr;
+            for(auto& b : buckets_)
+            {
+                if(b.size == size)
+                {
+                    pb = &b;
+                    break;
+                }
+            }
+            try
+            {
+                if(! pb)
+                {
+                    buckets_.push_back(bucket{size, {}});
+                    pb = &buckets_.back();
+                }
+                pb->blocks.push_back(p);
+                idle_ += size;
+                return;
+            }
+            catch(...)
+            {
+                // out of memory for the list, free the block
+            }
+        }
+    }
+    delete[] p;
+}
+
+inline
+void
+buffer_pool::
+shrink_to_fit()
+{
+    std::vector<bucket> v;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        v.swap(buckets_);
+        idle_ = 0;
+    }
+    for(auto& b : v)
+        for(auto p : b.blocks)
+            delete[] p;
+}
+
+} // zlib
+} // beast
+
+#endif
@@ -83,6 +83,9 @@ public:
         case error::over_subscribed_length: return "over-subscribed length";
         case error::incomplete_length_set: return "incomplete length set";
 
+        case error::invalid_header: return "incorrect header check";
+        case error::incorrect_check: return "incorrect data check";
+
         case error::general:
         default:
             return "zlib error";
@@ -35,7 +35,11 @@
 #ifndef BEAST_ZLIB_INFLATE_STREAM_HPP
 #define BEAST_ZLIB_INFLATE_STREAM_HPP
 
+#include <beast/zlib/buffer_pool.hpp>
 #include <beast/zlib/detail/inflate_stream.hpp>
+#include <beast/zlib/detail/write_buffers.hpp>
+#include <beast/core/buffer_concepts.hpp>
+#include <algorithm>
 
 namespace beast {
 namespace zlib {
@@ -92,7 +96,9 @@ public:
 
     /** Put the stream in a newly constructed state.
 
-        All dynamically allocated memory is de-allocated.
+        All dynamically allocated memory is de-allocated, or
+        returned to the pool if one is set. The window size
+        is left unchanged.
     */
     void
     clear()
@@ -100,6 +106,48 @@ public:
         doClear();
     }
 
+    /** Set the pool used for the sliding window.
+
+        When a pool is set, the sliding window is borrowed from the
+        pool when first needed, and returned to the pool when the
+        stream is cleared or destroyed. To hold the window only while
+        a message is being decompressed, call @ref clear after each
+        message is complete.
+
+        This function performs the equivalent of calling @ref clear
+        before changing the pool.
+
+        @param p A pointer to the pool, or `nullptr` to allocate
+        the window from the free store. The pool must outlive
+        the stream, or remain valid until the pool is changed.
+    */
+    void
+    pool(buffer_pool* p)
+    {
+        doPool(p);
+    }
+
+    /** Set the preset dictionary.
+
+        This function initializes the decompression window from the
+        given byte sequence, which must be identical to the dictionary
+        used by the compressor. A raw deflate stream does not identify
+        its dictionary, so the application must agree on it by other
+        means. It should be called after a reset and before the first
+        call to @ref write. Only the last window size bytes of the
+        dictionary are used.
+
+        @param data A pointer to the dictionary bytes.
+
+        @param size The number of bytes in the dictionary.
+    */
+    void
+    dictionary(void const* data, std::size_t size)
+    {
+        doDictionary(
+            static_cast<std::uint8_t const*>(data), size);
+    }
+
     /** Decompress input and produce output.
 
         This function decompresses as much data as possible, and stops when
@@ -206,6 +254,56 @@ public:
     {
         doWrite(zs, flush, ec);
     }
+
+    /** Decompress a buffer sequence into a dynamic buffer.
+
+        This function decompresses the input, writing the output
+        directly into memory obtained from the dynamic buffer's
+        `prepare` member and committing it as it is produced. The
+        buffers in the input sequence are presented to the
+        decompressor in turn, so no copy of the input or the output
+        is made.
+
+        The function returns when all of the input is consumed and
+        all of the output it produces has been written, or when the
+        end of the compressed data is reached, in which case the
+        error `error::end_of_stream` is returned and any input
+        following the compressed data is not consumed.
+
+        @param buffers The input to decompress.
+
+        @param dynabuf The dynamic buffer to receive the output.
+
+        @param flush The flush parameter, as for the overload
+        taking @ref z_params.
+
+        @param ec Set to the error, if any occurred.
+
+        @return The number of bytes of input consumed.
+    */
+    template<class ConstBufferSequence, class DynamicBuffer>
+    std::size_t
+    write(
+        ConstBufferSequence const& buffers,
+        DynamicBuffer& dynabuf,
+        Flush flush,
+        error_code& ec)
+    {
+        static_assert(is_ConstBufferSequence<
+            ConstBufferSequence>::value,
+                "ConstBufferSequence requirements not met");
+        static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+            "DynamicBuffer requirements not met");
+        return detail::write_buffers(*this,
+            buffers, dynabuf, flush, ec,
+            [](std::size_t n)
+            {
+                // Guess a typical ratio, the loop asks
+                // for more space if the guess is short.
+                return (std::max<std::size_t>)(1024,
+                    (std::min<std::size_t>)(4 * n, 65536));
+            });
+    }
 };
 
 } // zlib
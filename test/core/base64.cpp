@@ -9,6 +9,8 @@
 #include <beast/core/detail/base64.hpp>
 
 #include <beast/unit_test/suite.hpp>
+#include <random>
+#include <string>
 
 namespace beast {
 namespace detail {
@@ -24,6 +26,108 @@ public:
         BEAST_EXPECT(base64_decode (encoded) == in);
     }
 
+    // Encode one triplet at a time
+    static
+    std::string
+    encode_ref(std::string const& in)
+    {
+        auto const tab = base64_alphabet();
+        std::string out;
+        std::size_t i = 0;
+        for(; i + 3 <= in.size(); i += 3)
+        {
+            auto const v =
+                (static_cast<unsigned>(static_cast<unsigned char>(in[i])) << 16) |
+                (static_cast<unsigned>(static_cast<unsigned char>(in[i+1])) << 8) |
+                 static_cast<unsigned>(static_cast<unsigned char>(in[i+2]));
+            out += tab[(v >> 18) & 0x3f];
+            out += tab[(v >> 12) & 0x3f];
+            out += tab[(v >>  6) & 0x3f];
+            out += tab[ v        & 0x3f];
+        }
+        if(i < in.size())
+        {
+            unsigned v = static_cast<unsigned char>(in[i]) << 16;
+            if(i + 1 < in.size())
+                v |= static_cast<unsigned char>(in[i+1]) << 8;
+            out += tab[(v >> 18) & 0x3f];
+            out += tab[(v >> 12) & 0x3f];
+            out += i + 1 < in.size() ? tab[(v >> 6) & 0x3f] : '=';
+            out += '=';
+        }
+        return out;
+    }
+
+    void
+    testRandom()
+    {
+        std::mt19937 g;
+        std::string s;
+        for(std::size_t n = 0; n < 300; ++n)
+        {
+            auto const encoded = base64_encode(s);
+            BEAST_EXPECT(encoded == encode_ref(s));
+            BEAST_EXPECT(base64_decode(encoded) == s);
+            s.push_back(static_cast<char>(g()));
+        }
+    }
+
+    void
+    testInvalid()
+    {
+        // Decoding stops at the first invalid character,
+        // wherever it falls relative to the vector width.
+        std::mt19937 g;
+        std::string in(96, 0);
+        for(std::size_t i = 0; i < in.size(); ++i)
+            in[i] = static_cast<char>(g());
+        auto const encoded = base64_encode(in);
+        for(unsigned c = 0; c < 256; ++c)
+        {
+            if(is_base64(static_cast<unsigned char>(c)))
+                continue;
+            for(std::size_t pos = 0; pos < encoded.size(); pos += 5)
+            {
+                auto s = encoded;
+                s[pos] = static_cast<char>(c);
+                std::string out;
+                out.resize(base64_decoded_size(s.size()));
+                auto const result = base64_decode(
+                    &out[0], s.data(), s.size());
+                BEAST_EXPECT(result.second == pos);
+                BEAST_EXPECT(result.first == base64_decoded_size(pos));
+                BEAST_EXPECT(out.substr(0, result.first) ==
+                    in.substr(0, result.first));
+            }
+        }
+    }
+
+    void
+    testBuffer()
+    {
+        BEAST_EXPECT(base64_encoded_size(0) == 0);
+        BEAST_EXPECT(base64_encoded_size(1) == 4);
+        BEAST_EXPECT(base64_encoded_size(3) == 4);
+        BEAST_EXPECT(base64_encoded_size(20) == 28);
+        BEAST_EXPECT(base64_decoded_size(4) == 3);
+        BEAST_EXPECT(base64_decoded_size(3) == 2);
+        BEAST_EXPECT(base64_decoded_size(28) == 21);
+
+        char buf[28];
+        std::uint8_t const digest[20] = {
+            1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+            11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+        auto const n = base64_encode(buf, digest, sizeof(digest));
+        BEAST_EXPECT(n == 28);
+        BEAST_EXPECT(std::string(buf, n) ==
+            "AQIDBAUGBwgJCgsMDQ4PEBESExQ=");
+        std::uint8_t out[21];
+        auto const result = base64_decode(out, buf, n);
+        BEAST_EXPECT(result.first == 20);
+        BEAST_EXPECT(result.second == 27);
+        BEAST_EXPECT(std::memcmp(out, digest, 20) == 0);
+    }
+
     void
     run()
     {
@@ -34,6 +138,9 @@ public:
         check ("foob",   "Zm9vYg==");
         check ("fooba",  "Zm9vYmE=");
         check ("foobar", "Zm9vYmFy");
+        testRandom();
+        testInvalid();
+        testBuffer();
     }
 };
 
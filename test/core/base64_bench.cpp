@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/detail/base64.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <string>
+#include <utility>
+
+namespace beast {
+namespace detail {
+
+// Compare the buffer base64 functions with
+// encoding one triplet at a time.
+//
+class base64_bench_test : public beast::unit_test::suite
+{
+public:
+    // Encode one triplet at a time
+    static
+    std::string
+    encode_ref(std::string const& in)
+    {
+        auto const tab = base64_alphabet();
+        std::string out;
+        std::size_t i = 0;
+        for(; i + 3 <= in.size(); i += 3)
+        {
+            auto const v =
+                (static_cast<unsigned>(static_cast<unsigned char>(in[i])) << 16) |
+                (static_cast<unsigned>(static_cast<unsigned char>(in[i+1])) << 8) |
+                 static_cast<unsigned>(static_cast<unsigned char>(in[i+2]));
+            out += tab[(v >> 18) & 0x3f];
+            out += tab[(v >> 12) & 0x3f];
+            out += tab[(v >>  6) & 0x3f];
+            out += tab[ v        & 0x3f];
+        }
+        if(i < in.size())
+        {
+            unsigned v = static_cast<unsigned char>(in[i]) << 16;
+            if(i + 1 < in.size())
+                v |= static_cast<unsigned char>(in[i+1]) << 8;
+            out += tab[(v >> 18) & 0x3f];
+            out += tab[(v >> 12) & 0x3f];
+            out += i + 1 < in.size() ? tab[(v >> 6) & 0x3f] : '=';
+            out += '=';
+        }
+        return out;
+    }
+
+    void
+    run() override
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        std::string const in(1024 * 1024, '*');
+        std::string out;
+        out.resize(base64_encoded_size(in.size()));
+        std::size_t const times = 20;
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0; i < times; ++i)
+            base64_encode(&out[0], in.data(), in.size());
+        auto const t1 = clock_type::now();
+        std::string ref;
+        for(std::size_t i = 0; i < times; ++i)
+            ref = encode_ref(in);
+        auto const t2 = clock_type::now();
+        BEAST_EXPECT(out == ref);
+        std::string dec;
+        dec.resize(base64_decoded_size(out.size()));
+        std::pair<std::size_t, std::size_t> result;
+        for(std::size_t i = 0; i < times; ++i)
+            result = base64_decode(&dec[0], out.data(), out.size());
+        auto const t3 = clock_type::now();
+        dec.resize(result.first);
+        BEAST_EXPECT(dec == in);
+        auto const us =
+            [](clock_type::duration d)
+            {
+                return static_cast<std::size_t>(
+                    duration_cast<microseconds>(d).count());
+            };
+        log <<
+            times << " x " << in.size() << " bytes: " <<
+            "encode " << us(t1 - t0) << "us, " <<
+            "triplet encode " << us(t2 - t1) << "us, " <<
+            "decode " << us(t3 - t2) << "us" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(base64_bench,core,beast);
+
+} // detail
+} // beast
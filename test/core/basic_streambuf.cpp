@@ -461,6 +461,54 @@ public:
         }
     }
 
+    void testShrinkToFit()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        {
+            streambuf sb{100};
+            sb.shrink_to_fit();
+            BEAST_EXPECT(sb.capacity() == 0);
+            sb.commit(buffer_copy(sb.prepare(50), buffer("*", 1)));
+            sb.consume(1);
+            BEAST_EXPECT(sb.capacity() > 0);
+            sb.shrink_to_fit();
+            BEAST_EXPECT(sb.capacity() == 0);
+            BEAST_EXPECT(sb.size() == 0);
+        }
+        {
+            std::string const s(250, '*');
+            streambuf sb{100};
+            sb.commit(buffer_copy(sb.prepare(250), buffer(s)));
+            sb.prepare(500);
+            sb.shrink_to_fit();
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            BEAST_EXPECT(sb.capacity() == 250);
+            sb.consume(150);
+            sb.shrink_to_fit();
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(150));
+            BEAST_EXPECT(sb.capacity() == 100);
+            sb.commit(buffer_copy(sb.prepare(10), buffer(s)));
+            BEAST_EXPECT(sb.size() == 110);
+        }
+        {
+            // Input spread over several elements
+            std::string const s(1000, '*');
+            streambuf sb{10};
+            for(std::size_t i = 0; i < 100; ++i)
+                sb.commit(buffer_copy(
+                    sb.prepare(10), buffer(&s[i * 10], 10)));
+            sb.consume(5);
+            sb.prepare(20);
+            sb.shrink_to_fit();
+            BEAST_EXPECT(sb.capacity() == 995);
+            BEAST_EXPECT(test::buffer_count(sb.data()) == 1);
+            BEAST_EXPECT(to_string(sb.data()) == s.substr(5));
+            sb.commit(buffer_copy(sb.prepare(1), buffer(s)));
+            BEAST_EXPECT(sb.size() == 996);
+        }
+    }
+
     void run() override
     {
         testSpecialMembers();
@@ -472,6 +520,7 @@ public:
         testIterators();
         testOutputStream();
         testCapacity();
+        testShrinkToFit();
     }
 };
 
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/block_pool.hpp>
+
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+
+class block_pool_test : public beast::unit_test::suite
+{
+public:
+    void
+    testPool()
+    {
+        {
+            block_pool pool;
+            BEAST_EXPECT(pool.classes() == 3);
+            BEAST_EXPECT(pool.class_size(0) == 4096);
+            BEAST_EXPECT(pool.class_size(2) == 65536);
+            auto const p = pool.allocate(100);
+            auto s = pool.stats();
+            BEAST_EXPECT(s.misses == 1);
+            BEAST_EXPECT(s.hits == 0);
+            BEAST_EXPECT(s.used == 4096 + block_pool::headroom);
+            pool.deallocate(p, 100);
+            s = pool.stats();
+            BEAST_EXPECT(s.used == 0);
+            BEAST_EXPECT(s.idle == 4096 + block_pool::headroom);
+
+            // any size in the class reuses the block
+            BEAST_EXPECT(pool.allocate(4096 + 24) == p);
+            s = pool.stats();
+            BEAST_EXPECT(s.hits == 1);
+            BEAST_EXPECT(s.idle == 0);
+            pool.deallocate(p, 4096 + 24);
+
+            auto const p2 = pool.allocate(5000);
+            BEAST_EXPECT(p2 != p);
+            BEAST_EXPECT(pool.stats(1).misses == 1);
+            BEAST_EXPECT(pool.stats(0).misses == 1);
+            pool.deallocate(p2, 5000);
+
+            // oversize requests are not pooled
+            auto const p3 = pool.allocate(100000);
+            s = pool.stats();
+            BEAST_EXPECT(s.oversize == 1);
+            BEAST_EXPECT(s.used == 100000);
+            pool.deallocate(p3, 100000);
+            BEAST_EXPECT(pool.stats().used == 0);
+
+            pool.shrink_to_fit();
+            BEAST_EXPECT(pool.stats().idle == 0);
+        }
+        {
+            block_pool pool{{100, 200}, 300};
+            void* v[4];
+            for(auto& p : v)
+                p = pool.allocate(180);
+            for(auto& p : v)
+                pool.deallocate(p, 180);
+            auto const s = pool.stats();
+            BEAST_EXPECT(s.misses == 4);
+            BEAST_EXPECT(s.idle == 200 + block_pool::headroom);
+            BEAST_EXPECT(s.used == 0);
+        }
+    }
+
+    void
+    testAllocator()
+    {
+        block_pool pool;
+        pool_allocator<char> a1{pool};
+        pool_allocator<int> a2{a1};
+        BEAST_EXPECT(a1 == a2);
+        BEAST_EXPECT(&a2.pool() == &pool);
+        block_pool pool2;
+        BEAST_EXPECT(a1 != pool_allocator<char>{pool2});
+
+        using streambuf_type = basic_streambuf<pool_allocator<char>>;
+        std::string const s(10000, '*');
+        for(int i = 0; i < 3; ++i)
+        {
+            streambuf_type sb{4096, a1};
+            for(std::size_t j = 0; j < s.size(); j += 1000)
+                sb.commit(boost::asio::buffer_copy(sb.prepare(1000),
+                    boost::asio::buffer(s.data() + j, 1000)));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            sb.consume(5000);
+            BEAST_EXPECT(sb.size() == 5000);
+        }
+        auto const st = pool.stats(0);
+        BEAST_EXPECT(st.misses == 3);
+        BEAST_EXPECT(st.hits == 6);
+        BEAST_EXPECT(st.used == 0);
+    }
+
+    void
+    testThreads()
+    {
+        block_pool pool;
+        std::vector<std::thread> v;
+        for(int i = 0; i < 4; ++i)
+            v.emplace_back([&pool, i]
+            {
+                std::size_t const size = i % 2 ? 4096 : 16384;
+                std::vector<void*> blocks;
+                for(int j = 0; j < 1000; ++j)
+                {
+                    blocks.push_back(pool.allocate(size));
+                    if(j % 3 == 0)
+                    {
+                        for(auto p : blocks)
+                            pool.deallocate(p, size);
+                        blocks.clear();
+                    }
+                }
+                for(auto p : blocks)
+                    pool.deallocate(p, size);
+            });
+        for(auto& t : v)
+            t.join();
+        auto const s = pool.stats();
+        BEAST_EXPECT(s.hits + s.misses == 4000);
+        BEAST_EXPECT(s.used == 0);
+    }
+
+    void
+    run() override
+    {
+        testPool();
+        testAllocator();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(block_pool,core,beast);
+
+} // beast
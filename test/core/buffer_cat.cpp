@@ -205,6 +205,52 @@ public:
         BEAST_EXPECT(it == it2);
     }
 
+    template<std::size_t N>
+    void testFlat()
+    {
+        using boost::asio::buffer_size;
+        using boost::asio::const_buffer;
+        char buf[10];
+        std::list<const_buffer> b1;
+        std::vector<const_buffer> b2{
+            const_buffer{buf+0, 1},
+            const_buffer{buf+1, 2}};
+        std::array<const_buffer, 3> b3{{
+            const_buffer{buf+3, 1},
+            const_buffer{buf+4, 0},
+            const_buffer{buf+4, 5}}};
+        std::list<const_buffer> b4{
+            const_buffer{buf+9, 1}};
+        auto bs = flat_buffer_cat<N>(b1, b2, b3, b4);
+        BEAST_EXPECT(buffer_size(bs) == 10);
+        BEAST_EXPECT(bsize1(bs) == 10);
+        BEAST_EXPECT(bsize2(bs) == 10);
+        BEAST_EXPECT(bsize3(bs) == 10);
+        BEAST_EXPECT(bsize4(bs) == 10);
+        // The empty buffer is skipped only when flattened
+        BEAST_EXPECT(std::distance(bs.begin(), bs.end()) ==
+            (N >= 5 ? 5 : 6));
+        auto bs2(bs);
+        BEAST_EXPECT(bsize1(bs2) == 10);
+        BEAST_EXPECT(bs.begin() != bs2.begin());
+        {
+            auto it = bs.begin();
+            decltype(it) it2;
+            it2 = it++;
+            BEAST_EXPECT(it2 == bs.begin());
+            BEAST_EXPECT(it != it2);
+            it--;
+            BEAST_EXPECT(it == it2);
+            BEAST_EXPECT(boost::asio::buffer_cast<
+                char const*>(*it) == buf);
+        }
+        {
+            std::list<const_buffer> e;
+            auto const be = flat_buffer_cat<N>(e, e);
+            BEAST_EXPECT(be.begin() == be.end());
+        }
+    }
+
     void run() override
     {
         using boost::asio::const_buffer;
@@ -261,8 +307,18 @@ public:
                 std::declval<const_buffer>()
                     ))::value_type>::value, "");
 
+        // Ensure that flattening keeps mutability
+        static_assert(std::is_same<
+            mutable_buffer,
+            decltype(flat_buffer_cat(
+                std::declval<mutable_buffers_1>(),
+                std::declval<mutable_buffers_1>()
+                    ))::value_type>::value, "");
+
         testBufferCat();
         testIterators();
+        testFlat<16>();
+        testFlat<2>();
     }
 };
 
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/error.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace beast {
+
+// Compare buffer_cat with flat_buffer_cat when written
+// to a stream which takes part of the data on each call.
+//
+class buffer_cat_bench_test : public beast::unit_test::suite
+{
+public:
+    // A stream which accepts at most `limit` bytes
+    // in each call to write_some, and discards them.
+    struct limited_stream
+    {
+        std::size_t limit;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& bs, error_code& ec)
+        {
+            using boost::asio::buffer_size;
+            ec = {};
+            std::size_t n = 0;
+            for(auto it = bs.begin();
+                    it != bs.end() && n < limit; ++it)
+                n += buffer_size(*it);
+            return (std::min)(n, limit);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& bs)
+        {
+            error_code ec;
+            return write_some(bs, ec);
+        }
+    };
+
+    void
+    run() override
+    {
+        using boost::asio::buffer;
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        std::size_t const times = 20000;
+        // A header in a streambuf, then a body
+        // with its chunk size and trailing CRLF
+        beast::streambuf sb{64};
+        boost::asio::const_buffers_1 const delim{"3e8\r\n", 5};
+        boost::asio::const_buffers_1 const crlf{"\r\n", 2};
+        std::string const s(1000, '*');
+        sb.commit(boost::asio::buffer_copy(
+            sb.prepare(200), buffer(s)));
+        for(std::size_t limit : {64, 512, 65536})
+        {
+            limited_stream ls{limit};
+            error_code ec;
+            std::size_t n0 = 0;
+            std::size_t n1 = 0;
+            auto t0 = clock_type::now();
+            for(std::size_t i = 0; i < times; ++i)
+                n0 += boost::asio::write(ls, buffer_cat(sb.data(),
+                    delim, buffer(s), crlf), ec);
+            auto t1 = clock_type::now();
+            for(std::size_t i = 0; i < times; ++i)
+                n1 += boost::asio::write(ls, flat_buffer_cat(sb.data(),
+                    delim, buffer(s), crlf), ec);
+            auto t2 = clock_type::now();
+            BEAST_EXPECT(n0 == n1);
+            log <<
+                "write_some limit " << limit << ": " <<
+                "buffer_cat " << duration_cast<
+                    microseconds>(t1 - t0).count() << "us, " <<
+                "flat_buffer_cat " << duration_cast<
+                    microseconds>(t2 - t1).count() << "us" <<
+                std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(buffer_cat_bench,core,beast);
+
+} // beast
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/buffers_snapshot.hpp>
+
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <string>
+#include <type_traits>
+
+namespace beast {
+
+static_assert(is_ConstBufferSequence<buffers_snapshot<>>::value, "");
+static_assert(is_MutableBufferSequence<buffers_snapshot<16,
+    boost::asio::mutable_buffer>>::value, "");
+static_assert(std::is_nothrow_move_constructible<
+    buffers_snapshot<>>::value, "");
+
+class buffers_snapshot_test : public beast::unit_test::suite
+{
+public:
+    template<std::size_t N>
+    void
+    check(streambuf const& sb)
+    {
+        using boost::asio::buffer_size;
+        buffers_snapshot<N> bs{sb.data()};
+        BEAST_EXPECT(bs.size() == sb.size());
+        BEAST_EXPECT(buffer_size(bs) == sb.size());
+        BEAST_EXPECT(to_string(bs) == to_string(sb.data()));
+        auto const copy = bs;
+        BEAST_EXPECT(copy.count() == bs.count());
+        BEAST_EXPECT(to_string(copy) == to_string(sb.data()));
+    }
+
+    void
+    testSnapshot()
+    {
+        using boost::asio::buffer_size;
+        {
+            std::array<boost::asio::const_buffer, 3> const v = {{
+                { "Hello", 5 }, { "", 0 }, { ", world", 7 } }};
+            buffers_snapshot<> bs{v};
+            BEAST_EXPECT(bs.count() == 2);
+            BEAST_EXPECT(bs.size() == 12);
+            BEAST_EXPECT(to_string(bs) == "Hello, world");
+        }
+        for(std::size_t n : {0, 1, 3, 4, 5, 40})
+        {
+            streambuf sb{7};
+            std::string const s(n * 7 - (n > 0 ? 3 : 0), '*');
+            sb.commit(boost::asio::buffer_copy(
+                sb.prepare(s.size()), boost::asio::buffer(s)));
+            check<1>(sb);
+            check<4>(sb);
+            check<16>(sb);
+        }
+    }
+
+    void
+    run() override
+    {
+        testSnapshot();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(buffers_snapshot,core,beast);
+
+} // beast
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/detail/ci_char_traits.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+
+namespace beast {
+namespace detail {
+
+class ci_char_traits_test : public beast::unit_test::suite
+{
+public:
+    // Byte at a time reference implementations
+
+    static
+    bool
+    ref_equal(std::string const& s1, std::string const& s2)
+    {
+        return s1.size() == s2.size() && std::equal(
+            s1.begin(), s1.end(), s2.begin(), ci_equal_pred{});
+    }
+
+    static
+    bool
+    ref_less(std::string const& s1, std::string const& s2)
+    {
+        return std::lexicographical_compare(
+            s1.begin(), s1.end(), s2.begin(), s2.end(),
+            [](char c1, char c2)
+            {
+                return static_cast<std::uint8_t>(tolower(c1)) <
+                    static_cast<std::uint8_t>(tolower(c2));
+            });
+    }
+
+    void
+    testFold()
+    {
+        for(int i = 0; i < 256; ++i)
+        {
+            char buf[8];
+            std::fill(std::begin(buf), std::end(buf),
+                static_cast<char>(i));
+            auto const w = ci_fold(ci_load(buf));
+            char out[8];
+            std::memcpy(out, &w, 8);
+            for(auto c : out)
+                BEAST_EXPECT(c == tolower(static_cast<char>(i)));
+        }
+    }
+
+    void
+    testEqual()
+    {
+        BEAST_EXPECT(ci_equal("", ""));
+        BEAST_EXPECT(ci_equal("Host", "host"));
+        BEAST_EXPECT(ci_equal("CONTENT-LENGTH", "content-length"));
+        BEAST_EXPECT(! ci_equal("Content-Length", "Content-Lengtx"));
+        BEAST_EXPECT(! ci_equal("Content-Length", "Content-Length2"));
+        BEAST_EXPECT(! ci_equal("[", "{"));
+        BEAST_EXPECT(! ci_equal("@", "`"));
+        BEAST_EXPECT(ci_equal(std::string{"Upgrade"},
+            boost::string_ref{"UPGRADE"}));
+    }
+
+    void
+    testLess()
+    {
+        ci_less less;
+        BEAST_EXPECT(! less("", ""));
+        BEAST_EXPECT(less("", "a"));
+        BEAST_EXPECT(less("Accept", "accept-encoding"));
+        BEAST_EXPECT(less("ACCEPT-ENCODING", "accept-language"));
+        BEAST_EXPECT(! less("Host", "HOST"));
+        BEAST_EXPECT(less("Content-Length", "Content-Type"));
+        BEAST_EXPECT(less(std::string{"_"}, boost::string_ref{"Z"}));
+
+        // The standard looks for a nested type
+        static_assert(std::is_same<
+            ci_less::is_transparent, void>::value, "");
+#if __cplusplus >= 201402L
+        std::set<std::string, ci_less> set{"Host"};
+        BEAST_EXPECT(set.find(boost::string_ref{"HOST"}) != set.end());
+#endif
+    }
+
+    void
+    testRandom()
+    {
+        std::mt19937 g;
+        char const alphabet[] = "aAbBzZ-_@[`{\x7f\x80\xc1\xe1";
+        std::uniform_int_distribution<std::size_t> len(0, 40);
+        std::uniform_int_distribution<std::size_t> pick(
+            0, sizeof(alphabet) - 2);
+        std::uniform_int_distribution<int> flip(0, 3);
+        ci_less less;
+        ci_hash hash;
+        for(int i = 0; i < 20000; ++i)
+        {
+            std::string s1;
+            auto const n = len(g);
+            for(std::size_t j = 0; j < n; ++j)
+                s1.push_back(alphabet[pick(g)]);
+            // Mostly the same string with the case changed
+            std::string s2 = s1;
+            for(auto& c : s2)
+                if(flip(g) == 0)
+                    c = (c >= 'a' && c <= 'z') ?
+                        static_cast<char>(c - 32) : c;
+            if(flip(g) == 0 && ! s2.empty())
+                s2[pick(g) % s2.size()] = alphabet[pick(g)];
+            if(flip(g) == 0)
+                s2.resize(len(g), 'x');
+            BEAST_EXPECT(ci_equal(s1, s2) == ref_equal(s1, s2));
+            BEAST_EXPECT(less(s1, s2) == ref_less(s1, s2));
+            BEAST_EXPECT(less(s2, s1) == ref_less(s2, s1));
+            if(ref_equal(s1, s2))
+                BEAST_EXPECT(hash(s1) == hash(s2));
+        }
+    }
+
+    void
+    testHash()
+    {
+        ci_hash hash;
+        BEAST_EXPECT(hash("Content-Type") == hash("content-type"));
+        BEAST_EXPECT(hash(std::string{"Sec-WebSocket-Key"}) ==
+            hash(boost::string_ref{"SEC-WEBSOCKET-KEY"}));
+        BEAST_EXPECT(hash("Accept") != hash("Accept-Charset"));
+        BEAST_EXPECT(hash("") != hash(std::string(1, '\0')));
+        static_assert(std::is_same<
+            ci_hash::is_transparent, void>::value, "");
+    }
+
+    void
+    run() override
+    {
+        testFold();
+        testEqual();
+        testLess();
+        testRandom();
+        testHash();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ci_char_traits,core,beast);
+
+} // detail
+} // beast
@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace beast {
+namespace detail {
+
+// Compare the case-insensitive functions used for
+// field names against byte at a time versions.
+//
+class ci_char_traits_bench_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::high_resolution_clock;
+
+    static std::size_t constexpr Trials = 3;
+
+    // Byte at a time, as ci_less was before
+    struct byte_less
+    {
+        bool
+        operator()(std::string const& lhs,
+            std::string const& rhs) const
+        {
+            return std::lexicographical_compare(
+                lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                [](char c1, char c2)
+                {
+                    return tolower(c1) < tolower(c2);
+                });
+        }
+    };
+
+    struct byte_equal
+    {
+        bool
+        operator()(std::string const& lhs,
+            std::string const& rhs) const
+        {
+            return lhs.size() == rhs.size() && std::equal(
+                lhs.begin(), lhs.end(), rhs.begin(),
+                    ci_equal_pred{});
+        }
+    };
+
+    struct word_equal
+    {
+        bool
+        operator()(std::string const& lhs,
+            std::string const& rhs) const
+        {
+            return ci_equal(lhs, rhs);
+        }
+    };
+
+    // Field names seen in typical requests and
+    // responses, in the case senders usually use.
+    static
+    std::vector<std::string>
+    names()
+    {
+        return {
+            "Host", "User-Agent", "Accept", "Accept-Language",
+            "Accept-Encoding", "Connection", "Cookie", "Referer",
+            "Cache-Control", "Content-Type", "Content-Length",
+            "Upgrade-Insecure-Requests", "If-None-Match",
+            "If-Modified-Since", "Date", "Server", "Set-Cookie",
+            "Last-Modified", "ETag", "Expires", "Vary",
+            "Transfer-Encoding", "Content-Encoding", "Location",
+            "Access-Control-Allow-Origin", "X-Forwarded-For",
+            "X-Requested-With", "Authorization", "Pragma",
+            "Strict-Transport-Security", "Sec-WebSocket-Key",
+            "Sec-WebSocket-Version", "Origin", "Keep-Alive",
+        };
+    }
+
+    // Lookups as they arrive from the network, with
+    // some in lower case as HTTP/2 gateways send them.
+    static
+    std::vector<std::string>
+    lookups(std::vector<std::string> const& v)
+    {
+        std::mt19937 g;
+        std::uniform_int_distribution<std::size_t> d(0, v.size() - 1);
+        std::vector<std::string> result;
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            auto s = v[d(g)];
+            if(i % 4 == 0)
+                for(auto& c : s)
+                    c = tolower(c);
+            result.emplace_back(std::move(s));
+        }
+        return result;
+    }
+
+    // Returns the best time in nanoseconds per lookup
+    template<class Function>
+    static
+    double
+    timed(std::size_t n, Function&& f)
+    {
+        using namespace std::chrono;
+        double best = 0;
+        for(std::size_t i = 0; i < Trials; ++i)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = duration_cast<
+                duration<double>>(clock_type::now() - t0).count();
+            if(i == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best * 1e9 / n;
+    }
+
+    template<class Set>
+    static
+    std::size_t
+    find_all(Set const& set,
+        std::vector<std::string> const& v, std::size_t reps)
+    {
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < reps; ++i)
+            for(auto const& s : v)
+                n += set.count(s);
+        return n;
+    }
+
+    void
+    testBench()
+    {
+        std::size_t const reps = 2000;
+        auto const v = names();
+        auto const in = lookups(v);
+        std::set<std::string, byte_less> s0(v.begin(), v.end());
+        std::set<std::string, ci_less> s1(v.begin(), v.end());
+        std::unordered_set<std::string,
+            ci_hash, word_equal> s2(v.begin(), v.end());
+        std::size_t n[3];
+        double t[3];
+        t[0] = timed(reps * in.size(), [&]{
+            n[0] = find_all(s0, in, reps); });
+        t[1] = timed(reps * in.size(), [&]{
+            n[1] = find_all(s1, in, reps); });
+        t[2] = timed(reps * in.size(), [&]{
+            n[2] = find_all(s2, in, reps); });
+        BEAST_EXPECT(n[0] == reps * in.size());
+        BEAST_EXPECT(n[1] == n[0]);
+        BEAST_EXPECT(n[2] == n[0]);
+        char buf[80];
+        log << "nanoseconds per field lookup\n";
+        std::snprintf(buf, sizeof(buf), "%-24s %8.1f",
+            "set, byte compare", t[0]);
+        log << buf << std::endl;
+        std::snprintf(buf, sizeof(buf), "%-24s %8.1f",
+            "set, ci_less", t[1]);
+        log << buf << std::endl;
+        std::snprintf(buf, sizeof(buf), "%-24s %8.1f",
+            "unordered, ci_hash", t[2]);
+        log << buf << std::endl;
+
+        // Equality, as in token_list::exists
+        std::size_t m[2] = {0, 0};
+        double u[2];
+        u[0] = timed(reps * in.size(), [&]{
+            byte_equal eq;
+            for(std::size_t i = 0; i < reps; ++i)
+                for(std::size_t j = 0; j < in.size(); ++j)
+                    m[0] += eq(in[j], v[j % v.size()]); });
+        u[1] = timed(reps * in.size(), [&]{
+            word_equal eq;
+            for(std::size_t i = 0; i < reps; ++i)
+                for(std::size_t j = 0; j < in.size(); ++j)
+                    m[1] += eq(in[j], v[j % v.size()]); });
+        BEAST_EXPECT(m[0] == m[1]);
+        log << "nanoseconds per equality test\n";
+        std::snprintf(buf, sizeof(buf), "%-24s %8.1f",
+            "byte compare", u[0]);
+        log << buf << std::endl;
+        std::snprintf(buf, sizeof(buf), "%-24s %8.1f",
+            "ci_equal", u[1]);
+        log << buf << std::endl;
+    }
+
+    void
+    run() override
+    {
+        testBench();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ci_char_traits_bench,core,beast);
+
+} // detail
+} // beast
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/circular_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<circular_streambuf>::value, "");
+
+class circular_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class BufferSequence>
+    static
+    std::size_t
+    count(BufferSequence const& bs)
+    {
+        return std::distance(bs.begin(), bs.end());
+    }
+
+    template<class DynamicBuffer>
+    static
+    void
+    append(DynamicBuffer& b, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        b.commit(buffer_copy(
+            b.prepare(s.size()), buffer(s)));
+    }
+
+    void
+    testSequences()
+    {
+        using boost::asio::buffer_size;
+        std::string const s = "Hello, world";
+        for(std::size_t cap = s.size() + 1; cap < s.size() + 4; ++cap)
+        {
+            // start the input at every position in the ring
+            for(std::size_t k = 0; k < cap; ++k)
+            {
+                for(std::size_t i = 0; i <= s.size(); ++i)
+                {
+                    circular_streambuf b{cap};
+                    BEAST_EXPECT(b.capacity() == cap);
+                    append(b, std::string(k, '*'));
+                    append(b, "!");
+                    b.consume(k);
+                    append(b, s.substr(0, i));
+                    b.consume(1);
+                    append(b, s.substr(i));
+                    BEAST_EXPECT(b.size() == s.size());
+                    BEAST_EXPECT(to_string(b.data()) == s);
+                    BEAST_EXPECT(count(b.data()) <= 2);
+                    auto const mb = b.prepare(cap - s.size());
+                    BEAST_EXPECT(buffer_size(mb) == cap - s.size());
+                    b.consume(i);
+                    BEAST_EXPECT(to_string(b.data()) == s.substr(i));
+                }
+            }
+        }
+    }
+
+    void
+    testWrap()
+    {
+        using boost::asio::buffer_size;
+        circular_streambuf b{10};
+        append(b, "0123456");
+        b.consume(5);
+        append(b, "789abc");
+        BEAST_EXPECT(to_string(b.data()) == "56789abc");
+        BEAST_EXPECT(count(b.data()) == 2);
+        {
+            auto const mb = b.prepare(2);
+            BEAST_EXPECT(count(mb) == 1);
+            BEAST_EXPECT(buffer_size(mb) == 2);
+        }
+        try
+        {
+            b.prepare(3);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(b, 512) == 2);
+        append(b, "de");
+        BEAST_EXPECT(read_size_helper(b, 512) == 1);
+        BEAST_EXPECT(to_string(b.data()) == "56789abcde");
+
+        // consuming everything rewinds
+        b.consume(10);
+        BEAST_EXPECT(b.size() == 0);
+        {
+            auto const mb = b.prepare(10);
+            BEAST_EXPECT(count(mb) == 1);
+        }
+
+        // but not while output is pending
+        append(b, "xyz");
+        {
+            auto const mb = b.prepare(2);
+            boost::asio::buffer_copy(mb, boost::asio::buffer("uv", 2));
+            b.consume(3);
+            b.commit(2);
+        }
+        BEAST_EXPECT(to_string(b.data()) == "uv");
+    }
+
+    void
+    testMove()
+    {
+        circular_streambuf b1{20};
+        append(b1, "Hello");
+        circular_streambuf b2{std::move(b1)};
+        BEAST_EXPECT(to_string(b2.data()) == "Hello");
+        BEAST_EXPECT(b2.capacity() == 20);
+        BEAST_EXPECT(b1.size() == 0);
+        BEAST_EXPECT(b1.capacity() == 0);
+    }
+
+    void
+    run() override
+    {
+        testSequences();
+        testWrap();
+        testMove();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(circular_streambuf,core,beast);
+
+} // beast
@@ -12,6 +12,7 @@
 #include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/buffer.hpp>
+#include <iterator>
 #include <string>
 
 namespace beast {
@@ -114,8 +115,55 @@ public:
         BEAST_EXPECT(n == 3);
     }
 
+    // Single buffers behave like an array of one buffer
+    template<class BufferType, class Buffers1>
+    void testSingle()
+    {
+        using boost::asio::buffer_size;
+        std::string s = "Hello, world";
+        for(std::size_t x = 0; x <= s.size() + 1; ++x) {
+        for(std::size_t y = 0; y <= s.size() + 1; ++y) {
+        {
+            BufferType const b{&s[0], s.size()};
+            std::array<BufferType, 1> ba{{b}};
+            consuming_buffers<Buffers1> cb(Buffers1{b});
+            consuming_buffers<decltype(ba)> ca(ba);
+            expect_size(s.size(), cb);
+            cb.consume(x);
+            ca.consume(x);
+            BEAST_EXPECT(eq(cb, ca));
+            BEAST_EXPECT(std::distance(cb.begin(), cb.end()) ==
+                std::distance(ca.begin(), ca.end()));
+            auto cb2 = cb;
+            cb.consume(y);
+            ca.consume(y);
+            BEAST_EXPECT(eq(cb, ca));
+            BEAST_EXPECT(std::distance(cb.begin(), cb.end()) ==
+                std::distance(ca.begin(), ca.end()));
+            BEAST_EXPECT(to_string(cb2) ==
+                s.substr((std::min)(x, s.size())));
+            cb2 = cb;
+            BEAST_EXPECT(eq(cb2, cb));
+        }
+        }}
+        {
+            // An empty buffer is removed by consuming
+            consuming_buffers<Buffers1> cb(
+                Buffers1{BufferType{&s[0], 0}});
+            BEAST_EXPECT(std::distance(cb.begin(), cb.end()) == 1);
+            cb.consume(0);
+            BEAST_EXPECT(std::distance(cb.begin(), cb.end()) == 1);
+            cb.consume(1);
+            BEAST_EXPECT(cb.begin() == cb.end());
+        }
+    }
+
     void run() override
     {
+        testSingle<boost::asio::const_buffer,
+            boost::asio::const_buffers_1>();
+        testSingle<boost::asio::mutable_buffer,
+            boost::asio::mutable_buffers_1>();
         testMatrix();
         testNullBuffers();
         testIterator();
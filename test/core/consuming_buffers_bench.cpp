@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/consuming_buffers.hpp>
+#include <beast/core/prepare_buffers.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace beast {
+
+// Compare consuming_buffers over a one element array with
+// the specialization for a single buffer.
+//
+class consuming_buffers_bench_test : public beast::unit_test::suite
+{
+public:
+    // Split a buffer into frames the way stream::write_frame
+    // does with auto fragmentation, returning the best time.
+    template<class Buffers>
+    static
+    double
+    fragment(Buffers const& bs, std::size_t size,
+        std::size_t times, std::size_t& total)
+    {
+        using boost::asio::buffer_size;
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        double best = 0;
+        for(int trial = 0; trial < 3; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            for(std::size_t i = 0; i < times; ++i)
+            {
+                consuming_buffers<Buffers> cb(bs);
+                auto remain = buffer_size(bs);
+                while(remain > 0)
+                {
+                    auto const n = (std::min)(remain, size);
+                    total += buffer_size(prepare_buffers(n, cb));
+                    cb.consume(n);
+                    remain -= n;
+                }
+            }
+            auto const elapsed = duration_cast<duration<double>>(
+                clock_type::now() - t0).count();
+            if(trial == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    void
+    run() override
+    {
+        using boost::asio::const_buffer;
+        using boost::asio::const_buffers_1;
+        std::string const s(1024 * 1024, '*');
+        const_buffer const b{s.data(), s.size()};
+        std::array<const_buffer, 1> const ba{{b}};
+        std::size_t const times = 20;
+        for(std::size_t size : {std::size_t{512}, std::size_t{4096}})
+        {
+            std::size_t n0 = 0;
+            std::size_t n1 = 0;
+            auto const t0 = fragment(ba, size, times, n0);
+            auto const t1 = fragment(const_buffers_1{b}, size, times, n1);
+            BEAST_EXPECT(n0 == n1);
+            log <<
+                "frames of " << size << ": " <<
+                "array " << static_cast<std::size_t>(t0 * 1e6) << "us, " <<
+                "const_buffers_1 " << static_cast<std::size_t>(t1 * 1e6) << "us" <<
+                std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(consuming_buffers_bench,core,beast);
+
+} // beast
@@ -14,6 +14,7 @@
 #include <beast/test/yield_to.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio.hpp>
+#include <vector>
 
 namespace beast {
 
@@ -128,9 +129,198 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    // Bytes allocated by counting_allocator
+    static
+    std::size_t&
+    used()
+    {
+        static std::size_t n = 0;
+        return n;
+    }
+
+    template<class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template<class U>
+        counting_allocator(counting_allocator<U> const&)
+        {
+        }
+
+        T*
+        allocate(std::size_t n)
+        {
+            used() += n * sizeof(T);
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void
+        deallocate(T* p, std::size_t n)
+        {
+            used() -= n * sizeof(T);
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<class U>
+        friend
+        bool
+        operator==(counting_allocator const&,
+            counting_allocator<U> const&)
+        {
+            return true;
+        }
+
+        template<class U>
+        friend
+        bool
+        operator!=(counting_allocator const&,
+            counting_allocator<U> const&)
+        {
+            return false;
+        }
+    };
+
+    void testShrinkToFit()
+    {
+        using boost::asio::buffer;
+        using streambuf_type =
+            basic_streambuf<counting_allocator<char>>;
+        std::size_t const conns = 1000;
+        std::vector<std::unique_ptr<dynabuf_readstream<
+            test::string_stream, streambuf_type>>> v;
+        v.reserve(conns);
+        for(std::size_t i = 0; i < conns; ++i)
+        {
+            v.emplace_back(new dynabuf_readstream<
+                test::string_stream, streambuf_type>{
+                    ios_, std::string(100, '*')});
+            v.back()->capacity(4096);
+        }
+        char buf[10];
+        for(auto& p : v)
+            p->read_some(buffer(buf));
+        BEAST_EXPECT(used() >= conns * 4096);
+        // Idle connections give their memory back,
+        // keeping only the bytes already read.
+        for(auto& p : v)
+            p->shrink_to_fit();
+        BEAST_EXPECT(used() < conns * 256);
+        for(auto& p : v)
+        {
+            BEAST_EXPECT(p->buffer().size() == 90);
+            p->buffer().consume(90);
+            p->shrink_to_fit();
+        }
+        BEAST_EXPECT(used() == 0);
+    }
+
+    void testWaitReadable()
+    {
+        using boost::asio::buffer;
+        using socket_type = boost::asio::ip::tcp::socket;
+        boost::asio::io_service ios;
+        boost::asio::ip::tcp::acceptor a{ios,
+            boost::asio::ip::tcp::endpoint{
+                boost::asio::ip::address_v4::loopback(), 0}};
+        socket_type peer{ios};
+        dynabuf_readstream<socket_type, streambuf> srs{ios};
+        srs.next_layer().connect(a.local_endpoint());
+        a.accept(peer);
+        srs.capacity(4096);
+        srs.wait_readable(true);
+        BEAST_EXPECT(srs.wait_readable());
+        char buf[10];
+        std::size_t n = 0;
+        error_code ec;
+        srs.async_read_some(buffer(buf),
+            [&](error_code ec_, std::size_t n_)
+            {
+                ec = ec_;
+                n = n_;
+            });
+        ios.poll();
+        // No buffer is held while waiting
+        BEAST_EXPECT(n == 0);
+        BEAST_EXPECT(srs.buffer().capacity() == 0);
+        boost::asio::write(peer, buffer("Hello, world!", 13));
+        ios.reset();
+        ios.run();
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == 10);
+        BEAST_EXPECT(srs.buffer().size() == 3);
+        // The buffer is released when it is empty
+        srs.async_read_some(buffer(buf),
+            [&](error_code ec_, std::size_t n_)
+            {
+                ec = ec_;
+                n = n_;
+            });
+        ios.reset();
+        ios.run();
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(n == 3);
+        BEAST_EXPECT(std::string(buf, 3) == "ld!");
+        BEAST_EXPECT(srs.buffer().capacity() == 0);
+    }
+
+    void testPooled()
+    {
+        using boost::asio::buffer;
+        using socket_type = boost::asio::ip::tcp::socket;
+        using stream_type = pooled_readstream<socket_type>;
+        boost::asio::io_service ios;
+        boost::asio::ip::tcp::acceptor a{ios,
+            boost::asio::ip::tcp::endpoint{
+                boost::asio::ip::address_v4::loopback(), 0}};
+        block_pool pool;
+        std::size_t const n = 4;
+        std::vector<socket_type> peers;
+        std::vector<stream_type> v;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            v.emplace_back(stream_type::dynabuf_type{
+                4096, pool_allocator<char>{pool}}, ios);
+            peers.emplace_back(ios);
+            v.back().next_layer().connect(a.local_endpoint());
+            a.accept(peers.back());
+            v.back().capacity(4096);
+            v.back().wait_readable(true);
+        }
+        char buf[10];
+        std::size_t reads = 0;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            // Connections take turns, so
+            // one block serves all of them.
+            v[i].async_read_some(buffer(buf),
+                [&](error_code ec, std::size_t)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                    ++reads;
+                });
+            ios.poll();
+            ios.reset();
+            BEAST_EXPECT(pool.stats().used == 0);
+            boost::asio::write(peers[i], buffer("Hello", 5));
+            ios.run();
+            ios.reset();
+            BEAST_EXPECT(v[i].buffer().size() == 0);
+            BEAST_EXPECT(pool.stats().used == 0);
+        }
+        BEAST_EXPECT(reads == n);
+        BEAST_EXPECT(pool.stats().misses == 1);
+        BEAST_EXPECT(pool.stats().hits == n - 1);
+    }
+
     void run() override
     {
         testSpecialMembers();
+        testShrinkToFit();
+        testWaitReadable();
+        testPooled();
 
         yield_to(std::bind(&self::testRead,
             this, std::placeholders::_1));
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/flat_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<flat_streambuf>::value, "");
+
+class flat_streambuf_test : public beast::unit_test::suite
+{
+public:
+    template<class DynamicBuffer>
+    static
+    void
+    append(DynamicBuffer& b, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        b.commit(buffer_copy(
+            b.prepare(s.size()), buffer(s)));
+    }
+
+    void
+    testSequences()
+    {
+        using boost::asio::buffer_size;
+        flat_streambuf b;
+        BEAST_EXPECT(b.size() == 0);
+        BEAST_EXPECT(b.capacity() == 0);
+        BEAST_EXPECT(buffer_size(b.data()) == 0);
+        std::string const s = "Hello, world";
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            for(std::size_t j = 0; j <= s.size() - i; ++j)
+            {
+                b.consume(b.size());
+                append(b, s.substr(0, i));
+                append(b, s.substr(i, j));
+                append(b, s.substr(i + j));
+                BEAST_EXPECT(to_string(b.data()) == s);
+                b.consume(i);
+                BEAST_EXPECT(to_string(b.data()) == s.substr(i));
+                b.consume(j);
+                BEAST_EXPECT(to_string(b.data()) == s.substr(i + j));
+            }
+        }
+        {
+            auto const mb = b.prepare(5);
+            BEAST_EXPECT(buffer_size(mb) == 5);
+            b.commit(10);
+            BEAST_EXPECT(b.size() == 5);
+            b.consume(100);
+            BEAST_EXPECT(b.size() == 0);
+        }
+    }
+
+    void
+    testGrowth()
+    {
+        using boost::asio::buffer_cast;
+        flat_streambuf b;
+        b.prepare(1);
+        BEAST_EXPECT(b.capacity() == 512);
+
+        // compaction moves the input to the front
+        // instead of allocating
+        append(b, std::string(400, 'a'));
+        b.consume(300);
+        auto const p0 = buffer_cast<char const*>(b.data());
+        append(b, std::string(300, 'b'));
+        BEAST_EXPECT(b.capacity() == 512);
+        BEAST_EXPECT(b.size() == 400);
+        BEAST_EXPECT(buffer_cast<char const*>(b.data()) < p0);
+        BEAST_EXPECT(to_string(b.data()) ==
+            std::string(100, 'a') + std::string(300, 'b'));
+
+        // grows geometrically
+        append(b, std::string(200, 'c'));
+        BEAST_EXPECT(b.capacity() == 1024);
+        BEAST_EXPECT(b.size() == 600);
+        append(b, std::string(1000, 'd'));
+        BEAST_EXPECT(b.capacity() == 2048);
+        BEAST_EXPECT(to_string(b.data()) ==
+            std::string(100, 'a') + std::string(300, 'b') +
+            std::string(200, 'c') + std::string(1000, 'd'));
+
+        // consuming everything rewinds
+        b.consume(b.size());
+        BEAST_EXPECT(b.capacity() == 2048);
+        b.shrink_to_fit();
+        BEAST_EXPECT(b.capacity() == 0);
+        append(b, "x");
+        b.shrink_to_fit();
+        BEAST_EXPECT(b.capacity() == 1);
+        BEAST_EXPECT(to_string(b.data()) == "x");
+    }
+
+    void
+    testLimit()
+    {
+        flat_streambuf b{100};
+        BEAST_EXPECT(b.max_size() == 100);
+        append(b, std::string(60, '*'));
+        BEAST_EXPECT(b.capacity() == 100);
+        try
+        {
+            b.prepare(41);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        b.consume(20);
+        append(b, std::string(60, '*'));
+        BEAST_EXPECT(b.size() == 100);
+        BEAST_EXPECT(read_size_helper(b, 512) == 1);
+        b.consume(10);
+        BEAST_EXPECT(read_size_helper(b, 512) == 10);
+        BEAST_EXPECT(read_size_helper(b, 3) == 3);
+        {
+            flat_streambuf b2;
+            BEAST_EXPECT(read_size_helper(b2, 65536) == 512);
+            BEAST_EXPECT(read_size_helper(b2, 100) == 100);
+        }
+    }
+
+    void
+    testSpecialMembers()
+    {
+        std::string const s = "Hello, world";
+        flat_streambuf b1{1000};
+        append(b1, s);
+        b1.consume(7);
+        {
+            flat_streambuf b2{b1};
+            BEAST_EXPECT(to_string(b2.data()) == "world");
+            BEAST_EXPECT(b2.max_size() == 1000);
+            flat_streambuf b3{std::move(b2)};
+            BEAST_EXPECT(to_string(b3.data()) == "world");
+            BEAST_EXPECT(b2.size() == 0);
+            BEAST_EXPECT(b2.capacity() == 0);
+            append(b2, s);
+            BEAST_EXPECT(to_string(b2.data()) == s);
+        }
+        {
+            flat_streambuf b2;
+            b2 = b1;
+            BEAST_EXPECT(to_string(b2.data()) == "world");
+            flat_streambuf b3;
+            append(b3, s);
+            b3 = std::move(b2);
+            BEAST_EXPECT(to_string(b3.data()) == "world");
+            BEAST_EXPECT(b2.size() == 0);
+            b3 = b3;
+            BEAST_EXPECT(to_string(b3.data()) == "world");
+        }
+        {
+            basic_flat_streambuf<std::allocator<std::uint8_t>> b2{b1};
+            BEAST_EXPECT(to_string(b2.data()) == "world");
+        }
+    }
+
+    void
+    run() override
+    {
+        testSequences();
+        testGrowth();
+        testLimit();
+        testSpecialMembers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_streambuf,core,beast);
+
+} // beast
@@ -12,6 +12,7 @@
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/buffer.hpp>
 #include <string>
+#include <type_traits>
 
 namespace beast {
 
@@ -163,8 +164,33 @@ public:
         BEAST_EXPECT(n == 2);
     }
 
+    template<class BufferType, class Buffers1>
+    void testSingle()
+    {
+        std::string s = "Hello, world";
+        Buffers1 const b{BufferType{&s[0], s.size()}};
+        for(std::size_t i = 0; i <= s.size() + 1; ++i)
+        {
+            auto const pb = prepare_buffers(i, b);
+            static_assert(std::is_same<
+                decltype(pb), Buffers1 const>::value, "");
+            BEAST_EXPECT(to_string(pb) == s.substr(0, i));
+            consuming_buffers<Buffers1> cb(b);
+            cb.consume(i / 2);
+            auto const pc = prepare_buffers(i, cb);
+            static_assert(std::is_same<
+                decltype(pc), Buffers1 const>::value, "");
+            BEAST_EXPECT(to_string(pc) ==
+                s.substr(i / 2, i));
+        }
+    }
+
     void run() override
     {
+        testSingle<boost::asio::const_buffer,
+            boost::asio::const_buffers_1>();
+        testSingle<boost::asio::mutable_buffer,
+            boost::asio::mutable_buffers_1>();
         testMatrix<boost::asio::const_buffer>();
         testMatrix<boost::asio::mutable_buffer>();
         testNullBuffers();
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/read_size.hpp>
+
+#include <beast/core/dynabuf_readstream.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio.hpp>
+#include <string>
+
+namespace beast {
+
+class read_size_test : public beast::unit_test::suite
+{
+public:
+    // A stream which reports the bytes waiting to be read
+    struct avail_stream
+    {
+        std::size_t n;
+        std::size_t calls = 0;
+
+        explicit
+        avail_stream(std::size_t n_)
+            : n(n_)
+        {
+        }
+
+        std::size_t
+        available(error_code&)
+        {
+            ++calls;
+            return n;
+        }
+    };
+
+    struct plain_stream
+    {
+    };
+
+    void
+    testGrow()
+    {
+        read_size_policy rs{512, 4096};
+        plain_stream s;
+        BEAST_EXPECT(rs.min_size() == 512);
+        BEAST_EXPECT(rs.max_size() == 4096);
+        BEAST_EXPECT(rs.read_size(s) == 512);
+        rs.on_read(512, 512);
+        BEAST_EXPECT(rs.read_size(s) == 1024);
+        rs.on_read(1024, 1024);
+        BEAST_EXPECT(rs.read_size(s) == 2048);
+        rs.on_read(2048, 2048);
+        rs.on_read(4096, 4096);
+        BEAST_EXPECT(rs.read_size(s) == 4096);
+        // A partly filled read does not grow
+        rs.reset();
+        rs.on_read(512, 300);
+        BEAST_EXPECT(rs.size() == 512);
+        // Less space than the size says nothing
+        rs.on_read(100, 100);
+        BEAST_EXPECT(rs.size() == 512);
+    }
+
+    void
+    testShrink()
+    {
+        read_size_policy rs{512, 8192};
+        for(int i = 0; i < 4; ++i)
+            rs.on_read(rs.size(), rs.size());
+        BEAST_EXPECT(rs.size() == 8192);
+        for(std::size_t i = 0;
+                i < read_size_policy::shrink_after - 1; ++i)
+            rs.on_read(8192, 10);
+        BEAST_EXPECT(rs.size() == 8192);
+        // A read above a quarter starts over
+        rs.on_read(8192, 4000);
+        for(std::size_t i = 0;
+                i < read_size_policy::shrink_after - 1; ++i)
+            rs.on_read(8192, 10);
+        BEAST_EXPECT(rs.size() == 8192);
+        rs.on_read(8192, 10);
+        BEAST_EXPECT(rs.size() == 4096);
+        for(int i = 0; i < 100; ++i)
+            rs.on_read(rs.size(), 1);
+        BEAST_EXPECT(rs.size() == 512);
+    }
+
+    void
+    testAvailable()
+    {
+        read_size_policy rs{512, 65536};
+        avail_stream s{20000};
+        // Not queried unless the last read was full
+        BEAST_EXPECT(rs.read_size(s) == 512);
+        BEAST_EXPECT(s.calls == 0);
+        rs.on_read(512, 200);
+        BEAST_EXPECT(rs.read_size(s) == 512);
+        BEAST_EXPECT(s.calls == 0);
+        rs.on_read(512, 512);
+        BEAST_EXPECT(rs.read_size(s) == 20000);
+        BEAST_EXPECT(s.calls == 1);
+        // Never more than the maximum
+        s.n = 100000;
+        BEAST_EXPECT(rs.read_size(s) == 65536);
+        // Never less than the size
+        s.n = 10;
+        BEAST_EXPECT(rs.read_size(s) == 1024);
+        // A full read grows to the bytes received
+        rs.on_read(20000, 20000);
+        BEAST_EXPECT(rs.size() == 20000);
+    }
+
+    void
+    testCounters()
+    {
+        read_size_policy rs;
+        rs.on_read(512, 100);
+        rs.on_read(512, 512);
+        rs.on_read(1024, 0);
+        BEAST_EXPECT(rs.reads() == 3);
+        BEAST_EXPECT(rs.bytes() == 612);
+        rs.reset();
+        BEAST_EXPECT(rs.reads() == 0);
+        BEAST_EXPECT(rs.bytes() == 0);
+        BEAST_EXPECT(rs.size() == rs.min_size());
+    }
+
+    void
+    testReadStream()
+    {
+        using boost::asio::buffer;
+        boost::asio::io_service ios;
+        std::string const s(100000, '*');
+        dynabuf_readstream<test::string_stream, streambuf> srs{ios, s};
+        srs.read_size(read_size_policy{256, 8192});
+        std::string got;
+        char buf[100];
+        error_code ec;
+        for(;;)
+        {
+            auto const n = srs.read_some(buffer(buf), ec);
+            if(ec)
+                break;
+            got.append(buf, n);
+            BEAST_EXPECT(srs.buffer().size() < 8192);
+        }
+        BEAST_EXPECT(ec == boost::asio::error::eof);
+        BEAST_EXPECT(got == s);
+        BEAST_EXPECT(srs.read_size().bytes() == s.size());
+        BEAST_EXPECT(srs.read_size().size() == 8192);
+        // Setting the capacity removes the policy
+        dynabuf_readstream<test::string_stream, streambuf> srs2{ios, s};
+        srs2.read_size(read_size_policy{});
+        srs2.capacity(1000);
+        ec = {};
+        srs2.read_some(buffer(buf), ec);
+        BEAST_EXPECT(srs2.read_size().reads() == 0);
+        BEAST_EXPECT(srs2.buffer().size() == 900);
+    }
+
+    void
+    run() override
+    {
+        testGrow();
+        testShrink();
+        testAvailable();
+        testCounters();
+        testReadStream();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(read_size,core,beast);
+
+} // beast
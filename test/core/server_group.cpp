@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/server_group.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace beast {
+
+class server_group_test : public beast::unit_test::suite
+{
+public:
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    void
+    testAccept()
+    {
+        std::size_t const threads = 4;
+        std::size_t const conns = 64;
+        std::mutex m;
+        std::set<std::size_t> used;
+        std::set<std::thread::id> ids[threads];
+        std::atomic<std::size_t> count{0};
+        server_group g{threads};
+        BEAST_EXPECT(g.size() == threads);
+        g.open(endpoint_type{
+            boost::asio::ip::address_v4::loopback(), 0},
+            [&](socket_type&& sock, server_group::context& ctx)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    used.insert(ctx.index());
+                    ids[ctx.index()].insert(
+                        std::this_thread::get_id());
+                }
+                ++count;
+                // Reply with the index of the thread
+                char const c = static_cast<char>(ctx.index());
+                boost::asio::write(sock,
+                    boost::asio::buffer(&c, 1));
+            });
+        auto const ep = g.local_endpoint();
+        BEAST_EXPECT(ep.port() != 0);
+    #if defined(__linux__)
+        // Linux balances connections across listening sockets
+        BEAST_EXPECT(g.reuse_port());
+    #endif
+        boost::asio::io_service ios;
+        for(std::size_t i = 0; i < conns; ++i)
+        {
+            socket_type sock{ios};
+            sock.connect(ep);
+            char c = 0;
+            boost::asio::read(sock, boost::asio::buffer(&c, 1));
+            BEAST_EXPECT(static_cast<std::size_t>(c) < threads);
+        }
+        g.close();
+        BEAST_EXPECT(count == conns);
+        // Each context is run by a single thread
+        for(auto const& s : ids)
+            BEAST_EXPECT(s.size() <= 1);
+        // More than one thread took connections
+        BEAST_EXPECT(used.size() > 1);
+    }
+
+    void
+    testPool()
+    {
+        server_group g{2, true};
+        BEAST_EXPECT(g.size() == 2);
+        BEAST_EXPECT(! g.reuse_port());
+        for(std::size_t i = 0; i < g.size(); ++i)
+        {
+            auto& ctx = g.at(i);
+            BEAST_EXPECT(ctx.index() == i);
+            auto p = ctx.pool().allocate(100);
+            ctx.pool().deallocate(p, 100);
+            BEAST_EXPECT(ctx.pool().stats().idle > 0);
+        }
+        BEAST_EXPECT(&g.at(0).pool() != &g.at(1).pool());
+        BEAST_EXPECT(&g.at(0).get_io_service() !=
+            &g.at(1).get_io_service());
+    }
+
+    void
+    testReopen()
+    {
+        std::atomic<std::size_t> count{0};
+        server_group g{2};
+        auto const handler =
+            [&](socket_type&& sock, server_group::context&)
+            {
+                ++count;
+                char const c = '*';
+                boost::asio::write(sock,
+                    boost::asio::buffer(&c, 1));
+            };
+        boost::asio::io_service ios;
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            g.open(endpoint_type{
+                boost::asio::ip::address_v4::loopback(), 0},
+                    handler);
+            for(std::size_t j = 0; j < 8; ++j)
+            {
+                socket_type sock{ios};
+                sock.connect(g.local_endpoint());
+                char c = 0;
+                error_code ec;
+                boost::asio::read(sock,
+                    boost::asio::buffer(&c, 1), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(c == '*');
+            }
+            g.close();
+            BEAST_EXPECT(count == 8 * (i + 1));
+        }
+    }
+
+    void
+    testError()
+    {
+        server_group g1{1};
+        g1.open(endpoint_type{
+            boost::asio::ip::address_v4::loopback(), 0},
+            [](socket_type&&, server_group::context&)
+            {
+            });
+        // The port is in use by a socket without SO_REUSEPORT
+        boost::asio::io_service ios;
+        boost::asio::ip::tcp::acceptor a{ios,
+            endpoint_type{boost::asio::ip::address_v4::loopback(), 0}};
+        server_group g2{1};
+        error_code ec;
+        g2.open(a.local_endpoint(),
+            [](socket_type&&, server_group::context&)
+            {
+            }, ec);
+        BEAST_EXPECT(ec);
+    }
+
+    void
+    run() override
+    {
+        testAccept();
+        testPool();
+        testReopen();
+        testError();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(server_group,core,beast);
+
+} // beast
@@ -8,6 +8,8 @@
 #include <beast/core/detail/sha1.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <array>
+#include <random>
+#include <string>
 
 namespace beast {
 namespace detail {
@@ -57,6 +59,76 @@ public:
         BEAST_EXPECT(result == digest);
     }
 
+    static
+    std::string
+    digest(std::string const& message, std::size_t chunk)
+    {
+        sha1_context ctx;
+        std::string result;
+        result.resize(sha1_context::digest_size);
+        init(ctx);
+        for(std::size_t i = 0; i < message.size(); i += chunk)
+            update(ctx, message.data() + i,
+                (std::min)(chunk, message.size() - i));
+        finish(ctx, &result[0]);
+        return result;
+    }
+
+    // Process blocks without the SHA extensions
+    static
+    void
+    process_scalar(std::uint32_t digest[],
+        std::uint8_t const* p, std::size_t blocks)
+    {
+        std::uint32_t block[sha1::BLOCK_INTS];
+        for(; blocks > 0; --blocks, p += sha1::BLOCK_BYTES)
+        {
+            sha1::make_block(p, block);
+            sha1::transform(digest, block);
+        }
+    }
+
+    void
+    testChunks()
+    {
+        // Every padding length, fed whole and in pieces
+        std::mt19937 g;
+        std::string s;
+        for(std::size_t n = 0; n < 200; ++n)
+        {
+            auto const d = digest(s, (std::max<std::size_t>)(1, n));
+            BEAST_EXPECT(digest(s, 1) == d);
+            BEAST_EXPECT(digest(s, 7) == d);
+            BEAST_EXPECT(digest(s, 64) == d);
+            s.push_back(static_cast<char>(g()));
+        }
+    }
+
+    void
+    testBlocks()
+    {
+    #if BEAST_X86_INTRINSICS
+        if(! get_cpu_info().sha)
+            return;
+        std::mt19937 g;
+        std::uint8_t buf[8 * sha1::BLOCK_BYTES];
+        for(int i = 0; i < 100; ++i)
+        {
+            for(auto& c : buf)
+                c = static_cast<std::uint8_t>(g());
+            std::uint32_t d0[5];
+            std::uint32_t d1[5];
+            for(auto& v : d0)
+                v = g();
+            std::memcpy(d1, d0, sizeof(d0));
+            auto const blocks = 1 + i % 8;
+            sha1::transform_ni(d0, buf, blocks);
+            process_scalar(d1, buf, blocks);
+            BEAST_EXPECT(std::memcmp(d0, d1, sizeof(d0)) == 0);
+        }
+    #endif
+    }
+
     void
     run()
     {
@@ -70,6 +142,10 @@ public:
             "84983e44" "1c3bd26e" "baae4aa1" "f95129e5" "e54670f1");
         check("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
             "a49b2446" "a02c645b" "f419f995" "b6709125" "3a04a259");
+        check(std::string(1000000, 'a'),
+            "34aa973c" "d4c4daa4" "f61eeb2b" "dbad2731" "6534016f");
+        testChunks();
+        testBlocks();
     }
 };
 
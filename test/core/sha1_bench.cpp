@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/detail/sha1.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace beast {
+namespace detail {
+
+// Compare sha1::process, which uses the SHA extensions
+// when available, with the portable transform.
+//
+class sha1_bench_test : public beast::unit_test::suite
+{
+public:
+    // Process blocks without the SHA extensions
+    static
+    void
+    process_scalar(std::uint32_t digest[],
+        std::uint8_t const* p, std::size_t blocks)
+    {
+        std::uint32_t block[sha1::BLOCK_INTS];
+        for(; blocks > 0; --blocks, p += sha1::BLOCK_BYTES)
+        {
+            sha1::make_block(p, block);
+            sha1::transform(digest, block);
+        }
+    }
+
+    // Call f the given number of times, returning the best time
+    template<class F>
+    static
+    double
+    timeit(F const& f, std::size_t times)
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        double best = 0;
+        for(int trial = 0; trial < 3; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            for(std::size_t i = 0; i < times; ++i)
+                f();
+            auto const elapsed = duration_cast<duration<double>>(
+                clock_type::now() - t0).count();
+            if(trial == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    void
+    run() override
+    {
+        std::uint8_t buf[sha1::BLOCK_BYTES] = {};
+        std::size_t const times = 100000;
+        std::uint32_t d0[5] = {};
+        std::uint32_t d1[5] = {};
+        auto const t0 = timeit(
+            [&]{ sha1::process(d0, buf, 1); }, times);
+        auto const t1 = timeit(
+            [&]{ process_scalar(d1, buf, 1); }, times);
+        BEAST_EXPECT(std::memcmp(d0, d1, sizeof(d0)) == 0);
+        log <<
+            times << " blocks: " <<
+            "process " << static_cast<std::size_t>(t0 * 1e6) << "us, " <<
+            "scalar " << static_cast<std::size_t>(t1 * 1e6) << "us" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(sha1_bench,core,beast);
+
+} // detail
+} // beast
@@ -9,6 +9,8 @@
 #include <beast/core/static_string.hpp>
 
 #include <beast/unit_test/suite.hpp>
+#include <limits>
+#include <string>
 
 namespace beast {
 
@@ -251,10 +253,118 @@ public:
         }
     }
 
+    void testModifiers()
+    {
+        using str4 = static_string<4>;
+        {
+            str4 s;
+            s.assign("ab");
+            BEAST_EXPECT(s == "ab");
+            s.assign("wxyz", 3);
+            BEAST_EXPECT(s == "wxy");
+            s.assign(boost::string_ref{"pq"});
+            BEAST_EXPECT(s == "pq");
+            s.assign(s.data() + 1, 1);
+            BEAST_EXPECT(s == "q");
+            try
+            {
+                s.assign("abcde");
+                fail();
+            }
+            catch(std::length_error const&)
+            {
+                pass();
+            }
+            BEAST_EXPECT(s == "q");
+        }
+        {
+            str4 s;
+            s.append("ab", 2);
+            s.push_back('c');
+            BEAST_EXPECT(s == "abc");
+            BEAST_EXPECT(s.c_str()[3] == 0);
+            s.clear();
+            s += 'x';
+            s += boost::string_ref{"yz"};
+            BEAST_EXPECT(s == "xyz");
+            s.append(1, '!');
+            BEAST_EXPECT(s == "xyz!");
+            try
+            {
+                s.push_back('?');
+                fail();
+            }
+            catch(std::length_error const&)
+            {
+                pass();
+            }
+            BEAST_EXPECT(s == "xyz!");
+            s.clear();
+            s.append(3, '-');
+            BEAST_EXPECT(s == "---");
+        }
+    }
+
+    void testStringRef()
+    {
+        using str4 = static_string<4>;
+        str4 const s{boost::string_ref{"abc"}};
+        BEAST_EXPECT(s == "abc");
+        boost::string_ref const r = s;
+        BEAST_EXPECT(r.data() == s.data());
+        BEAST_EXPECT(r.size() == 3);
+        BEAST_EXPECT(s == boost::string_ref{"abc"});
+        BEAST_EXPECT(boost::string_ref{"abc"} == s);
+        BEAST_EXPECT(s != boost::string_ref{"ab"});
+        BEAST_EXPECT(boost::string_ref{"abcd"} != s);
+        BEAST_EXPECT(s.compare(boost::string_ref{"abd"}) < 0);
+        BEAST_EXPECT(s.compare(boost::string_ref{"ab"}) > 0);
+        try
+        {
+            str4 s2{boost::string_ref{"abcde"}};
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        static_string<8> s3{s};
+        s3 += s;
+        BEAST_EXPECT(s3 == "abcabc");
+    }
+
+    template<class Integer>
+    void checkInteger(Integer v)
+    {
+        auto const s = to_static_string(v);
+        BEAST_EXPECT(s.to_string() == std::to_string(v));
+    }
+
+    void testToStaticString()
+    {
+        checkInteger(0);
+        checkInteger(-1);
+        checkInteger(7u);
+        checkInteger(12345);
+        checkInteger(std::numeric_limits<short>::min());
+        checkInteger(std::numeric_limits<int>::min());
+        checkInteger(std::numeric_limits<int>::max());
+        checkInteger(std::numeric_limits<long long>::min());
+        checkInteger(std::numeric_limits<long long>::max());
+        checkInteger(std::numeric_limits<unsigned long long>::max());
+        BEAST_EXPECT(to_static_string(std::uint64_t{0}).max_size() == 21);
+        static_string<32> s("Content-Length: ");
+        s += to_static_string(4096);
+        BEAST_EXPECT(s == "Content-Length: 4096");
+    }
+
     void run() override
     {
         testMembers();
         testCompare();
+        testModifiers();
+        testStringRef();
+        testToStaticString();
     }
 };
 
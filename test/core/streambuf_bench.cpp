@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/core/buffers_snapshot.hpp>
+#include <beast/core/circular_streambuf.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace beast {
+
+// Compare the dynamic buffers when used the way a parser
+// uses them: read into the output sequence, search the
+// input for a delimiter, then consume what was parsed.
+//
+class streambuf_bench_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::high_resolution_clock;
+
+    static std::size_t constexpr Total = 64 * 1024 * 1024;
+    static std::size_t constexpr Trials = 3;
+
+    // A stream of HTTP-like messages
+    static
+    std::string
+    makeInput()
+    {
+        std::string s;
+        for(int i = 0; s.size() < 1024 * 1024; ++i)
+            s += "GET /" + std::to_string(i) + " HTTP/1.1\r\n"
+                "Host: localhost\r\n"
+                "User-Agent: bench\r\n"
+                "Content-Length: 0\r\n\r\n";
+        return s;
+    }
+
+    // Returns the number of bytes up to and including
+    // the next blank line, or zero if there is none.
+    template<class ConstBufferSequence>
+    static
+    std::size_t
+    find(ConstBufferSequence const& bs)
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        std::size_t n = 0;
+        int state = 0;
+        for(auto it = bs.begin(); it != bs.end(); ++it)
+        {
+            boost::asio::const_buffer const b = *it;
+            auto p = buffer_cast<char const*>(b);
+            auto const end = p + buffer_size(b);
+            for(; p != end; ++p, ++n)
+            {
+                switch(*p)
+                {
+                case '\r': state = (state == 2) ? 3 : 1; break;
+                case '\n':
+                    if(state == 3)
+                        return n + 1;
+                    state = (state == 1) ? 2 : 0;
+                    break;
+                default: state = 0; break;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Returns the best time in seconds
+    template<class Function>
+    static
+    double
+    timed(Function&& f)
+    {
+        using namespace std::chrono;
+        double best = 0;
+        for(std::size_t i = 0; i < Trials; ++i)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = duration_cast<
+                duration<double>>(clock_type::now() - t0).count();
+            if(i == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    // Feed `Total` bytes in reads of `chunk`
+    // bytes, returning the number of messages.
+    template<class DynamicBuffer>
+    static
+    std::size_t
+    parse(DynamicBuffer& b,
+        std::string const& in, std::size_t chunk)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::size_t count = 0;
+        std::size_t pos = 0;
+        for(std::size_t total = 0; total < Total;)
+        {
+            auto const n = (std::min)(chunk, in.size() - pos);
+            b.commit(buffer_copy(b.prepare(n),
+                buffer(in.data() + pos, n)));
+            pos += n;
+            if(pos == in.size())
+                pos = 0;
+            total += n;
+            for(;;)
+            {
+                auto const used = find(b.data());
+                if(used == 0)
+                    break;
+                b.consume(used);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    static
+    double
+    mbps(double seconds)
+    {
+        return seconds > 0 ? Total / seconds / 1e6 : 0;
+    }
+
+    void
+    testBench()
+    {
+        auto const in = makeInput();
+        char buf[80];
+        std::snprintf(buf, sizeof(buf), "%8s %10s %10s %10s",
+            "chunk", "streambuf", "flat", "circular");
+        log <<
+            Total / (1024 * 1024) << "MB per trial, best of " <<
+            Trials << " trials, speeds in MB/s\n" <<
+            buf << std::endl;
+        for(std::size_t chunk : {std::size_t{64},
+            std::size_t{1536}, std::size_t{16384}})
+        {
+            std::size_t n[3];
+            double v[3];
+            v[0] = mbps(timed([&]{
+                streambuf b;
+                n[0] = parse(b, in, chunk); }));
+            v[1] = mbps(timed([&]{
+                flat_streambuf b;
+                n[1] = parse(b, in, chunk); }));
+            v[2] = mbps(timed([&]{
+                circular_streambuf b{65536};
+                n[2] = parse(b, in, chunk); }));
+            BEAST_EXPECT(n[0] == n[1]);
+            BEAST_EXPECT(n[0] == n[2]);
+            std::snprintf(buf, sizeof(buf), "%8u %10.1f %10.1f %10.1f",
+                static_cast<unsigned>(chunk), v[0], v[1], v[2]);
+            log << buf << std::endl;
+        }
+    }
+
+    // Returns the best time in nanoseconds per iteration
+    template<class Function>
+    static
+    double
+    timed_ns(std::size_t iterations, Function&& f)
+    {
+        return timed([&]
+            {
+                for(std::size_t i = 0; i < iterations; ++i)
+                    f();
+            }) * 1e9 / iterations;
+    }
+
+    // Operations on a streambuf holding many blocks
+    void
+    testBlocks()
+    {
+        using boost::asio::buffer_size;
+        char buf[80];
+        std::snprintf(buf, sizeof(buf), "%8s %10s %10s %10s %10s",
+            "blocks", "capacity", "iterate", "snapshot", "iterate");
+        log << "\nnanoseconds per operation\n" << buf << std::endl;
+        for(std::size_t blocks : {std::size_t{1}, std::size_t{10},
+            std::size_t{100}, std::size_t{1000}})
+        {
+            streambuf sb{1024};
+            for(std::size_t i = 0; i < blocks; ++i)
+                sb.commit(buffer_size(sb.prepare(1024)));
+            sb.consume(1);
+            auto const iterations = 1000000 / blocks;
+            std::size_t n = 0;
+            double v[4];
+            v[0] = timed_ns(iterations, [&]{
+                n += read_size_helper(sb, 65536); });
+            v[1] = timed_ns(iterations, [&]{
+                n += buffer_size(sb.data()); });
+            v[2] = timed_ns(iterations, [&]{
+                buffers_snapshot<> bs{sb.data()};
+                n += bs.size(); });
+            buffers_snapshot<> const bs{sb.data()};
+            v[3] = timed_ns(iterations, [&]{
+                n += buffer_size(bs); });
+            BEAST_EXPECT(n > 0);
+            BEAST_EXPECT(bs.size() == sb.size());
+            std::snprintf(buf, sizeof(buf),
+                "%8u %10.1f %10.1f %10.1f %10.1f",
+                static_cast<unsigned>(blocks),
+                    v[0], v[1], v[2], v[3]);
+            log << buf << std::endl;
+        }
+    }
+
+    void
+    run() override
+    {
+        testBench();
+        testBlocks();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(streambuf_bench,core,beast);
+
+} // beast
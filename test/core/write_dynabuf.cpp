@@ -8,16 +8,87 @@
 // Test that header file is self-contained.
 #include <beast/core/write_dynabuf.hpp>
 
+#include <beast/core/static_string.hpp>
 #include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/unit_test/suite.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
 
 namespace beast {
 
 class write_dynabuf_test : public beast::unit_test::suite
 {
 public:
+    template<class T>
+    std::string
+    str(T const& t)
+    {
+        streambuf sb;
+        write(sb, t);
+        return to_string(sb.data());
+    }
+
+    template<class T>
+    void
+    checkLimits()
+    {
+        using limits = std::numeric_limits<T>;
+        BEAST_EXPECT(str(limits::min()) ==
+            std::to_string(limits::min()));
+        BEAST_EXPECT(str(limits::max()) ==
+            std::to_string(limits::max()));
+    }
+
+    void
+    testIntegers()
+    {
+        BEAST_EXPECT(str(0) == "0");
+        BEAST_EXPECT(str(7) == "7");
+        BEAST_EXPECT(str(-7) == "-7");
+        BEAST_EXPECT(str(10) == "10");
+        BEAST_EXPECT(str(200) == "200");
+        BEAST_EXPECT(str(-1000) == "-1000");
+        BEAST_EXPECT(str(123456789u) == "123456789");
+        for(std::int64_t i = 1; i < 1000000000000; i = i * 3 + 1)
+        {
+            BEAST_EXPECT(str(i) == std::to_string(i));
+            BEAST_EXPECT(str(-i) == std::to_string(-i));
+        }
+        checkLimits<short>();
+        checkLimits<unsigned short>();
+        checkLimits<int>();
+        checkLimits<unsigned>();
+        checkLimits<long>();
+        checkLimits<unsigned long>();
+        checkLimits<long long>();
+        checkLimits<unsigned long long>();
+
+        // characters are not numbers
+        BEAST_EXPECT(str('x') == "x");
+
+        streambuf sb;
+        write(sb, "Content-Length: ", 1024, "\r\n");
+        BEAST_EXPECT(to_string(sb.data()) == "Content-Length: 1024\r\n");
+    }
+
+    void
+    testStrings()
+    {
+        BEAST_EXPECT(str(boost::string_ref{"abc"}) == "abc");
+        BEAST_EXPECT(str(boost::string_ref{}) == "");
+        char const* p = "xyz";
+        BEAST_EXPECT(str(p) == "xyz");
+        BEAST_EXPECT(str(static_string<8>{"date"}) == "date");
+        BEAST_EXPECT(str(std::string{"abc"}) == "abc");
+    }
+
     void run() override
     {
+        testIntegers();
+        testStrings();
+
         streambuf sb;
         std::string s;
         write(sb, boost::asio::const_buffer{"", 0});
@@ -0,0 +1,375 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/client_pool.hpp>
+
+#include <beast/http/empty_body.hpp>
+#include <beast/http/read.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+class client_pool_test : public beast::unit_test::suite
+{
+public:
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    enum class mode
+    {
+        keep_alive,     // keep connections open
+        close,          // send Connection: close
+        drop            // close silently after each response
+    };
+
+    // A blocking server on the loopback interface
+    class server
+    {
+        mode mode_;
+        std::atomic<bool> stop_{false};
+        boost::asio::io_service ios_;
+        boost::asio::ip::tcp::acceptor acceptor_;
+        std::thread thread_;
+
+    public:
+        std::atomic<std::size_t> accepts{0};
+        std::atomic<std::size_t> requests{0};
+
+        explicit
+        server(mode m)
+            : mode_(m)
+            , acceptor_(ios_, endpoint_type{
+                boost::asio::ip::address_v4::loopback(), 0})
+        {
+            thread_ = std::thread{[&]{ run(); }};
+        }
+
+        ~server()
+        {
+            // Wake up the blocking accept
+            stop_ = true;
+            socket_type sock{ios_};
+            error_code ec;
+            sock.connect(local_endpoint(), ec);
+            thread_.join();
+        }
+
+        endpoint_type
+        local_endpoint() const
+        {
+            return acceptor_.local_endpoint();
+        }
+
+    private:
+        void
+        run()
+        {
+            std::vector<std::thread> peers;
+            for(;;)
+            {
+                socket_type sock{ios_};
+                error_code ec;
+                acceptor_.accept(sock, ec);
+                if(ec || stop_)
+                    break;
+                ++accepts;
+                peers.emplace_back(
+                    [this](socket_type s)
+                    {
+                        do_peer(s);
+                    }, std::move(sock));
+            }
+            for(auto& t : peers)
+                t.join();
+        }
+
+        void
+        do_peer(socket_type& sock)
+        {
+            streambuf sb;
+            error_code ec;
+            for(;;)
+            {
+                request<string_body> req;
+                read(sock, sb, req, ec);
+                if(ec)
+                    break;
+                ++requests;
+                response<string_body> res;
+                res.status = 200;
+                res.reason = "OK";
+                res.version = 11;
+                res.body = req.url;
+                if(mode_ == mode::close)
+                    prepare(res, connection::close);
+                else
+                    prepare(res);
+                write(sock, res, ec);
+                if(ec || mode_ != mode::keep_alive)
+                    break;
+            }
+        }
+    };
+
+    static
+    request<empty_body>
+    make_request(std::string const& target,
+        std::string const& method = "GET")
+    {
+        request<empty_body> req;
+        req.method = method;
+        req.url = target;
+        req.version = 11;
+        req.fields.insert("Host", "localhost");
+        prepare(req);
+        return req;
+    }
+
+    // Send `n` requests at once and check every response
+    void
+    run_requests(client_pool& pool,
+        endpoint_type const& ep, std::size_t n)
+    {
+        std::vector<request<empty_body>> req;
+        std::vector<response<string_body>> res(n);
+        for(std::size_t i = 0; i < n; ++i)
+            req.emplace_back(make_request(
+                "/" + std::to_string(i)));
+        std::size_t done = 0;
+        for(std::size_t i = 0; i < n; ++i)
+            pool.async_request(ep, req[i], res[i],
+                [&](error_code ec)
+                {
+                    BEAST_EXPECTS(! ec, ec.message());
+                    ++done;
+                });
+        pool.get_io_service().run();
+        pool.get_io_service().reset();
+        BEAST_EXPECT(done == n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            BEAST_EXPECT(res[i].status == 200);
+            BEAST_EXPECT(res[i].body == req[i].url);
+        }
+    }
+
+    void
+    testReuse()
+    {
+        server srv{mode::keep_alive};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 4};
+        run_requests(pool, ep, 20);
+        BEAST_EXPECT(pool.connects() == 4);
+        BEAST_EXPECT(pool.reuses() == 16);
+        BEAST_EXPECT(pool.idle(ep) == 4);
+        run_requests(pool, ep, 8);
+        BEAST_EXPECT(pool.connects() == 4);
+        BEAST_EXPECT(srv.requests == 28);
+        pool.close();
+        BEAST_EXPECT(pool.idle(ep) == 0);
+    }
+
+    void
+    testClose()
+    {
+        server srv{mode::close};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 2};
+        run_requests(pool, ep, 10);
+        BEAST_EXPECT(pool.connects() == 10);
+        BEAST_EXPECT(pool.reuses() == 0);
+        BEAST_EXPECT(pool.idle(ep) == 0);
+    }
+
+    void
+    testCloseRequest()
+    {
+        server srv{mode::keep_alive};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 1};
+        auto req = make_request("/close");
+        prepare(req, connection::close);
+        for(int i = 0; i < 3; ++i)
+        {
+            response<string_body> res;
+            error_code result = boost::asio::error::fault;
+            pool.async_request(ep, req, res,
+                [&](error_code ec)
+                {
+                    result = ec;
+                });
+            ios.run();
+            ios.reset();
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(res.body == "/close");
+        }
+        BEAST_EXPECT(pool.connects() == 3);
+        BEAST_EXPECT(pool.idle(ep) == 0);
+    }
+
+    void
+    testRetry()
+    {
+        server srv{mode::drop};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 1};
+        run_requests(pool, ep, 1);
+        BEAST_EXPECT(pool.idle(ep) == 1);
+        // The idle connection was closed by the
+        // server, the request is sent again.
+        run_requests(pool, ep, 1);
+        BEAST_EXPECT(pool.connects() == 2);
+        BEAST_EXPECT(srv.accepts == 2);
+        BEAST_EXPECT(srv.requests == 2);
+    }
+
+    void
+    testNoRetry()
+    {
+        server srv{mode::drop};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 1};
+        auto const req = make_request("/post", "POST");
+        for(int i = 0; i < 2; ++i)
+        {
+            response<string_body> res;
+            error_code result = boost::asio::error::fault;
+            pool.async_request(ep, req, res,
+                [&](error_code ec)
+                {
+                    result = ec;
+                });
+            ios.run();
+            ios.reset();
+            // The second request fails on the connection
+            // closed by the server, and is not sent again.
+            if(i == 0)
+                BEAST_EXPECTS(! result, result.message());
+            else
+                BEAST_EXPECT(result);
+        }
+        BEAST_EXPECT(pool.connects() == 1);
+        BEAST_EXPECT(srv.requests == 1);
+    }
+
+    void
+    testAbort()
+    {
+        server srv{mode::keep_alive};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        auto const req = make_request("/");
+        response<string_body> res1;
+        response<string_body> res2;
+        error_code result1 = boost::asio::error::fault;
+        error_code result2 = boost::asio::error::fault;
+        {
+            client_pool pool{ios, 1};
+            pool.async_request(ep, req, res1,
+                [&](error_code ec)
+                {
+                    result1 = ec;
+                });
+            // Waits for the connection used by the first
+            pool.async_request(ep, req, res2,
+                [&](error_code ec)
+                {
+                    result2 = ec;
+                });
+            pool.close();
+            ios.run();
+        }
+        BEAST_EXPECTS(! result1, result1.message());
+        BEAST_EXPECT(res1.body == "/");
+        BEAST_EXPECTS(result2 == boost::asio::error::operation_aborted,
+            result2.message());
+    }
+
+    void
+    testHead()
+    {
+        server srv{mode::keep_alive};
+        auto const ep = srv.local_endpoint();
+        boost::asio::io_service ios;
+        client_pool pool{ios, 1};
+        auto const req = make_request("/head", "HEAD");
+        response<string_body> res;
+        error_code result = boost::asio::error::fault;
+        pool.async_request(ep, req, res,
+            [&](error_code ec)
+            {
+                result = ec;
+            });
+        ios.run();
+        BEAST_EXPECTS(! result, result.message());
+        BEAST_EXPECT(res.status == 200);
+        BEAST_EXPECT(res.body.empty());
+    }
+
+    void
+    testFail()
+    {
+        endpoint_type ep;
+        {
+            // An endpoint nobody is listening on
+            boost::asio::io_service ios;
+            boost::asio::ip::tcp::acceptor a{ios, endpoint_type{
+                boost::asio::ip::address_v4::loopback(), 0}};
+            ep = a.local_endpoint();
+        }
+        boost::asio::io_service ios;
+        client_pool pool{ios, 1};
+        auto const req = make_request("/");
+        response<string_body> res1;
+        response<string_body> res2;
+        std::size_t failed = 0;
+        auto const handler =
+            [&](error_code ec)
+            {
+                if(ec)
+                    ++failed;
+            };
+        pool.async_request(ep, req, res1, handler);
+        pool.async_request(ep, req, res2, handler);
+        ios.run();
+        BEAST_EXPECT(failed == 2);
+        BEAST_EXPECT(pool.connects() == 0);
+        BEAST_EXPECT(pool.idle(ep) == 0);
+    }
+
+    void
+    run() override
+    {
+        testReuse();
+        testClose();
+        testCloseRequest();
+        testRetry();
+        testNoRetry();
+        testAbort();
+        testHead();
+        testFail();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(client_pool,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/date.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class date_test : public unit_test::suite
+{
+public:
+    static
+    std::string
+    format(std::int64_t t)
+    {
+        char buf[29];
+        detail::format_date(buf, t);
+        return std::string(buf, sizeof(buf));
+    }
+
+    // Format using the C library
+    static
+    std::string
+    format_ref(std::int64_t t)
+    {
+        auto const tt = static_cast<std::time_t>(t);
+        char buf[64];
+        auto const n = std::strftime(buf, sizeof(buf),
+            "%a, %d %b %Y %H:%M:%S GMT", std::gmtime(&tt));
+        return std::string(buf, n);
+    }
+
+    void
+    testFormat()
+    {
+        BEAST_EXPECT(format(0) ==
+            "Thu, 01 Jan 1970 00:00:00 GMT");
+        BEAST_EXPECT(format(784111777) ==
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(format(951782400) ==
+            "Tue, 29 Feb 2000 00:00:00 GMT");
+        BEAST_EXPECT(format(4107542399) ==
+            "Sun, 28 Feb 2100 23:59:59 GMT");
+        BEAST_EXPECT(format(4107542400) ==
+            "Mon, 01 Mar 2100 00:00:00 GMT");
+        std::mt19937_64 g;
+        std::uniform_int_distribution<std::int64_t> d{
+            0, (std::int64_t{1} << 34) - 1};
+        for(int i = 0; i < 10000; ++i)
+        {
+            auto const t = d(g);
+            BEAST_EXPECT(format(t) == format_ref(t));
+        }
+    }
+
+    void
+    testDateString()
+    {
+        auto const t0 = detail::seconds_since_epoch();
+        auto const s = date_string();
+        auto const t1 = detail::seconds_since_epoch();
+        BEAST_EXPECT(s.size() == 29);
+        BEAST_EXPECT(s.to_string() == format(t0) ||
+            s.to_string() == format(t1));
+    }
+
+    void
+    testCache()
+    {
+        // The date is formatted again only when the second changes
+        detail::date_cache c{784111777};
+        date_string_type s;
+        c.get(s, 784111777);
+        BEAST_EXPECT(s == "Sun, 06 Nov 1994 08:49:37 GMT");
+        c.get(s, 784111778);
+        BEAST_EXPECT(s == "Sun, 06 Nov 1994 08:49:38 GMT");
+        c.get(s, 784111778);
+        BEAST_EXPECT(s == "Sun, 06 Nov 1994 08:49:38 GMT");
+    }
+
+    void
+    testThreads()
+    {
+        // Every thread advances the clock, so the date is
+        // replaced while the other threads are reading it.
+        detail::date_cache c{0};
+        std::size_t const n = 4;
+        std::vector<std::thread> threads;
+        std::vector<int> bad(n, 0);
+        for(std::size_t i = 0; i < n; ++i)
+            threads.emplace_back(
+                [&c, &bad, i]
+                {
+                    date_string_type s;
+                    for(std::int64_t t = 0; t < 20000; ++t)
+                    {
+                        c.get(s, t);
+                        // The date is one of the formatted
+                        // seconds, and was not torn.
+                        auto const v =
+                            ((s[17] - '0') * 10 + (s[18] - '0')) * 3600 +
+                            ((s[20] - '0') * 10 + (s[21] - '0')) * 60 +
+                             (s[23] - '0') * 10 + (s[24] - '0');
+                        if(s.to_string() != format(v))
+                            ++bad[i];
+                    }
+                });
+        for(auto& t : threads)
+            t.join();
+        for(auto v : bad)
+            BEAST_EXPECT(v == 0);
+    }
+
+    void run() override
+    {
+        testFormat();
+        testDateString();
+        testCache();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(date,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http/date.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <ctime>
+
+namespace beast {
+namespace http {
+
+// Compare the cached date_string with
+// formatting the time on every call.
+//
+class date_bench_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        std::size_t const times = 1000000;
+        std::size_t n0 = 0;
+        std::size_t n1 = 0;
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0; i < times; ++i)
+            n0 += date_string().size();
+        auto const t1 = clock_type::now();
+        for(std::size_t i = 0; i < times; ++i)
+        {
+            auto const tt = std::time(nullptr);
+            char buf[64];
+            n1 += std::strftime(buf, sizeof(buf),
+                "%a, %d %b %Y %H:%M:%S GMT", std::gmtime(&tt));
+        }
+        auto const t2 = clock_type::now();
+        BEAST_EXPECT(n0 == n1);
+        log <<
+            times << " dates: " <<
+            "date_string " << duration_cast<
+                microseconds>(t1 - t0).count() << "us, " <<
+            "strftime " << duration_cast<
+                microseconds>(t2 - t1).count() << "us" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(date_bench,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,357 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/deflate_body.hpp>
+
+#include <beast/http/fields.hpp>
+#include <beast/http/file_body.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class deflate_body_test : public beast::unit_test::suite
+{
+public:
+    // Produces the body in pieces of at most 7 bytes
+    struct piece_body
+    {
+        using value_type = std::string;
+
+        using reader = string_body::reader;
+
+        class writer
+        {
+            value_type const& body_;
+            std::size_t pos_ = 0;
+
+        public:
+            template<bool isRequest, class Body, class Fields>
+            explicit
+            writer(message<isRequest,
+                    Body, Fields> const& m) noexcept
+                : body_(m.body)
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&&, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                auto const n = (std::min)(
+                    std::size_t{7}, body_.size() - pos_);
+                wf(boost::asio::buffer(&body_[pos_], n));
+                pos_ += n;
+                return pos_ == body_.size();
+            }
+        };
+    };
+
+    static
+    std::string
+    corpus(std::size_t n)
+    {
+        std::string s;
+        std::uint32_t x = 1;
+        while(s.size() < n)
+        {
+            x = x * 1103515245 + 12345;
+            s += "{\"id\":" + std::to_string((x >> 16) % 1000) +
+                ",\"name\":\"beast\"}\n";
+        }
+        s.resize(n);
+        return s;
+    }
+
+    static
+    std::string
+    unhex(std::string const& s)
+    {
+        std::string r;
+        for(std::size_t i = 0; i + 1 < s.size(); i += 2)
+            r.push_back(static_cast<char>(
+                std::stoi(s.substr(i, 2), nullptr, 16)));
+        return r;
+    }
+
+    template<class Body>
+    std::string
+    serialize(std::string const& body)
+    {
+        message<false, Body, fields> m;
+        m.body = body;
+        typename Body::writer w(m);
+        error_code ec;
+        w.init(ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        std::string out;
+        for(;;)
+        {
+            resume_context rc;
+            boost::tribool const result = w.write(std::move(rc), ec,
+                [&](boost::asio::const_buffers_1 const& b)
+                {
+                    out.append(boost::asio::buffer_cast<
+                        char const*>(b), boost::asio::buffer_size(b));
+                });
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(! boost::indeterminate(result));
+            if(ec || result || boost::indeterminate(result))
+                break;
+        }
+        return out;
+    }
+
+    // Feed the input to the reader in pieces of at most n bytes
+    template<class Body>
+    std::string
+    parse(std::string const& coding,
+        std::string const& in, std::size_t n, error_code& ec)
+    {
+        message<true, Body, fields> m;
+        if(! coding.empty())
+            m.fields.insert("Content-Encoding", coding);
+        typename Body::reader r(m);
+        r.init(ec);
+        if(ec)
+            return {};
+        for(std::size_t i = 0; i < in.size(); i += n)
+        {
+            r.write(&in[i], (std::min)(n, in.size() - i), ec);
+            if(ec)
+                return m.body;
+        }
+        r.finish(ec);
+        return m.body;
+    }
+
+    template<class Body>
+    void
+    roundtrip(std::string const& coding, std::string const& s)
+    {
+        auto const out = serialize<Body>(s);
+        for(std::size_t n : {std::size_t{1}, std::size_t{1000},
+            out.size() + 1})
+        {
+            error_code ec;
+            BEAST_EXPECT(parse<Body>(coding, out, n, ec) == s);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+    }
+
+    void
+    testPrepare()
+    {
+        {
+            message<false, gzip_body<string_body>, fields> m;
+            m.version = 11;
+            m.status = 200;
+            m.body = "Hello";
+            prepare(m);
+            BEAST_EXPECT(m.fields["Content-Encoding"] == "gzip");
+            BEAST_EXPECT(m.fields["Transfer-Encoding"] == "chunked");
+            BEAST_EXPECT(! m.fields.exists("Content-Length"));
+        }
+        {
+            message<false, deflate_body<string_body>, fields> m;
+            m.version = 11;
+            m.status = 200;
+            prepare(m);
+            BEAST_EXPECT(m.fields["Content-Encoding"] == "deflate");
+        }
+        {
+            message<false, string_body, fields> m;
+            m.version = 11;
+            m.status = 200;
+            prepare(m);
+            BEAST_EXPECT(! m.fields.exists("Content-Encoding"));
+        }
+        {
+            message<false, gzip_body<string_body>, fields> m;
+            m.version = 11;
+            m.status = 200;
+            m.fields.insert("Content-Encoding", "gzip");
+            try
+            {
+                prepare(m);
+                fail();
+            }
+            catch(std::invalid_argument const&)
+            {
+                pass();
+            }
+        }
+    }
+
+    void
+    testWriter()
+    {
+        roundtrip<gzip_body<string_body>>("gzip", "");
+        roundtrip<deflate_body<string_body>>("deflate", "");
+        roundtrip<gzip_body<string_body>>("gzip", "Hello, world!");
+        roundtrip<deflate_body<string_body>>("deflate", "Hello, world!");
+
+        auto const s = corpus(200000);
+        roundtrip<gzip_body<string_body>>("gzip", s);
+        roundtrip<deflate_body<string_body>>("deflate", s);
+        roundtrip<gzip_body<piece_body>>("gzip", s.substr(0, 5000));
+        roundtrip<deflate_body<piece_body>>("deflate", s.substr(0, 5000));
+
+        auto const out = serialize<gzip_body<string_body>>(s);
+        BEAST_EXPECT(out.size() < s.size() / 4);
+    }
+
+    void
+    testReader()
+    {
+        std::string const check = "Hello, world!";
+
+        // gzip with a file name, made by another implementation
+        auto const gz = unhex(
+            "1f8b08080000000002ff68656c6c6f2e74787400f348cdc9c9d751"
+            "28cf2fca49510400e6c6e6eb0d000000");
+        // zlib format, made by another implementation
+        auto const zl = unhex(
+            "789cf348cdc9c9d75128cf2fca49510400205e048a");
+
+        for(std::size_t n : {std::size_t{1}, std::size_t{3},
+            std::size_t{100}})
+        {
+            error_code ec;
+            BEAST_EXPECT(parse<gzip_body<string_body>>(
+                "gzip", gz, n, ec) == check);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(parse<deflate_body<string_body>>(
+                "deflate", zl, n, ec) == check);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            // pass through
+            error_code ec;
+            BEAST_EXPECT(parse<gzip_body<string_body>>(
+                "", check, 5, ec) == check);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(parse<gzip_body<string_body>>(
+                "identity", check, 5, ec) == check);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            error_code ec;
+            parse<gzip_body<string_body>>("gzip", zl, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::invalid_header, ec.message());
+            ec = {};
+            parse<deflate_body<string_body>>("deflate", gz, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::invalid_header, ec.message());
+        }
+        {
+            error_code ec;
+            auto bad = gz;
+            bad[bad.size() - 6] ^= 1;
+            parse<gzip_body<string_body>>("gzip", bad, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::incorrect_check, ec.message());
+            ec = {};
+            bad = zl;
+            bad.back() ^= 1;
+            parse<deflate_body<string_body>>("deflate", bad, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::incorrect_check, ec.message());
+        }
+        {
+            error_code ec;
+            parse<gzip_body<string_body>>("gzip", gz + "x", 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::stream_error, ec.message());
+        }
+        {
+            // truncated in the body, and in the trailer
+            for(std::size_t n : {std::size_t{12}, std::size_t{1}})
+            {
+                error_code ec;
+                parse<gzip_body<string_body>>("gzip",
+                    gz.substr(0, gz.size() - n), 100, ec);
+                BEAST_EXPECTS(ec == zlib::error::stream_error,
+                    ec.message());
+                ec = {};
+                parse<deflate_body<string_body>>("deflate",
+                    zl.substr(0, zl.size() - n), 100, ec);
+                BEAST_EXPECTS(ec == zlib::error::stream_error,
+                    ec.message());
+            }
+            error_code ec;
+            parse<gzip_body<string_body>>("gzip", "", 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::stream_error, ec.message());
+        }
+    }
+
+    static
+    std::string
+    load(std::string const& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>{is},
+            std::istreambuf_iterator<char>{}};
+    }
+
+    // The wrapped reader is finished along with the adapter
+    void
+    testFinish()
+    {
+        auto const path = (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path()).string();
+        auto const s = corpus(100000);
+        auto const out = serialize<gzip_body<string_body>>(s);
+        auto const check =
+            [&](std::string const& in)
+            {
+                message<true, gzip_body<file_body>, fields> m;
+                m.fields.insert("Content-Encoding", "gzip");
+                m.body = path;
+                gzip_body<file_body>::reader r(m);
+                error_code ec;
+                r.init(ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                r.write(in.data(), in.size(), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                r.finish(ec);
+                // The file is flushed before the reader is destroyed
+                if(! ec)
+                    BEAST_EXPECT(load(path) == s);
+                return ec;
+            };
+        auto ec = check(out);
+        BEAST_EXPECTS(! ec, ec.message());
+        ec = check(out.substr(0, out.size() - 4));
+        BEAST_EXPECTS(ec == zlib::error::stream_error, ec.message());
+        boost::system::error_code ec2;
+        boost::filesystem::remove(path, ec2);
+    }
+
+    void
+    run() override
+    {
+        testPrepare();
+        testWriter();
+        testReader();
+        testFinish();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(deflate_body,http,beast);
+
+} // http
+} // beast
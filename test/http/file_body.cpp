@@ -0,0 +1,405 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/file_body.hpp>
+
+#include <beast/http/fields.hpp>
+#include <beast/http/header_parser_v1.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+class file_body_test : public beast::unit_test::suite
+{
+public:
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    // Removes the file on destruction
+    struct temp_file
+    {
+        std::string path;
+
+        explicit
+        temp_file(std::string const& contents)
+            : path((boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path()).string())
+        {
+            std::ofstream os(path, std::ios::binary);
+            os.write(contents.data(), contents.size());
+        }
+
+        ~temp_file()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(path, ec);
+        }
+    };
+
+    std::string
+    serialize(std::string const& path, error_code& ec)
+    {
+        message<false, file_body, fields> m;
+        m.body = path;
+        file_body::writer w(m);
+        w.init(ec);
+        if(ec)
+            return {};
+        std::string out;
+        auto const size = w.content_length();
+        for(;;)
+        {
+            resume_context rc;
+            boost::tribool const result = w.write(std::move(rc), ec,
+                [&](boost::asio::const_buffers_1 const& b)
+                {
+                    out.append(boost::asio::buffer_cast<
+                        char const*>(b), boost::asio::buffer_size(b));
+                });
+            if(ec || result)
+                break;
+            BEAST_EXPECT(! boost::indeterminate(result));
+        }
+        BEAST_EXPECT(out.size() == size);
+        return out;
+    }
+
+    void
+    testWriter()
+    {
+        for(std::size_t n : {std::size_t{0}, std::size_t{1},
+            file_body::buffer_size, std::size_t{300000}})
+        {
+            std::string s;
+            s.reserve(n);
+            for(std::size_t i = 0; i < n; ++i)
+                s.push_back(static_cast<char>(i * 7 + (i >> 9)));
+            temp_file f{s};
+            error_code ec;
+            BEAST_EXPECT(serialize(f.path, ec) == s);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            error_code ec;
+            serialize("/this/file/does/not/exist", ec);
+            BEAST_EXPECT(ec == boost::system::errc::no_such_file_or_directory);
+        }
+    }
+
+    void
+    testUnsized()
+    {
+        // The size of these files is not known in advance
+        if(boost::filesystem::exists("/proc/self/status"))
+        {
+            error_code ec;
+            serialize("/proc/self/status", ec);
+            BEAST_EXPECTS(ec == boost::system::errc::not_supported,
+                ec.message());
+        }
+#if BEAST_HTTP_FILE_BODY_MMAP
+        {
+            temp_file f{""};
+            boost::filesystem::remove(f.path);
+            BEAST_EXPECT(::mkfifo(f.path.c_str(), 0600) == 0);
+            error_code ec;
+            serialize(f.path, ec);
+            BEAST_EXPECTS(ec == boost::system::errc::not_supported,
+                ec.message());
+        }
+        {
+            error_code ec;
+            serialize(boost::filesystem::temp_directory_path().string(), ec);
+            BEAST_EXPECTS(ec == boost::system::errc::not_supported,
+                ec.message());
+        }
+#endif
+    }
+
+    void
+    testPrepare()
+    {
+        temp_file f{"Hello, world"};
+        message<false, file_body, fields> m;
+        m.version = 11;
+        m.status = 200;
+        m.body = f.path;
+        prepare(m);
+        BEAST_EXPECT(m.fields["Content-Length"] == "12");
+    }
+
+    static
+    std::string
+    load(std::string const& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>{is},
+            std::istreambuf_iterator<char>{}};
+    }
+
+    void
+    testReader()
+    {
+        using boost::asio::buffer;
+        std::string body;
+        for(std::size_t i = 0; i < 200000; ++i)
+            body.push_back(static_cast<char>(i * 13 + (i >> 11)));
+        temp_file f{""};
+        {
+            parser_v1<true, file_body, fields> p;
+            p.set_option(body_max_size{0});
+            p.get().body = f.path;
+            std::string const h =
+                "PUT / HTTP/1.1\r\n"
+                "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                "\r\n";
+            error_code ec;
+            p.write(buffer(h), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            for(std::size_t i = 0; i < body.size(); i += 7000)
+            {
+                p.write(buffer(body.data() + i,
+                    (std::min)(body.size() - i, std::size_t{7000})), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+            }
+            BEAST_EXPECT(p.complete());
+            // contents are flushed when the parse completes
+            BEAST_EXPECT(load(f.path) == body);
+        }
+        {
+            // chunked, with the body type chosen after the header
+            header_parser_v1<true, fields> p0;
+            std::string const h =
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            error_code ec;
+            p0.write(buffer(h), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            auto p = with_body<file_body>(p0);
+            p.get().body = f.path;
+            p.write(buffer(std::string{
+                "5\r\n*****\r\n3\r\n---\r\n0\r\n\r\n"}), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(load(f.path) == "*****---");
+        }
+        {
+            parser_v1<true, file_body, fields> p;
+            p.get().body = "/this/directory/does/not/exist/file";
+            std::string const s =
+                "PUT / HTTP/1.1\r\n"
+                "Content-Length: 1\r\n"
+                "\r\n"
+                "*";
+            error_code ec;
+            p.write(buffer(s), ec);
+            BEAST_EXPECT(ec);
+        }
+        {
+            // finish after a failed init does nothing
+            message<true, file_body, fields> m;
+            m.body = "/this/directory/does/not/exist/file";
+            file_body::reader r(m);
+            error_code ec;
+            r.init(ec);
+            BEAST_EXPECT(ec);
+            ec = {};
+            r.finish(ec);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        {
+            // finish may be called twice
+            message<true, file_body, fields> m;
+            m.body = f.path;
+            file_body::reader r(m);
+            error_code ec;
+            r.init(ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            r.write("*", 1, ec);
+            r.finish(ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            r.finish(ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(load(f.path) == "*");
+        }
+    }
+
+    // A connected pair of sockets, with a thread
+    // which reads everything sent to the second.
+    struct loopback
+    {
+        boost::asio::io_service ios;
+        socket_type s0{ios};
+        socket_type s1{ios};
+        std::string received;
+        std::thread t;
+
+        loopback()
+        {
+            using boost::asio::ip::tcp;
+            tcp::acceptor a{ios, tcp::endpoint{
+                boost::asio::ip::address_v4::loopback(), 0}};
+            s1.connect(a.local_endpoint());
+            a.accept(s0);
+            t = std::thread{
+                [&]
+                {
+                    char buf[65536];
+                    error_code ec;
+                    for(;;)
+                    {
+                        auto const n = s1.read_some(
+                            boost::asio::buffer(buf), ec);
+                        if(ec)
+                            break;
+                        received.append(buf, n);
+                    }
+                }};
+        }
+
+        // Returns everything received
+        std::string
+        finish()
+        {
+            error_code ec;
+            s0.shutdown(socket_type::shutdown_send, ec);
+            t.join();
+            return received;
+        }
+    };
+
+    static
+    message<false, file_body, fields>
+    make_response(std::string const& path)
+    {
+        message<false, file_body, fields> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.body = path;
+        return m;
+    }
+
+    // The message as serialized by the writer
+    static
+    std::string
+    to_string(message<false, file_body, fields> const& m)
+    {
+        std::stringstream ss;
+        ss << m;
+        return ss.str();
+    }
+
+    void
+    testSendfile()
+    {
+        std::string s;
+        for(std::size_t i = 0; i < 4000000; ++i)
+            s.push_back(static_cast<char>(i * 7 + (i >> 9)));
+        temp_file f{s};
+        auto m = make_response(f.path);
+        prepare(m);
+        auto const expected = to_string(m);
+        BEAST_EXPECT(expected.size() > s.size());
+        {
+            loopback lb;
+            error_code ec;
+            write(lb.s0, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(lb.finish() == expected);
+        }
+        {
+            // non-blocking socket
+            loopback lb;
+            lb.s0.native_non_blocking(true);
+            error_code ec;
+            write(lb.s0, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(lb.finish() == expected);
+        }
+        {
+            loopback lb;
+            error_code ec = boost::asio::error::fault;
+            async_write(lb.s0, m,
+                [&](error_code const& ev)
+                {
+                    ec = ev;
+                });
+            lb.ios.run();
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(lb.finish() == expected);
+        }
+        {
+            // chunked responses use the writer
+            auto m2 = make_response(f.path);
+            m2.fields.insert("Transfer-Encoding", "chunked");
+            loopback lb;
+            error_code ec;
+            write(lb.s0, m2, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(lb.finish() == to_string(m2));
+        }
+        {
+            auto m2 = make_response(f.path);
+            prepare(m2, connection::close);
+            loopback lb;
+            error_code ec;
+            write(lb.s0, m2, ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(lb.finish() == to_string(m2));
+        }
+        {
+            // nothing is sent for a file which cannot be sent
+            auto m2 = make_response(
+                boost::filesystem::temp_directory_path().string());
+            loopback lb;
+            error_code ec;
+            write(lb.s0, m2, ec);
+            BEAST_EXPECTS(ec == boost::system::errc::not_supported,
+                ec.message());
+            bool invoked = false;
+            async_write(lb.s0, m2,
+                [&](error_code const& ev)
+                {
+                    invoked = true;
+                    ec = ev;
+                });
+            BEAST_EXPECT(! invoked);
+            lb.ios.run();
+            BEAST_EXPECTS(ec == boost::system::errc::not_supported,
+                ec.message());
+            BEAST_EXPECT(lb.finish().empty());
+        }
+    }
+
+    void
+    run() override
+    {
+        testWriter();
+        testUnsized();
+        testPrepare();
+        testReader();
+    #if BEAST_HTTP_FILE_BODY_SENDFILE
+        testSendfile();
+    #endif
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(file_body,http,beast);
+
+} // http
+} // beast
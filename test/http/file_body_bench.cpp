@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http/file_body.hpp>
+#include <beast/http/fields.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+class file_body_bench_test : public beast::unit_test::suite
+{
+public:
+    using socket_type = boost::asio::ip::tcp::socket;
+
+    // The body used by the example servers before file_body,
+    // which reads the file through a 4KB buffer.
+    struct example_file_body
+    {
+        using value_type = std::string;
+
+        class writer
+        {
+            std::uint64_t size_ = 0;
+            std::uint64_t offset_ = 0;
+            std::string const& path_;
+            std::FILE* file_ = nullptr;
+            char buf_[4096];
+
+        public:
+            writer(writer const&) = delete;
+            writer& operator=(writer const&) = delete;
+
+            template<bool isRequest, class Fields>
+            explicit
+            writer(message<isRequest,
+                    example_file_body, Fields> const& m) noexcept
+                : path_(m.body)
+            {
+            }
+
+            ~writer()
+            {
+                if(file_)
+                    std::fclose(file_);
+            }
+
+            void
+            init(error_code& ec) noexcept
+            {
+                file_ = std::fopen(path_.c_str(), "rb");
+                if(! file_)
+                    ec = boost::system::errc::make_error_code(
+                        static_cast<boost::system::errc::errc_t>(errno));
+                else
+                    size_ = boost::filesystem::file_size(path_);
+            }
+
+            std::uint64_t
+            content_length() const noexcept
+            {
+                return size_;
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&&, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                auto const n = static_cast<std::size_t>((std::min)(
+                    static_cast<std::uint64_t>(sizeof(buf_)),
+                        size_ - offset_));
+                auto const nread = std::fread(buf_, 1, n, file_);
+                (void)nread;
+                offset_ += n;
+                wf(boost::asio::buffer(buf_, n));
+                return offset_ >= size_;
+            }
+        };
+    };
+
+    // A stream which is not a socket, so that file_body
+    // responses are sent through the writer instead of sendfile.
+    struct wrapped_stream
+    {
+        socket_type& s;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            return s.write_some(buffers);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers, error_code& ec)
+        {
+            return s.write_some(buffers, ec);
+        }
+    };
+
+    // Send the response repeatedly to a thread which discards it,
+    // and return the number of bytes received.
+    template<class Body>
+    std::size_t
+    send(std::string const& path, std::size_t repeat,
+        bool wrapped = false)
+    {
+        using boost::asio::ip::tcp;
+        boost::asio::io_service ios;
+        tcp::acceptor a{ios, tcp::endpoint{
+            boost::asio::ip::address_v4::loopback(), 0}};
+        socket_type s0{ios};
+        socket_type s1{ios};
+        s1.connect(a.local_endpoint());
+        a.accept(s0);
+        std::size_t total = 0;
+        std::thread t{
+            [&]
+            {
+                std::unique_ptr<char[]> buf(new char[65536]);
+                error_code ec;
+                for(;;)
+                {
+                    auto const n = s1.read_some(
+                        boost::asio::buffer(buf.get(), 65536), ec);
+                    if(ec)
+                        break;
+                    total += n;
+                }
+            }};
+        for(std::size_t i = 0; i < repeat; ++i)
+        {
+            message<false, Body, fields> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.body = path;
+            prepare(m);
+            error_code ec;
+            if(wrapped)
+            {
+                wrapped_stream ws{s0};
+                write(ws, m, ec);
+            }
+            else
+            {
+                write(s0, m, ec);
+            }
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+        }
+        s0.shutdown(socket_type::shutdown_send);
+        t.join();
+        return total;
+    }
+
+    void
+    run() override
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        std::size_t const size = 32 * 1024 * 1024;
+        std::size_t const repeat = 8;
+        auto const path = (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path()).string();
+        {
+            std::string s(size, 0);
+            for(std::size_t i = 0; i < size; ++i)
+                s[i] = static_cast<char>(i * 7 + (i >> 9));
+            std::ofstream os(path, std::ios::binary);
+            os.write(s.data(), s.size());
+        }
+        auto const t0 = clock_type::now();
+        auto const n0 = send<file_body>(path, repeat);
+        auto const t1 = clock_type::now();
+        auto const n1 = send<file_body>(path, repeat, true);
+        auto const t2 = clock_type::now();
+        auto const n2 = send<example_file_body>(path, repeat);
+        auto const t3 = clock_type::now();
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+        BEAST_EXPECT(n0 == n1);
+        BEAST_EXPECT(n0 == n2);
+        BEAST_EXPECT(n0 > repeat * size);
+        log <<
+            repeat << " x " << size << " byte responses: " <<
+            "file_body sendfile " << duration_cast<
+                milliseconds>(t1 - t0).count() << "ms, " <<
+            "file_body mmap " << duration_cast<
+                milliseconds>(t2 - t1).count() << "ms, " <<
+            "example body " << duration_cast<
+                milliseconds>(t3 - t2).count() << "ms" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(file_body_bench,http,beast);
+
+} // http
+} // beast
@@ -7,3 +7,244 @@
 
 // Test that header file is self-contained.
 #include <beast/http/parse.hpp>
+
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/http/fields.hpp>
+#include <beast/http/header_parser_v1.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/streambuf_body.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/test/yield_to.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/spawn.hpp>
+#include <algorithm>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class parse_test
+    : public beast::unit_test::suite
+    , public test::enable_yield_to
+{
+public:
+    static
+    std::string
+    make_body(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>(i * 5 + (i >> 12)));
+        return s;
+    }
+
+    static
+    std::string
+    make_request(std::string const& body)
+    {
+        return
+            "PUT / HTTP/1.1\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "\r\n" + body;
+    }
+
+    void
+    testParseSome()
+    {
+        auto const body = make_body(300000);
+        test::string_stream ss{ios_, make_request(body)};
+        streambuf sb;
+        header_parser_v1<true, fields> hp;
+        int calls = 0;
+        while(! hp.complete())
+        {
+            parse_some(ss, sb, hp);
+            ++calls;
+        }
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(hp.get().method == "PUT");
+        auto p = with_body<streambuf_body>(hp);
+        p.set_option(body_max_size{0});
+        std::string got;
+        std::size_t most = 0;
+        do
+        {
+            parse_some(ss, sb, p);
+            auto& b = p.get().body;
+            most = (std::max)(most, b.size());
+            got += to_string(b.data());
+            b.consume(b.size());
+        }
+        while(! p.complete());
+        BEAST_EXPECT(got == body);
+        // The body never held more than one read
+        BEAST_EXPECT(most <= 65536);
+    }
+
+    void
+    testParseSomeEof()
+    {
+        // eof with no data
+        {
+            test::string_stream ss{ios_, ""};
+            streambuf sb;
+            parser_v1<true, streambuf_body, fields> p;
+            error_code ec;
+            parse_some(ss, sb, p, ec);
+            BEAST_EXPECTS(ec == boost::asio::error::eof, ec.message());
+        }
+        // eof in the middle of a message
+        {
+            test::string_stream ss{ios_,
+                "GET / HTTP/1.1\r\n"};
+            streambuf sb;
+            parser_v1<true, streambuf_body, fields> p;
+            error_code ec;
+            parse_some(ss, sb, p, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            parse_some(ss, sb, p, ec);
+            BEAST_EXPECTS(ec == boost::asio::error::eof, ec.message());
+        }
+        // eof completes the body
+        {
+            test::string_stream ss{ios_,
+                "HTTP/1.0 200 OK\r\n"
+                "\r\n"
+                "*****"};
+            streambuf sb;
+            parser_v1<false, streambuf_body, fields> p;
+            error_code ec;
+            while(! ec && ! p.complete())
+                parse_some(ss, sb, p, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(to_string(p.get().body.data()) == "*****");
+        }
+    }
+
+    void
+    testAsyncParseSome(yield_context do_yield)
+    {
+        auto const body = make_body(200000);
+        test::string_stream ss{ios_, make_request(body)};
+        streambuf sb;
+        header_parser_v1<true, fields> hp;
+        error_code ec;
+        while(! hp.complete())
+        {
+            async_parse_some(ss, sb, hp, do_yield[ec]);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+        }
+        auto p = with_body<streambuf_body>(hp);
+        std::string got;
+        std::size_t most = 0;
+        do
+        {
+            async_parse_some(ss, sb, p, do_yield[ec]);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            auto& b = p.get().body;
+            most = (std::max)(most, b.size());
+            got += to_string(b.data());
+            b.consume(b.size());
+        }
+        while(! p.complete());
+        BEAST_EXPECT(got == body);
+        BEAST_EXPECT(most <= 65536);
+
+        test::string_stream ss2{ios_, ""};
+        parser_v1<true, streambuf_body, fields> p2;
+        async_parse_some(ss2, sb, p2, do_yield[ec]);
+        BEAST_EXPECTS(ec == boost::asio::error::eof, ec.message());
+    }
+
+    void
+    testPolicy(yield_context do_yield)
+    {
+        auto const body = make_body(300000);
+        {
+            test::string_stream ss{ios_, make_request(body)};
+            streambuf sb;
+            read_size_policy rs{512, 16384};
+            parser_v1<true, streambuf_body, fields> p;
+            p.set_option(body_max_size{0});
+            error_code ec;
+            parse(ss, sb, p, rs, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(to_string(p.get().body.data()) == body);
+            BEAST_EXPECT(rs.size() == 16384);
+            BEAST_EXPECT(rs.bytes() == make_request(body).size());
+            BEAST_EXPECT(rs.reads() > 1);
+        }
+        {
+            test::string_stream ss{ios_, make_request(body)};
+            streambuf sb;
+            read_size_policy rs{512, 16384};
+            parser_v1<true, streambuf_body, fields> p;
+            p.set_option(body_max_size{0});
+            error_code ec;
+            async_parse(ss, sb, p, rs, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(to_string(p.get().body.data()) == body);
+            BEAST_EXPECT(rs.size() == 16384);
+            BEAST_EXPECT(rs.bytes() == make_request(body).size());
+        }
+        {
+            test::string_stream ss{ios_, make_request(body)};
+            streambuf sb;
+            read_size_policy rs{1024, 4096};
+            parser_v1<true, streambuf_body, fields> p;
+            p.set_option(body_max_size{0});
+            std::size_t most = 0;
+            error_code ec;
+            while(! ec && ! p.complete())
+            {
+                async_parse_some(ss, sb, p, rs, do_yield[ec]);
+                auto& b = p.get().body;
+                most = (std::max)(most, b.size());
+                b.consume(b.size());
+            }
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(most <= 4096);
+            BEAST_EXPECT(rs.size() == 4096);
+        }
+        {
+            test::string_stream ss{ios_, make_request(body)};
+            streambuf sb;
+            read_size_policy rs{1024, 4096};
+            parser_v1<true, streambuf_body, fields> p;
+            p.set_option(body_max_size{0});
+            std::size_t most = 0;
+            error_code ec;
+            while(! ec && ! p.complete())
+            {
+                parse_some(ss, sb, p, rs, ec);
+                auto& b = p.get().body;
+                most = (std::max)(most, b.size());
+                b.consume(b.size());
+            }
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(most <= 4096);
+            BEAST_EXPECT(rs.bytes() == make_request(body).size());
+        }
+    }
+
+    void
+    run() override
+    {
+        testParseSome();
+        testParseSomeEof();
+        yield_to(std::bind(&parse_test::testAsyncParseSome,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&parse_test::testPolicy,
+            this, std::placeholders::_1));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(parse,http,beast);
+
+} // http
+} // beast
@@ -9,6 +9,7 @@
 #include <beast/http/reason.hpp>
 
 #include <beast/unit_test/suite.hpp>
+#include <string>
 
 namespace beast {
 namespace http {
@@ -20,6 +21,31 @@ public:
     {
         for(int i = 1; i <= 999; ++i)
             BEAST_EXPECT(reason_string(i) != nullptr);
+
+        BEAST_EXPECT(detail::status_line(11, 200) ==
+            "HTTP/1.1 200 OK\r\n");
+        BEAST_EXPECT(detail::status_line(10, 404) ==
+            "HTTP/1.0 404 Not Found\r\n");
+        BEAST_EXPECT(detail::status_line(11, 99).empty());
+        BEAST_EXPECT(detail::status_line(11, 299).empty());
+        BEAST_EXPECT(detail::status_line(11, 600).empty());
+        BEAST_EXPECT(detail::status_line(20, 200).empty());
+
+        // Every known reason has a status line
+        for(int i = 100; i <= 599; ++i)
+        {
+            std::string const reason = reason_string(i);
+            if(reason[0] == '<')
+            {
+                BEAST_EXPECT(detail::status_line(11, i).empty());
+                continue;
+            }
+            auto const code = std::to_string(i);
+            BEAST_EXPECT(detail::status_line(10, i) ==
+                "HTTP/1.0 " + code + " " + reason + "\r\n");
+            BEAST_EXPECT(detail::status_line(11, i) ==
+                "HTTP/1.1 " + code + " " + reason + "\r\n");
+        }
     }
 };
 
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/spill_body.hpp>
+
+#include <beast/http/fields.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class spill_body_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::string
+    load(std::FILE* f)
+    {
+        std::string s;
+        char buf[4096];
+        for(;;)
+        {
+            auto const n = std::fread(buf, 1, sizeof(buf), f);
+            if(n == 0)
+                break;
+            s.append(buf, n);
+        }
+        return s;
+    }
+
+    // Parse a request with the given body in pieces of `step` bytes
+    spill_body::value_type
+    parse(std::string const& body,
+        std::size_t limit, std::size_t step)
+    {
+        using boost::asio::buffer;
+        parser_v1<true, spill_body, fields> p;
+        p.set_option(body_max_size{0});
+        p.get().body.limit(limit);
+        std::string const h =
+            "PUT / HTTP/1.1\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "\r\n";
+        error_code ec;
+        p.write(buffer(h), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        for(std::size_t i = 0; i < body.size(); i += step)
+        {
+            p.write(buffer(body.data() + i,
+                (std::min)(body.size() - i, step)), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+        }
+        BEAST_EXPECT(p.complete());
+        return std::move(p.get().body);
+    }
+
+    void
+    testReader()
+    {
+        std::string body;
+        for(std::size_t i = 0; i < 100000; ++i)
+            body.push_back(static_cast<char>(i * 3 + (i >> 10)));
+        {
+            auto const b = parse(body, body.size(), 1000);
+            BEAST_EXPECT(! b.spilled());
+            BEAST_EXPECT(b.size() == body.size());
+            BEAST_EXPECT(b.data() == body);
+        }
+        {
+            auto const b = parse(body, 10000, 3000);
+            BEAST_EXPECT(b.spilled());
+            BEAST_EXPECT(b.size() == body.size());
+            BEAST_EXPECT(b.data().empty());
+            BEAST_EXPECT(load(b.file()) == body);
+        }
+        {
+            // spill on the first write
+            auto const b = parse(body, 0, 50000);
+            BEAST_EXPECT(b.spilled());
+            BEAST_EXPECT(load(b.file()) == body);
+        }
+        {
+            auto const b = parse("", 0, 1);
+            BEAST_EXPECT(! b.spilled());
+            BEAST_EXPECT(b.size() == 0);
+        }
+    }
+
+    void
+    testValue()
+    {
+        spill_body::value_type v1{100};
+        BEAST_EXPECT(v1.limit() == 100);
+        v1.limit(200);
+        BEAST_EXPECT(v1.limit() == 200);
+        BEAST_EXPECT(! v1.spilled());
+        spill_body::value_type v2;
+        BEAST_EXPECT(v2.limit() == 1024 * 1024);
+        v2 = std::move(v1);
+        BEAST_EXPECT(v2.limit() == 200);
+    }
+
+    void
+    run() override
+    {
+        testReader();
+        testValue();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(spill_body,http,beast);
+
+} // http
+} // beast
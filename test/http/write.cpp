@@ -634,6 +634,26 @@ public:
                 "0\r\n\r\n"
             );
         }
+        // status lines
+        {
+            message<false, string_body, fields> m;
+            m.version = 11;
+            m.status = 404;
+            m.reason = "Not Found";
+            BEAST_EXPECT(str(m) ==
+                "HTTP/1.1 404 Not Found\r\n\r\n");
+            m.reason = "Nowhere";
+            BEAST_EXPECT(str(m) ==
+                "HTTP/1.1 404 Nowhere\r\n\r\n");
+            m.reason = "";
+            BEAST_EXPECT(str(m) ==
+                "HTTP/1.1 404 \r\n\r\n");
+            m.version = 10;
+            m.status = 299;
+            m.reason = "Unknown";
+            BEAST_EXPECT(str(m) ==
+                "HTTP/1.0 299 Unknown\r\n\r\n");
+        }
     }
 
     void test_std_ostream()
@@ -700,8 +720,30 @@ public:
         }
     }
 
+    void testStartLine()
+    {
+        auto const check =
+            [&](int version, int status,
+                std::string const& reason, std::string const& match)
+            {
+                header<false, fields> m;
+                m.version = version;
+                m.status = status;
+                m.reason = reason;
+                streambuf sb;
+                detail::write_start_line(sb, m);
+                BEAST_EXPECT(to_string(sb.data()) == match);
+            };
+        check(11, 200, "OK", "HTTP/1.1 200 OK\r\n");
+        check(10, 404, "Not Found", "HTTP/1.0 404 Not Found\r\n");
+        check(11, 404, "Nope", "HTTP/1.1 404 Nope\r\n");
+        check(11, 200, "", "HTTP/1.1 200 \r\n");
+        check(11, 299, "Custom", "HTTP/1.1 299 Custom\r\n");
+    }
+
     void run() override
     {
+        testStartLine();
         yield_to(std::bind(&write_test::testAsyncWriteHeaders,
             this, std::placeholders::_1));
         yield_to(std::bind(&write_test::testAsyncWrite,
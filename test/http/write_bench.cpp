@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/http/fields.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/reason.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/write_dynabuf.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+// Compare write_start_line, which copies a prebuilt
+// status line, with writing the line in pieces.
+//
+class write_bench_test : public beast::unit_test::suite
+{
+public:
+    // The start line as written without the status line table
+    template<class DynamicBuffer>
+    static
+    void
+    write_pieces(DynamicBuffer& dynabuf,
+        header<false, fields> const& m)
+    {
+        if(m.version == 10)
+            beast::write(dynabuf, "HTTP/1.0 ");
+        else
+            beast::write(dynabuf, "HTTP/1.1 ");
+        beast::write(dynabuf, m.status);
+        beast::write(dynabuf, " ");
+        beast::write(dynabuf, m.reason);
+        beast::write(dynabuf, "\r\n");
+    }
+
+    void
+    run() override
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        std::vector<header<false, fields>> v;
+        for(int status : {200, 204, 301, 404, 500})
+        {
+            header<false, fields> m;
+            m.version = 11;
+            m.status = status;
+            m.reason = reason_string(status);
+            v.push_back(m);
+        }
+        std::size_t const times = 200000;
+        streambuf sb;
+        std::size_t n0 = 0;
+        std::size_t n1 = 0;
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0; i < times; ++i)
+        {
+            detail::write_start_line(sb, v[i % v.size()]);
+            n0 += sb.size();
+            sb.consume(sb.size());
+        }
+        auto const t1 = clock_type::now();
+        for(std::size_t i = 0; i < times; ++i)
+        {
+            write_pieces(sb, v[i % v.size()]);
+            n1 += sb.size();
+            sb.consume(sb.size());
+        }
+        auto const t2 = clock_type::now();
+        BEAST_EXPECT(n0 == n1);
+        log <<
+            times << " start lines: " <<
+            "table " << duration_cast<
+                microseconds>(t1 - t0).count() << "us, " <<
+            "pieces " << duration_cast<
+                microseconds>(t2 - t1).count() << "us" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(write_bench,http,beast);
+
+} // http
+} // beast
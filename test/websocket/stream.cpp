@@ -150,12 +150,18 @@ public:
     {
         stream<socket_type> ws(ios_);
         ws.set_option(auto_fragment{true});
+        ws.set_option(auto_release{true});
         ws.set_option(decorate(identity{}));
         ws.set_option(keep_alive{false});
         ws.set_option(write_buffer_size{2048});
         ws.set_option(message_type{opcode::text});
         ws.set_option(read_buffer_size{8192});
+        ws.set_option(wait_readable{true});
         ws.set_option(read_message_max{1 * 1024 * 1024});
+        ws.set_option(read_size_policy{1024, 16384});
+        BEAST_EXPECT(ws.read_size().max_size() == 16384);
+        BEAST_EXPECT(ws.read_size().reads() == 0);
+        ws.release_buffers();
         try
         {
             ws.set_option(write_buffer_size{7});
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/zlib/buffer_pool.hpp>
+
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+
+#include "ztest.hpp"
+#include <beast/unit_test/suite.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace beast {
+namespace zlib {
+
+class buffer_pool_test : public beast::unit_test::suite
+{
+public:
+    struct connection
+    {
+        deflate_stream ds;
+        inflate_stream is;
+    };
+
+    void
+    testPool()
+    {
+        {
+            buffer_pool pool;
+            auto const p = pool.allocate(100);
+            BEAST_EXPECT(pool.used() == 100);
+            BEAST_EXPECT(pool.idle() == 0);
+            pool.deallocate(p, 100);
+            BEAST_EXPECT(pool.used() == 0);
+            BEAST_EXPECT(pool.idle() == 100);
+            BEAST_EXPECT(pool.allocate(100) == p);
+            BEAST_EXPECT(pool.idle() == 0);
+            auto const p2 = pool.allocate(200);
+            BEAST_EXPECT(p2 != p);
+            pool.deallocate(p, 100);
+            pool.deallocate(p2, 200);
+            BEAST_EXPECT(pool.idle() == 300);
+            pool.shrink_to_fit();
+            BEAST_EXPECT(pool.idle() == 0);
+        }
+        {
+            buffer_pool pool{150};
+            auto const p1 = pool.allocate(100);
+            auto const p2 = pool.allocate(100);
+            pool.deallocate(p1, 100);
+            pool.deallocate(p2, 100);
+            BEAST_EXPECT(pool.idle() == 100);
+            BEAST_EXPECT(pool.used() == 0);
+        }
+    }
+
+    void
+    testStreams()
+    {
+        auto const check = corpus1(10000);
+        buffer_pool pool;
+        std::string out;
+        {
+            deflate_stream ds;
+            ds.pool(&pool);
+            BEAST_EXPECT(pool.used() == 0);
+            out.resize(ds.upper_bound(check.size()));
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            error_code ec;
+            ds.write(zs, Flush::full, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            out.resize(zs.total_out);
+            BEAST_EXPECT(pool.used() > 0);
+        }
+        BEAST_EXPECT(pool.used() == 0);
+        BEAST_EXPECT(pool.idle() > 0);
+        {
+            std::string s(check.size(), 0);
+            inflate_stream is;
+            is.pool(&pool);
+            z_params zs;
+            zs.next_in = out.data();
+            zs.avail_in = out.size();
+            zs.next_out = &s[0];
+            zs.avail_out = s.size();
+            error_code ec;
+            is.write(zs, Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(s == check);
+            BEAST_EXPECT(pool.used() > 0);
+            is.clear();
+            BEAST_EXPECT(pool.used() == 0);
+        }
+    }
+
+    void
+    testMove()
+    {
+        static_assert(std::is_move_assignable<
+            inflate_stream>::value, "");
+        auto const check = corpus1(1000);
+        buffer_pool pool;
+        std::string out;
+        {
+            deflate_stream ds;
+            out.resize(ds.upper_bound(check.size()));
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            error_code ec;
+            ds.write(zs, Flush::full, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            out.resize(zs.total_out);
+        }
+        std::string s(check.size(), 0);
+        inflate_stream is;
+        is.pool(&pool);
+        z_params zs;
+        zs.next_in = out.data();
+        zs.avail_in = out.size();
+        zs.next_out = &s[0];
+        zs.avail_out = s.size();
+        error_code ec;
+        is.write(zs, Flush::sync, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(pool.used() > 0);
+        // The window is returned to the pool
+        is = inflate_stream{};
+        BEAST_EXPECT(pool.used() == 0);
+        BEAST_EXPECT(pool.idle() > 0);
+    }
+
+    // Measure the memory held by idle connections which each
+    // compress and decompress one message, then go idle. With
+    // a pool, an idle connection holds no window or state.
+    void
+    testIdleConnections()
+    {
+        std::size_t constexpr N = 10000;
+        std::string const check =
+            "{\"id\":42,\"name\":\"beast\",\"status\":\"active\"}";
+        buffer_pool pool;
+        std::unique_ptr<connection[]> v(new connection[N]);
+        std::string out;
+        std::string s;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            auto& c = v[i];
+            c.ds.pool(&pool);
+            c.is.pool(&pool);
+            error_code ec;
+            out.resize(c.ds.upper_bound(check.size()));
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            c.ds.write(zs, Flush::sync, ec);
+            out.resize(zs.total_out);
+            c.ds.clear();
+
+            s.resize(check.size());
+            zs.next_in = out.data();
+            zs.avail_in = out.size();
+            zs.next_out = &s[0];
+            zs.avail_out = s.size();
+            c.is.write(zs, Flush::sync, ec);
+            if(! BEAST_EXPECT(s == check))
+                break;
+            c.is.clear();
+        }
+        BEAST_EXPECT(pool.used() == 0);
+        auto const held = pool.idle();
+        auto const pooled =
+            (N * sizeof(connection) + held) / N;
+        log <<
+            N << " idle connections: " <<
+            pooled << " bytes each with pool\n";
+        log.flush();
+        BEAST_EXPECT(pooled < sizeof(connection) + 1024);
+    }
+
+    void
+    run() override
+    {
+        testPool();
+        testStreams();
+        testMove();
+        testIdleConnections();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(buffer_pool,zlib,beast);
+
+} // zlib
+} // beast
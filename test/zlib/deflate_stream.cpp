@@ -8,6 +8,8 @@
 // Test that header file is self-contained.
 #include <beast/zlib/deflate_stream.hpp>
 
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include "ztest.hpp"
 #include <beast/unit_test/suite.hpp>
 
@@ -319,6 +321,200 @@ public:
         }
     }
 
+    //--------------------------------------------------------------------------
+
+    std::string
+    compress(deflate_stream& ds, std::string const& in)
+    {
+        std::string out;
+        out.resize(ds.upper_bound(in.size()));
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        ds.write(zs, Flush::full, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    std::string
+    decompress(std::string const& in,
+        std::string const& dict, std::size_t size)
+    {
+        std::string out(size + 1, 0);
+        ::z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        inflateInit2(&zs, -15);
+        inflateSetDictionary(&zs,
+            (Bytef const*)dict.data(),
+            static_cast<uInt>(dict.size()));
+        zs.next_in = (Bytef*)in.data();
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = (Bytef*)&out[0];
+        zs.avail_out = static_cast<uInt>(out.size());
+        inflate(&zs, Z_SYNC_FLUSH);
+        out.resize(zs.total_out);
+        inflateEnd(&zs);
+        return out;
+    }
+
+    void
+    testDictionary()
+    {
+        std::string const dict =
+            "{\"id\":,\"name\":\"\",\"status\":\"active\","
+            "\"created\":\"2016-\",\"tags\":[],\"owner\":{\"id\":";
+        std::string const check =
+            "{\"id\":42,\"name\":\"beast\",\"status\":\"active\","
+            "\"created\":\"2016-10-18\",\"tags\":[],\"owner\":{\"id\":7}}";
+
+        deflate_dictionary const dd{dict.data(), dict.size(), 15, 8};
+        BEAST_EXPECT(dd.size() == dict.size());
+        BEAST_EXPECT(std::memcmp(
+            dd.data(), dict.data(), dict.size()) == 0);
+
+        for(int level = 0; level <= 9; ++level)
+        {
+            for(int strategy = 0; strategy <= 4; ++strategy)
+            {
+                error_code ec;
+                deflate_stream ds1;
+                ds1.reset(level, 15, 8, toStrategy(strategy));
+                ds1.dictionary(dict.data(), dict.size(), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                auto const out1 = compress(ds1, check);
+                BEAST_EXPECT(decompress(
+                    out1, dict, check.size()) == check);
+
+                // Precomputed dictionary gives identical output
+                deflate_stream ds2;
+                ds2.reset(level, 15, 8, toStrategy(strategy));
+                ds2.dictionary(dd, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                auto const out2 = compress(ds2, check);
+                BEAST_EXPECT(out1 == out2);
+
+                // Reuse after reset
+                ds2.reset();
+                ds2.dictionary(dd, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(compress(ds2, check) == out1);
+            }
+        }
+        {
+            // Dictionary improves compression of short messages
+            deflate_stream ds;
+            ds.reset(6, 15, 8, Strategy::normal);
+            auto const plain = compress(ds, check);
+            ds.reset();
+            error_code ec;
+            ds.dictionary(dd, ec);
+            BEAST_EXPECT(compress(ds, check).size() < plain.size());
+        }
+        {
+            // Dictionary larger than the window uses the tail
+            auto const big = corpus1(1000);
+            deflate_dictionary const dd9{big.data(), big.size(), 9, 8};
+            BEAST_EXPECT(dd9.size() == 512);
+            deflate_stream ds;
+            ds.reset(6, 9, 8, Strategy::normal);
+            error_code ec;
+            ds.dictionary(dd9, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            auto const s = big.substr(500, 300);
+            auto const out = compress(ds, s);
+            z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            std::string res(s.size() + 1, 0);
+            inflateInit2(&zs, -9);
+            inflateSetDictionary(&zs,
+                (Bytef const*)dd9.data(),
+                static_cast<uInt>(dd9.size()));
+            zs.next_in = (Bytef*)out.data();
+            zs.avail_in = static_cast<uInt>(out.size());
+            zs.next_out = (Bytef*)&res[0];
+            zs.avail_out = static_cast<uInt>(res.size());
+            inflate(&zs, Z_SYNC_FLUSH);
+            res.resize(zs.total_out);
+            inflateEnd(&zs);
+            BEAST_EXPECT(res == s);
+        }
+        {
+            // Mismatched settings
+            deflate_stream ds;
+            ds.reset(6, 15, 9, Strategy::normal);
+            error_code ec;
+            ds.dictionary(dd, ec);
+            BEAST_EXPECT(ec == error::stream_error);
+        }
+        {
+            // Stream already has data in the window
+            deflate_stream ds;
+            ds.reset(6, 15, 8, Strategy::normal);
+            std::string out(ds.upper_bound(check.size()), 0);
+            z_params zs;
+            zs.next_in = check.data();
+            zs.avail_in = check.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            error_code ec;
+            ds.write(zs, Flush::none, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            ds.dictionary(dd, ec);
+            BEAST_EXPECT(ec == error::stream_error);
+        }
+    }
+
+    void
+    testDynabuf()
+    {
+        auto const check = corpus1(50000);
+        std::vector<boost::asio::const_buffer> v;
+        for(std::size_t i = 0, n = 1; i < check.size();
+                i += n, n = n * 3 % 997 + 1)
+            v.emplace_back(&check[i],
+                (std::min)(n, check.size() - i));
+        for(auto flush : {Flush::sync, Flush::full, Flush::finish})
+        {
+            deflate_stream ds;
+            streambuf sb{64};
+            error_code ec;
+            auto const used = ds.write(v, sb, flush, ec);
+            if(flush == Flush::finish)
+                BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+            else
+                BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(used == check.size());
+            BEAST_EXPECT(z_inflator{}(to_string(sb.data())) == check);
+        }
+        {
+            // Output held back by Flush::none appears later
+            deflate_stream ds;
+            streambuf sb;
+            error_code ec;
+            auto const half = check.size() / 2;
+            ds.write(boost::asio::buffer(check.data(), half),
+                sb, Flush::none, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            ds.write(boost::asio::buffer(check.data() + half,
+                check.size() - half), sb, Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(z_inflator{}(to_string(sb.data())) == check);
+        }
+        {
+            // Empty input
+            deflate_stream ds;
+            streambuf sb;
+            error_code ec;
+            ds.write(boost::asio::null_buffers{}, sb, Flush::none, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(sb.size() == 0);
+        }
+    }
+
     void
     run() override
     {
@@ -327,6 +523,8 @@ public:
             sizeof(deflate_stream) << std::endl;
 
         testDeflate();
+        testDictionary();
+        testDynabuf();
     }
 };
 
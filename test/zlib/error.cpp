@@ -51,6 +51,9 @@ public:
         check("zlib", error::over_subscribed_length);
         check("zlib", error::incomplete_length_set);
 
+        check("zlib", error::invalid_header);
+        check("zlib", error::incorrect_check);
+
         check("zlib", error::general);
     }
 };
@@ -8,6 +8,11 @@
 // Test that header file is self-contained.
 #include <beast/zlib/inflate_stream.hpp>
 
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/zlib/deflate_stream.hpp>
+
 #include "ztest.hpp"
 #include <beast/unit_test/suite.hpp>
 #include <chrono>
@@ -396,6 +401,88 @@ public:
 #endif
     }
 
+    void
+    testDictionary()
+    {
+        std::string const dict =
+            "{\"id\":,\"name\":\"\",\"status\":\"active\",\"tags\":[]}";
+        std::string const check =
+            "{\"id\":42,\"name\":\"beast\",\"status\":\"active\",\"tags\":[]}";
+        for(int window = 9; window <= 15; ++window)
+        {
+            ::z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            deflateInit2(&zs, 6, Z_DEFLATED, -window, 8, Z_DEFAULT_STRATEGY);
+            deflateSetDictionary(&zs,
+                (Bytef const*)dict.data(),
+                static_cast<uInt>(dict.size()));
+            std::string in;
+            in.resize(deflateBound(&zs,
+                static_cast<uLong>(check.size())));
+            zs.next_in = (Bytef*)check.data();
+            zs.avail_in = static_cast<uInt>(check.size());
+            zs.next_out = (Bytef*)&in[0];
+            zs.avail_out = static_cast<uInt>(in.size());
+            deflate(&zs, Z_FULL_FLUSH);
+            in.resize(zs.total_out);
+            deflateEnd(&zs);
+
+            std::string out(check.size() + 1, 0);
+            z_params zp;
+            zp.next_in = in.data();
+            zp.avail_in = in.size();
+            zp.next_out = &out[0];
+            zp.avail_out = out.size();
+            inflate_stream is;
+            is.reset(window);
+            is.dictionary(dict.data(), dict.size());
+            error_code ec;
+            is.write(zp, Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            out.resize(zp.total_out);
+            BEAST_EXPECT(out == check);
+        }
+    }
+
+    void
+    testDynabuf()
+    {
+        auto const check = corpus1(50000);
+        auto const in = z_deflator{}(check);
+        std::vector<boost::asio::const_buffer> v;
+        for(std::size_t i = 0, n = 1; i < in.size();
+                i += n, n = n * 3 % 997 + 1)
+            v.emplace_back(&in[i],
+                (std::min)(n, in.size() - i));
+        {
+            inflate_stream is;
+            streambuf sb{64};
+            error_code ec;
+            auto const used = is.write(v, sb, Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(used == in.size());
+            BEAST_EXPECT(to_string(sb.data()) == check);
+        }
+        {
+            // Input after the end of the stream is not consumed
+            deflate_stream ds;
+            streambuf sb1;
+            error_code ec;
+            ds.write(boost::asio::buffer(check),
+                sb1, Flush::finish, ec);
+            BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+            auto const size = sb1.size();
+            auto const tail = std::string{"tail"};
+            inflate_stream is;
+            streambuf sb2;
+            auto const used = is.write(buffer_cat(sb1.data(),
+                boost::asio::buffer(tail)), sb2, Flush::sync, ec);
+            BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+            BEAST_EXPECT(used == size);
+            BEAST_EXPECT(to_string(sb2.data()) == check);
+        }
+    }
+
     void
     run() override
     {
@@ -403,6 +490,8 @@ public:
             "sizeof(inflate_stream) == " <<
             sizeof(inflate_stream) << std::endl;
         testInflate();
+        testDictionary();
+        testDynabuf();
     }
 };
 
@@ -0,0 +1,348 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <beast/zlib/deflate_stream.hpp>
+#include <beast/zlib/inflate_stream.hpp>
+
+#include "ztest.hpp"
+#include <beast/unit_test/suite.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace zlib {
+
+// Compare the speed and ratio of the port against the
+// reference implementation, over corpora with different
+// statistics, for every level and strategy.
+//
+class zlib_bench_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::high_resolution_clock;
+
+    static std::size_t constexpr Size = 256 * 1024;
+    static std::size_t constexpr Trials = 3;
+
+    struct corpus
+    {
+        char const* name;
+        std::string data;
+    };
+
+    // English-like text
+    static
+    std::string
+    makeText(std::size_t n)
+    {
+        static char const* const words[] = {
+            "the", "of", "and", "to", "in", "a", "is", "that", "for",
+            "it", "as", "was", "with", "be", "by", "on", "not", "he",
+            "this", "are", "or", "his", "from", "at", "which", "but",
+            "have", "an", "had", "they", "you", "were", "their", "one",
+            "all", "we", "can", "her", "has", "there", "been", "if",
+            "more", "when", "will", "would", "who", "so", "no", "buffer",
+            "stream", "message", "header", "compression", "window" };
+        std::mt19937 g;
+        std::uniform_int_distribution<std::size_t> dw{
+            0, sizeof(words)/sizeof(words[0]) - 1};
+        std::uniform_int_distribution<int> dp{0, 15};
+        std::string s;
+        s.reserve(n + 16);
+        while(s.size() < n)
+        {
+            s += words[dw(g)];
+            auto const p = dp(g);
+            s += p == 0 ? ".\n" : p == 1 ? ", " : " ";
+        }
+        s.resize(n);
+        return s;
+    }
+
+    // API style JSON records
+    static
+    std::string
+    makeJson(std::size_t n)
+    {
+        static char const* const names[] = {
+            "alpha", "bravo", "charlie", "delta", "echo", "foxtrot" };
+        std::mt19937 g;
+        std::uniform_int_distribution<int> dn{0, 5};
+        std::uniform_int_distribution<int> dv{0, 99999};
+        std::string s = "[";
+        s.reserve(n + 128);
+        for(int id = 1; s.size() < n; ++id)
+        {
+            s += "{\"id\":" + std::to_string(id) +
+                ",\"name\":\"" + names[dn(g)] +
+                "\",\"value\":" + std::to_string(dv(g)) +
+                ",\"active\":" + (dv(g) & 1 ? "true" : "false") +
+                ",\"tags\":[\"" + names[dn(g)] + "\",\"" +
+                names[dn(g)] + "\"]},\n";
+        }
+        s.resize(n);
+        return s;
+    }
+
+    // Fixed size records of slowly varying integers
+    static
+    std::string
+    makeBinary(std::size_t n)
+    {
+        std::mt19937 g;
+        std::uniform_int_distribution<int> dd{-8, 8};
+        std::string s;
+        s.reserve(n + 16);
+        std::uint32_t t = 1000000;
+        std::int32_t v = 0;
+        while(s.size() < n)
+        {
+            t += 10 + dd(g);
+            v += dd(g);
+            for(int i = 0; i < 4; ++i)
+                s.push_back(static_cast<char>(t >> (8 * i)));
+            for(int i = 0; i < 4; ++i)
+                s.push_back(static_cast<char>(v >> (8 * i)));
+            s.push_back(static_cast<char>(dd(g) & 3));
+            s.append(3, '\0');
+        }
+        s.resize(n);
+        return s;
+    }
+
+    // One line repeated with a counter
+    static
+    std::string
+    makeRepeat(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n + 64);
+        for(int i = 0; s.size() < n; ++i)
+            s += "GET /index.html HTTP/1.1 200 " +
+                std::to_string(i % 10) + "\n";
+        s.resize(n);
+        return s;
+    }
+
+    static
+    char const*
+    toString(Strategy strategy)
+    {
+        switch(strategy)
+        {
+        default:
+        case Strategy::normal:   return "normal";
+        case Strategy::filtered: return "filtered";
+        case Strategy::huffman:  return "huffman";
+        case Strategy::rle:      return "rle";
+        case Strategy::fixed:    return "fixed";
+        }
+    }
+
+    static
+    int
+    toZlib(Strategy strategy)
+    {
+        switch(strategy)
+        {
+        default:
+        case Strategy::normal:   return Z_DEFAULT_STRATEGY;
+        case Strategy::filtered: return Z_FILTERED;
+        case Strategy::huffman:  return Z_HUFFMAN_ONLY;
+        case Strategy::rle:      return Z_RLE;
+        case Strategy::fixed:    return Z_FIXED;
+        }
+    }
+
+    // Returns the best time in seconds
+    template<class Function>
+    static
+    double
+    timed(Function&& f)
+    {
+        using namespace std::chrono;
+        double best = 0;
+        for(std::size_t i = 0; i < Trials; ++i)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = duration_cast<
+                duration<double>>(clock_type::now() - t0).count();
+            if(i == 0 || elapsed < best)
+                best = elapsed;
+        }
+        return best;
+    }
+
+    static
+    std::string
+    deflateBeast(std::string const& in,
+        int level, Strategy strategy)
+    {
+        deflate_stream ds;
+        ds.reset(level, 15, 8, strategy);
+        std::string out;
+        out.resize(ds.upper_bound(in.size()));
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        ds.write(zs, Flush::finish, ec);
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    static
+    std::string
+    deflateZlib(std::string const& in,
+        int level, Strategy strategy)
+    {
+        ::z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        deflateInit2(&zs, level, Z_DEFLATED,
+            -15, 8, toZlib(strategy));
+        std::string out;
+        out.resize(deflateBound(&zs,
+            static_cast<uLong>(in.size())));
+        zs.next_in = (Bytef*)in.data();
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = (Bytef*)&out[0];
+        zs.avail_out = static_cast<uInt>(out.size());
+        deflate(&zs, Z_FINISH);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return out;
+    }
+
+    static
+    std::string
+    inflateBeast(std::string const& in, std::size_t size)
+    {
+        inflate_stream is;
+        std::string out(size, 0);
+        z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        is.write(zs, Flush::sync, ec);
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    static
+    std::string
+    inflateZlib(std::string const& in, std::size_t size)
+    {
+        ::z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        inflateInit2(&zs, -15);
+        std::string out(size, 0);
+        zs.next_in = (Bytef*)in.data();
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = (Bytef*)&out[0];
+        zs.avail_out = static_cast<uInt>(out.size());
+        inflate(&zs, Z_SYNC_FLUSH);
+        out.resize(zs.total_out);
+        inflateEnd(&zs);
+        return out;
+    }
+
+    static
+    double
+    mbps(std::size_t size, double seconds)
+    {
+        return seconds > 0 ? size / seconds / 1e6 : 0;
+    }
+
+    void
+    row(char const* corpus, int level,
+        char const* strategy, double v[6])
+    {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf),
+            "%-7s %2d %-9s %8.1f %8.1f %6.2f%% %6.2f%% %8.1f %8.1f",
+            corpus, level, strategy,
+            v[0], v[1], v[2], v[3], v[4], v[5]);
+        log << buf << std::endl;
+    }
+
+    void
+    doBench(corpus const& c, int level, Strategy strategy)
+    {
+        std::string out1;
+        std::string out2;
+        std::string res1;
+        std::string res2;
+        auto const& in = c.data;
+        double v[6];
+        v[0] = mbps(in.size(), timed(
+            [&]{ out1 = deflateBeast(in, level, strategy); }));
+        v[1] = mbps(in.size(), timed(
+            [&]{ out2 = deflateZlib(in, level, strategy); }));
+        v[2] = 100.0 * out1.size() / in.size();
+        v[3] = 100.0 * out2.size() / in.size();
+        v[4] = mbps(in.size(), timed(
+            [&]{ res1 = inflateBeast(out2, in.size()); }));
+        v[5] = mbps(in.size(), timed(
+            [&]{ res2 = inflateZlib(out2, in.size()); }));
+        BEAST_EXPECT(res1 == in);
+        BEAST_EXPECT(res2 == in);
+        BEAST_EXPECT(inflateZlib(out1, in.size()) == in);
+        row(c.name, level, toString(strategy), v);
+    }
+
+    void
+    testBench()
+    {
+        std::vector<corpus> const v = {
+            { "text",   makeText(Size) },
+            { "json",   makeJson(Size) },
+            { "binary", makeBinary(Size) },
+            { "random", corpus2(Size) },
+            { "repeat", makeRepeat(Size) }
+        };
+        Strategy const strategies[] = {
+            Strategy::normal, Strategy::filtered,
+            Strategy::huffman, Strategy::rle, Strategy::fixed };
+
+        char buf[160];
+        std::snprintf(buf, sizeof(buf),
+            "%-7s %2s %-9s %8s %8s %7s %7s %8s %8s",
+            "corpus", "lv", "strategy", "deflate", "zlib",
+            "ratio", "zlib", "inflate", "zlib");
+        log <<
+            Size / 1024 << "KB per corpus, best of " <<
+            Trials << " trials, speeds in MB/s of input\n" <<
+            buf << std::endl;
+        for(auto const& c : v)
+        {
+            testcase << c.name;
+            for(auto strategy : strategies)
+                for(int level = 0; level <= 9; ++level)
+                    doBench(c, level, strategy);
+        }
+    }
+
+    void
+    run() override
+    {
+        testBench();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(zlib_bench,zlib,beast);
+
+} // zlib
+} // beast